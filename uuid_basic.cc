@@ -9,7 +9,7 @@ namespace andyccs {
 namespace {
 
 struct LookupTable1 {
-  uint8_t c[71];
+  uint8_t c[103];
 
   constexpr LookupTable1() : c{} {
     c['0'] = 0 << 4;
@@ -28,12 +28,20 @@ struct LookupTable1 {
     c['D'] = 0xD << 4;
     c['E'] = 0xE << 4;
     c['F'] = 0xF << 4;
+    c['a'] = 0xA << 4;
+    c['b'] = 0xB << 4;
+    c['c'] = 0xC << 4;
+    c['d'] = 0xD << 4;
+    c['e'] = 0xE << 4;
+    c['f'] = 0xF << 4;
+  }
+  constexpr uint8_t operator[](char ch) const {
+    return c[static_cast<unsigned char>(ch)];
   }
-  constexpr uint8_t operator[](char ch) const { return c[ch]; }
 };
 
 struct LookupTable2 {
-  uint8_t c[71];
+  uint8_t c[103];
 
   constexpr LookupTable2() : c{} {
     c['0'] = 0;
@@ -52,8 +60,16 @@ struct LookupTable2 {
     c['D'] = 0xD;
     c['E'] = 0xE;
     c['F'] = 0xF;
+    c['a'] = 0xA;
+    c['b'] = 0xB;
+    c['c'] = 0xC;
+    c['d'] = 0xD;
+    c['e'] = 0xE;
+    c['f'] = 0xF;
+  }
+  constexpr uint8_t operator[](char ch) const {
+    return c[static_cast<unsigned char>(ch)];
   }
-  constexpr uint8_t operator[](char ch) const { return c[ch]; }
 };
 
 constexpr LookupTable1 kLookupTable1;
@@ -64,7 +80,8 @@ inline uint8_t HexToVal(const char &c1, const char &c2) {
 }
 
 inline bool IsValid(const char &c) {
-  return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'F');
+  return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') ||
+         (c >= 'a' && c <= 'f');
 }
 
 inline void uint64_to_bytes(uint64_t value, uint8_t *array) {
@@ -76,7 +93,7 @@ inline void uint64_to_bytes(uint64_t value, uint8_t *array) {
 inline bool ConvertStringRangeToBytes(std::string_view from, size_t start,
                                       size_t end, size_t data_start_index,
                                       uint8_t *data) {
-  for (int i = start; i < end; i += 2) {
+  for (size_t i = start; i < end; i += 2) {
     const char &c1 = from[i];
     const char &c2 = from[i + 1];
     if (!IsValid(c1) || !IsValid(c2)) {
@@ -120,6 +137,12 @@ void BasicUuid::ToString(std::string &result) const {
   ToCharsInternal(data_, result.data());
 }
 
+UuidString BasicUuid::ToString() const {
+  UuidString result(36);
+  ToCharsInternal(data_, result.data_);
+  return result;
+}
+
 void BasicUuid::ToChars(char (&buffer)[37]) const {
   ToCharsInternal(data_, buffer);
   buffer[36] = '\0';
@@ -152,10 +175,32 @@ std::optional<BasicUuid> BasicUuid::FromString(std::string_view from) {
   return BasicUuid(data);
 }
 
-size_t BasicUuid::hash() const {
-  std::string result;
-  ToString(result);
-  return std::hash<std::string>()(std::move(result));
+void BasicUuid::ToBase64Url(char (&buffer)[kBase64UrlSize + 1]) const {
+  internal::EncodeBase64Url(data_.data(), buffer);
+  buffer[kBase64UrlSize] = '\0';
+}
+
+void BasicUuid::ToBase32(char (&buffer)[kBase32Size + 1]) const {
+  internal::EncodeBase32(data_.data(), buffer);
+  buffer[kBase32Size] = '\0';
+}
+
+std::optional<BasicUuid> BasicUuid::FromBase64Url(std::string_view from) {
+  std::array<uint8_t, 16> data;
+  if (from.size() != kBase64UrlSize ||
+      !internal::DecodeBase64Url(from.data(), data.data())) {
+    return std::nullopt;
+  }
+  return BasicUuid(data);
+}
+
+std::optional<BasicUuid> BasicUuid::FromBase32(std::string_view from) {
+  std::array<uint8_t, 16> data;
+  if (from.size() != kBase32Size ||
+      !internal::DecodeBase32(from.data(), data.data())) {
+    return std::nullopt;
+  }
+  return BasicUuid(data);
 }
 
 } // namespace andyccs
@@ -2,11 +2,19 @@
 #define ANDYCCS_UUID_BASIC_H
 
 #include <array>
+#include <compare>
 #include <cstdint>
 #include <cstdlib>
 #include <optional>
 #include <random>
+#include <span>
 #include <string>
+#include <type_traits>
+
+#include "uuid_encoding.h"
+#include "uuid_format.h"
+#include "uuid_hash.h"
+#include "uuid_random.h"
 
 namespace andyccs {
 
@@ -26,7 +34,7 @@ namespace andyccs {
 // Note: BasicUuid is a simplified version of UUID V4 and does not comply with
 // RFC 9562. It does not set the version and variant fields as specified in
 // these RFCs.
-class BasicUuid {
+class alignas(16) BasicUuid {
 public:
   // Default constructor for BasicUuid
   BasicUuid() = default;
@@ -50,24 +58,13 @@ public:
   // Same as above, but with std::array instead of C-style array
   constexpr BasicUuid(std::array<std::uint8_t, 16> data) : data_(data) {}
 
-  // Copy constructor and assignment operator
+  // Copy and move constructors and assignment operators. BasicUuid is trivially
+  // copyable: containers copy and relocate it with memcpy, and a moved-from
+  // BasicUuid keeps its value.
   BasicUuid(const BasicUuid &other) = default;
   BasicUuid &operator=(const BasicUuid &other) = default;
-
-  // Move constructor and assignment operator
-  BasicUuid(BasicUuid &&other) {
-    if (this != &other) {
-      data_ = std::move(other.data_);
-      other.data_ = {0};
-    }
-  }
-  BasicUuid &operator=(BasicUuid &&other) {
-    if (this != &other) {
-      data_ = std::move(other.data_);
-      other.data_ = {0};
-    }
-    return *this;
-  }
+  BasicUuid(BasicUuid &&other) = default;
+  BasicUuid &operator=(BasicUuid &&other) = default;
 
   // Convert BasicUuid to UUID V4 string.
   // This function is marked explicit to prevent accidental conversion to
@@ -82,29 +79,122 @@ public:
   // buffer.
   void ToChars(char (&buffer)[37]) const;
 
+  // Convert BasicUuid to UUID V4 string returned by value, without allocating,
+  // see UuidString. Prefer it to operator std::string.
+  UuidString ToString() const;
+
+  // Same as ToString and ToChars above, in the given format, e.g.
+  // uuid.ToString<kUuidLowercase>(result). See UuidFormat.
+  template <UuidFormat Format> void ToString(std::string &result) const {
+    result.resize(Format.size());
+    internal::FormatUuid<Format>(data_.data(), result.data());
+  }
+  template <UuidFormat Format> UuidString ToString() const {
+    UuidString result(Format.size());
+    internal::FormatUuid<Format>(data_.data(), result.data_);
+    return result;
+  }
+  template <UuidFormat Format>
+  void ToChars(char (&buffer)[Format.size() + 1]) const {
+    internal::FormatUuid<Format>(data_.data(), buffer);
+    buffer[Format.size()] = '\0';
+  }
+
   // Create BasicUuid from a UUID V4 string.
-  // The UUID V4 string must be in uppercase.
+  // Hex digits may be in uppercase, lowercase or mixed case.
   static std::optional<BasicUuid> FromString(std::string_view from);
 
+  // Convert BasicUuid to its 22-character base64url encoding, or to its
+  // 26-character Crockford base32 encoding, see uuid_encoding.h.
+  void ToBase64Url(char (&buffer)[kBase64UrlSize + 1]) const;
+  void ToBase32(char (&buffer)[kBase32Size + 1]) const;
+
+  // Create BasicUuid from its base64url or base32 encoding.
+  static std::optional<BasicUuid> FromBase64Url(std::string_view from);
+  static std::optional<BasicUuid> FromBase32(std::string_view from);
+
+  // Create BasicUuid from a string constant at compile time, e.g.
+  //
+  //   constexpr BasicUuid kTenant =
+  //       BasicUuid::ParseConstant("6bbbb416-edc3-405f-a86d-231d5800235e");
+  //
+  // Takes the same forms as SimdUuid::Parse. Malformed strings do not compile.
+  // See also the _basic_uuid literal below.
+  static consteval BasicUuid ParseConstant(std::string_view from) {
+    const std::optional<std::array<std::uint8_t, 16>> data =
+        internal::ParseUuidConstexpr(from);
+    if (!data.has_value()) {
+      throw "Malformed UUID constant";
+    }
+    return BasicUuid(*data);
+  }
+
   // Equality operators
-  bool operator==(const BasicUuid &other) const { return data_ == other.data_; }
+  constexpr bool operator==(const BasicUuid &other) const {
+    return data_ == other.data_;
+  }
 
-  bool operator!=(const BasicUuid &other) const { return !(*this == other); }
+  constexpr bool operator!=(const BasicUuid &other) const {
+    return !(*this == other);
+  }
+
+  // Orders UUIDs as 128-bit big-endian numbers, i.e. as their strings.
+  constexpr std::strong_ordering operator<=>(const BasicUuid &other) const {
+    if (const std::strong_ordering order = high() <=> other.high();
+        order != 0) {
+      return order;
+    }
+    return low() <=> other.low();
+  }
 
-  // Compute hash value for BasicUuid
-  size_t hash() const;
+  // Returns the 64 most and least significant bits of the UUID, i.e. `high`
+  // and `low` in BasicUuid(high, low).
+  constexpr std::uint64_t high() const { return LoadBigEndian(0); }
+  constexpr std::uint64_t low() const { return LoadBigEndian(8); }
+
+  // Compute hash value for BasicUuid. The hash is computed from the 128-bit value
+  // directly, see HashUuid.
+  size_t hash() const { return HashUuid(data_); }
+
+  // Same as above, but seeded, see SeededUuidHash.
+  size_t hash(std::uint64_t seed) const { return HashUuid(data_, seed); }
 
 private:
+  // Compilers turn this loop into a single load and byte swap.
+  constexpr std::uint64_t LoadBigEndian(std::size_t offset) const {
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < 8; ++i) {
+      value = (value << 8) | data_[offset + i];
+    }
+    return value;
+  }
+
   std::array<std::uint8_t, 16> data_ = {0};
 };
 
+// Same layout as SimdUuid: 16 bytes, aligned to 16.
+static_assert(std::is_trivially_copyable_v<BasicUuid>);
+static_assert(sizeof(BasicUuid) == 16 && alignof(BasicUuid) == 16);
+
+namespace literals {
+
+// BasicUuid constant, e.g.
+// "6bbbb416-edc3-405f-a86d-231d5800235e"_basic_uuid, see
+// BasicUuid::ParseConstant. Named apart from the SimdUuid _uuid literal, so
+// that both can be used together. Use with
+//
+//   using namespace andyccs::literals;
+consteval BasicUuid operator""_basic_uuid(const char *from, std::size_t size) {
+  return BasicUuid::ParseConstant(std::string_view(from, size));
+}
+
+} // namespace literals
+
 template <typename RNG> class BasicUuidGenerator {
 public:
   // Constructor initializes the random number generator and distribution
   BasicUuidGenerator()
-      : generator_(RNG(std::random_device()())),
-        distribution_(std::numeric_limits<uint64_t>::min(),
-                      std::numeric_limits<uint64_t>::max()) {}
+      : generator_(internal::SeedRandomEngine<RNG>()) {}
 
   // Copy constructor and assignment operator
   BasicUuidGenerator(const BasicUuidGenerator &other) = default;
@@ -122,9 +212,16 @@ public:
     return BasicUuid(data);
   }
 
+  // Fill `uuids` with new BasicUuids. Faster than calling GenerateUuid for
+  // each of them when there are more than a few dozen, see
+  // Xoshiro256StarStarX8. Note: This function is not thread-safe.
+  void GenerateUuids(std::span<BasicUuid> uuids) {
+    internal::GenerateUuids(uuids, generator_, distribution_);
+  }
+
 private:
   RNG generator_;
-  std::uniform_int_distribution<uint64_t> distribution_;
+  [[no_unique_address]] internal::Uniform64<RNG> distribution_;
 };
 
 } // namespace andyccs
@@ -7,11 +7,13 @@
 
 namespace andyccs {
 
-static void BM_BasicUuidFromString(benchmark::State &state) {
+static void BM_BasicUuidFromString(benchmark::State &state,
+                                   LetterCase letter_case) {
   std::uint8_t data[16];
   GenerateRandomData(data);
   BasicUuid uuid(data);
   std::string from = std::string(uuid);
+  SetLetterCase(from, letter_case);
   for (auto _ : state) {
     for (int i = 0; i < state.range(0); ++i) {
       benchmark::DoNotOptimize(BasicUuid::FromString(from));
@@ -19,7 +21,12 @@ static void BM_BasicUuidFromString(benchmark::State &state) {
     }
   }
 }
-BENCHMARK(BM_BasicUuidFromString)->Range(1 << 8, 1 << 8);
+BENCHMARK_CAPTURE(BM_BasicUuidFromString, upper, LetterCase::kUpper)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_CAPTURE(BM_BasicUuidFromString, lower, LetterCase::kLower)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_CAPTURE(BM_BasicUuidFromString, mixed, LetterCase::kMixed)
+    ->Range(1 << 8, 1 << 8);
 
 static void BM_BasicUuidFromArrayData(benchmark::State &state) {
   std::uint8_t data[16];
@@ -60,6 +67,19 @@ static void BM_BasicUuidToString(benchmark::State &state) {
 }
 BENCHMARK(BM_BasicUuidToString)->Range(1 << 8, 1 << 8);
 
+static void BM_BasicUuidToUuidString(benchmark::State &state) {
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  BasicUuid uuid(data);
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(uuid.ToString());
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK(BM_BasicUuidToUuidString)->Range(1 << 8, 1 << 8);
+
 static void BM_BasicUuidToStringPrealloc(benchmark::State &state) {
   std::uint8_t data[16];
   GenerateRandomData(data);
@@ -92,6 +112,94 @@ static void BM_BasicUuidToChars(benchmark::State &state) {
 }
 BENCHMARK(BM_BasicUuidToChars)->Range(1 << 8, 1 << 8);
 
+template <UuidFormat Format>
+static void BM_BasicUuidToCharsFormat(benchmark::State &state) {
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  BasicUuid uuid(data);
+
+  char result[Format.size() + 1];
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      uuid.ToChars<Format>(result);
+      benchmark::DoNotOptimize(result);
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK_TEMPLATE(BM_BasicUuidToCharsFormat, kUuidUppercase)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_TEMPLATE(BM_BasicUuidToCharsFormat, kUuidLowercase)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_TEMPLATE(BM_BasicUuidToCharsFormat, kUuidCompact)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_TEMPLATE(BM_BasicUuidToCharsFormat, kUuidBraced)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_TEMPLATE(BM_BasicUuidToCharsFormat, kUuidUrn)
+    ->Range(1 << 8, 1 << 8);
+
+static void BM_BasicUuidToBase64Url(benchmark::State &state) {
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  BasicUuid uuid(data);
+
+  char result[kBase64UrlSize + 1];
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      uuid.ToBase64Url(result);
+      benchmark::DoNotOptimize(result);
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK(BM_BasicUuidToBase64Url)->Range(1 << 8, 1 << 8);
+
+static void BM_BasicUuidToBase32(benchmark::State &state) {
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  BasicUuid uuid(data);
+
+  char result[kBase32Size + 1];
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      uuid.ToBase32(result);
+      benchmark::DoNotOptimize(result);
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK(BM_BasicUuidToBase32)->Range(1 << 8, 1 << 8);
+
+static void BM_BasicUuidFromBase64Url(benchmark::State &state) {
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  char from[kBase64UrlSize + 1];
+  BasicUuid(data).ToBase64Url(from);
+
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(BasicUuid::FromBase64Url(from));
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK(BM_BasicUuidFromBase64Url)->Range(1 << 8, 1 << 8);
+
+static void BM_BasicUuidFromBase32(benchmark::State &state) {
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  char from[kBase32Size + 1];
+  BasicUuid(data).ToBase32(from);
+
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(BasicUuid::FromBase32(from));
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK(BM_BasicUuidFromBase32)->Range(1 << 8, 1 << 8);
+
 static void BM_BasicUuidGeneratorMt19937(benchmark::State &state) {
   BasicUuidGenerator<std::mt19937> generator;
   for (auto _ : state) {
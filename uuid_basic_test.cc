@@ -1,7 +1,13 @@
 #include "uuid_basic.h"
 
+#include <cstdint>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <random>
+#include <sstream>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
 
 namespace andyccs {
 
@@ -47,16 +53,29 @@ TEST(BasicUuid, Move) {
                            0xA8, 0x6D, 0x23, 0x1D, 0x58, 0x0,  0x23, 0x5E};
   BasicUuid uuid_1(data);
   BasicUuid uuid_2(std::move(uuid_1));
-  EXPECT_EQ(uuid_1, BasicUuid());
   EXPECT_EQ(uuid_2, BasicUuid(data));
 
   BasicUuid uuid_3(data);
-  BasicUuid uuid_4(data);
+  BasicUuid uuid_4;
   uuid_4 = std::move(uuid_3);
-  EXPECT_EQ(uuid_3, BasicUuid());
   EXPECT_EQ(uuid_4, BasicUuid(data));
 }
 
+TEST(BasicUuid, TriviallyCopyable) {
+  static_assert(std::is_trivially_copyable_v<BasicUuid>);
+  static_assert(std::is_nothrow_move_constructible_v<BasicUuid>);
+  static_assert(alignof(BasicUuid) == 16);
+
+  std::vector<BasicUuid> uuids(3, BasicUuid(1, 2));
+  for (const BasicUuid &uuid : uuids) {
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&uuid) % 16, 0u);
+  }
+  // Moving copies the value, as for integers.
+  BasicUuid uuid_1(1, 2);
+  BasicUuid uuid_2(std::move(uuid_1));
+  EXPECT_EQ(uuid_1, uuid_2);
+}
+
 TEST(BasicUuid, StringOperator) {
   std::uint8_t data[16] = {0x6B, 0xBB, 0xB4, 0x16, 0xED, 0xC3, 0x40, 0x5F,
                            0xA8, 0x6D, 0x23, 0x1D, 0x58, 0x0,  0x23, 0x5E};
@@ -74,6 +93,68 @@ TEST(BasicUuid, ToString) {
   EXPECT_EQ(result, "6BBBB416-EDC3-405F-A86D-231D5800235E");
 }
 
+TEST(BasicUuid, ToUuidString) {
+  BasicUuid uuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E);
+  const UuidString result = uuid.ToString();
+  EXPECT_EQ(result, "6BBBB416-EDC3-405F-A86D-231D5800235E");
+  EXPECT_EQ(result.size(), 36u);
+  EXPECT_EQ(std::strlen(result.c_str()), 36u);
+  EXPECT_EQ(std::string(result), std::string(uuid));
+
+  EXPECT_EQ(uuid.ToString<kUuidLowercase>(),
+            "6bbbb416-edc3-405f-a86d-231d5800235e");
+  EXPECT_EQ(uuid.ToString<kUuidCompact>(), "6BBBB416EDC3405FA86D231D5800235E");
+  EXPECT_EQ(uuid.ToString<kUuidBraced>(),
+            "{6BBBB416-EDC3-405F-A86D-231D5800235E}");
+  const UuidString urn = uuid.ToString<kUuidUrn>();
+  EXPECT_EQ(std::string_view(urn),
+            "urn:uuid:6bbbb416-edc3-405f-a86d-231d5800235e");
+  EXPECT_EQ(urn.size(), UuidString::kCapacity);
+  EXPECT_EQ(urn.c_str()[urn.size()], '\0');
+
+  EXPECT_TRUE(UuidString().empty());
+  EXPECT_EQ(UuidString(), "");
+
+  std::ostringstream out;
+  out << uuid.ToString() << ' ' << urn;
+  EXPECT_EQ(out.str(), "6BBBB416-EDC3-405F-A86D-231D5800235E "
+                       "urn:uuid:6bbbb416-edc3-405f-a86d-231d5800235e");
+}
+
+TEST(BasicUuid, ToStringFormat) {
+  BasicUuid uuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E);
+  std::string result;
+  uuid.ToString<kUuidUppercase>(result);
+  EXPECT_EQ(result, "6BBBB416-EDC3-405F-A86D-231D5800235E");
+  uuid.ToString<kUuidLowercase>(result);
+  EXPECT_EQ(result, "6bbbb416-edc3-405f-a86d-231d5800235e");
+  uuid.ToString<kUuidCompact>(result);
+  EXPECT_EQ(result, "6BBBB416EDC3405FA86D231D5800235E");
+  uuid.ToString<kUuidBraced>(result);
+  EXPECT_EQ(result, "{6BBBB416-EDC3-405F-A86D-231D5800235E}");
+  uuid.ToString<kUuidUrn>(result);
+  EXPECT_EQ(result, "urn:uuid:6bbbb416-edc3-405f-a86d-231d5800235e");
+  uuid.ToString<UuidFormat{UuidLayout::kCompact, true}>(result);
+  EXPECT_EQ(result, "6bbbb416edc3405fa86d231d5800235e");
+  uuid.ToString<UuidFormat{UuidLayout::kBraced, true}>(result);
+  EXPECT_EQ(result, "{6bbbb416-edc3-405f-a86d-231d5800235e}");
+  uuid.ToString<UuidFormat{UuidLayout::kUrn, false}>(result);
+  EXPECT_EQ(result, "urn:uuid:6BBBB416-EDC3-405F-A86D-231D5800235E");
+}
+
+TEST(BasicUuid, ToCharsFormat) {
+  BasicUuid uuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF);
+  char braced[kUuidBraced.size() + 1];
+  uuid.ToChars<kUuidBraced>(braced);
+  EXPECT_EQ(std::string(braced), "{FEDCBA98-7654-3210-8899-AABBCCDDEEFF}");
+  char compact[kUuidCompact.size() + 1];
+  uuid.ToChars<kUuidCompact>(compact);
+  EXPECT_EQ(std::string(compact), "FEDCBA98765432108899AABBCCDDEEFF");
+  char urn[kUuidUrn.size() + 1];
+  uuid.ToChars<kUuidUrn>(urn);
+  EXPECT_EQ(std::string(urn), "urn:uuid:fedcba98-7654-3210-8899-aabbccddeeff");
+}
+
 TEST(BasicUuid, ToChars) {
   std::uint8_t data[16] = {0x6B, 0xBB, 0xB4, 0x16, 0xED, 0xC3, 0x40, 0x5F,
                            0xA8, 0x6D, 0x23, 0x1D, 0x58, 0x0,  0x23, 0x5E};
@@ -112,15 +193,147 @@ TEST(BasicUuid, FromStringInvalidDash) {
   }
 }
 
-TEST(BasicUuid, FromStringInvalidLowerCase) {
-  std::string from = "6BBBB416-EDC3-405F-A86D-231D5800235E";
+TEST(BasicUuid, FromStringLowerCase) {
+  std::optional<BasicUuid> uuid =
+      BasicUuid::FromString("6bbbb416-edc3-405f-a86d-231d5800235e");
+  ASSERT_TRUE(uuid.has_value());
+  EXPECT_EQ(std::string(*uuid), "6BBBB416-EDC3-405F-A86D-231D5800235E");
+}
+
+TEST(BasicUuid, FromStringMixedCase) {
+  std::optional<BasicUuid> uuid =
+      BasicUuid::FromString("FeDcBa98-7654-3210-8899-aAbBcCdDeEfF");
+  ASSERT_TRUE(uuid.has_value());
+  EXPECT_EQ(std::string(*uuid), "FEDCBA98-7654-3210-8899-AABBCCDDEEFF");
+}
+
+TEST(BasicUuid, FromStringInvalidNextToHex) {
+  // Characters right before and after the ranges of hex digits, and the ones
+  // that become digits if bit 5 is set.
+  std::string from = "6bbbb416-EDC3-405F-A86D-231D5800235E";
   for (int i = 0; i < 36; ++i) {
-    std::string from_invalid_dash = from;
-    from_invalid_dash[i] = 'a';
-    EXPECT_FALSE(BasicUuid::FromString(from_invalid_dash).has_value());
+    for (char c : {'/', ':', '@', 'G', '`', 'g', '\x10', '\x19'}) {
+      std::string from_invalid_hex = from;
+      from_invalid_hex[i] = c;
+      EXPECT_FALSE(BasicUuid::FromString(from_invalid_hex).has_value())
+          << from_invalid_hex;
+    }
   }
 }
 
+TEST(BasicUuid, ToBase64Url) {
+  BasicUuid uuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E);
+  char result[kBase64UrlSize + 1];
+  uuid.ToBase64Url(result);
+  EXPECT_EQ(std::string(result), "a7u0Fu3DQF-obSMdWAAjXg");
+  BasicUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF).ToBase64Url(result);
+  EXPECT_EQ(std::string(result), "_ty6mHZUMhCImaq7zN3u_w");
+}
+
+TEST(BasicUuid, ToBase32) {
+  BasicUuid uuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E);
+  char result[kBase32Size + 1];
+  uuid.ToBase32(result);
+  EXPECT_EQ(std::string(result), "3BQET1DVE381FTGV933NC008TY");
+  BasicUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF).ToBase32(result);
+  EXPECT_EQ(std::string(result), "7YVJX9GXJM6888H6DAQF6DVVQZ");
+}
+
+TEST(BasicUuid, FromBase64Url) {
+  EXPECT_EQ(BasicUuid::FromBase64Url("a7u0Fu3DQF-obSMdWAAjXg"),
+            BasicUuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E));
+  EXPECT_EQ(BasicUuid::FromBase64Url("_ty6mHZUMhCImaq7zN3u_w"),
+            BasicUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF));
+}
+
+TEST(BasicUuid, FromBase64UrlInvalid) {
+  // Standard base64 characters.
+  EXPECT_EQ(BasicUuid::FromBase64Url("a7u0Fu3DQF+obSMdWAAjXg"), std::nullopt);
+  EXPECT_EQ(BasicUuid::FromBase64Url("a7u0Fu3DQF-obSMdWAAj/g"), std::nullopt);
+  // The last 4 bits are not zeros.
+  EXPECT_EQ(BasicUuid::FromBase64Url("a7u0Fu3DQF-obSMdWAAjXh"), std::nullopt);
+  // Padding, and wrong lengths.
+  EXPECT_EQ(BasicUuid::FromBase64Url("a7u0Fu3DQF-obSMdWAAjXg=="), std::nullopt);
+  EXPECT_EQ(BasicUuid::FromBase64Url("a7u0Fu3DQF-obSMdWAAjX"), std::nullopt);
+  EXPECT_EQ(BasicUuid::FromBase64Url(""), std::nullopt);
+}
+
+TEST(BasicUuid, FromBase32) {
+  EXPECT_EQ(BasicUuid::FromBase32("3BQET1DVE381FTGV933NC008TY"),
+            BasicUuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E));
+  EXPECT_EQ(BasicUuid::FromBase32("7YVJX9GXJM6888H6DAQF6DVVQZ"),
+            BasicUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF));
+  // Lowercase, and the aliases of '1' and '0'.
+  EXPECT_EQ(BasicUuid::FromBase32("3bqetidve381ftgv933nc0o8ty"),
+            BasicUuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E));
+  EXPECT_EQ(BasicUuid::FromBase32("3BQETLDVE381FTGV933NCO08TY"),
+            BasicUuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E));
+}
+
+TEST(BasicUuid, FromBase32Invalid) {
+  // 'U' is not part of Crockford's base32.
+  EXPECT_EQ(BasicUuid::FromBase32("3BQET1DVE381FTGV933NC008TU"), std::nullopt);
+  EXPECT_EQ(BasicUuid::FromBase32("3BQET1DVE381FTGV933NC008T-"), std::nullopt);
+  // More than 128 bits.
+  EXPECT_EQ(BasicUuid::FromBase32("8BQET1DVE381FTGV933NC008TY"), std::nullopt);
+  EXPECT_EQ(BasicUuid::FromBase32("ZBQET1DVE381FTGV933NC008TY"), std::nullopt);
+  // Wrong lengths.
+  EXPECT_EQ(BasicUuid::FromBase32("3BQET1DVE381FTGV933NC008T"), std::nullopt);
+  EXPECT_EQ(BasicUuid::FromBase32("3BQET1DVE381FTGV933NC008TY0"), std::nullopt);
+}
+
+TEST(BasicUuid, ParseConstant) {
+  constexpr BasicUuid uuid =
+      BasicUuid::ParseConstant("6BBBB416-EDC3-405F-A86D-231D5800235E");
+  static_assert(uuid == BasicUuid(std::array<std::uint8_t, 16>{
+                            0x6B, 0xBB, 0xB4, 0x16, 0xED, 0xC3, 0x40, 0x5F,
+                            0xA8, 0x6D, 0x23, 0x1D, 0x58, 0x00, 0x23, 0x5E}));
+  static_assert(uuid ==
+                BasicUuid::ParseConstant("6bbbb416edc3405fa86d231d5800235e"));
+  static_assert(uuid ==
+                BasicUuid::ParseConstant("{6bbbb416-EDC3-405f-a86d-231d5800235e}"));
+  static_assert(uuid == BasicUuid::ParseConstant(
+                            "URN:uuid:6bbbb416-edc3-405f-a86d-231d5800235e"));
+  EXPECT_EQ(uuid, BasicUuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E));
+}
+
+TEST(BasicUuid, Literal) {
+  using namespace andyccs::literals;
+  constexpr BasicUuid uuid = "fedcba98-7654-3210-8899-aabbccddeeff"_basic_uuid;
+  static_assert(uuid != BasicUuid());
+  EXPECT_EQ(uuid, BasicUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF));
+  EXPECT_EQ(BasicUuid::FromString("FEDCBA98-7654-3210-8899-AABBCCDDEEFF"), uuid);
+}
+
+// Malformed constants do not compile, as ParseUuidConstexpr does not parse
+// them.
+TEST(BasicUuid, ParseConstantMalformed) {
+  using internal::ParseUuidConstexpr;
+  static_assert(!ParseUuidConstexpr(""));
+  static_assert(!ParseUuidConstexpr("6BBBB416-EDC3-405F-A86D-231D5800235"));
+  static_assert(!ParseUuidConstexpr("6BBBB416-EDC3-405F-A86D-231D5800235G"));
+  static_assert(!ParseUuidConstexpr("6BBBB416-EDC3-405F-A86D_231D5800235E"));
+  static_assert(!ParseUuidConstexpr("6BBBB416EDC3-405F-A86D-231D5800235E0"));
+  static_assert(!ParseUuidConstexpr("[6BBBB416-EDC3-405F-A86D-231D5800235E]"));
+  static_assert(
+      !ParseUuidConstexpr("urn:uuid-6BBBB416-EDC3-405F-A86D-231D5800235E"));
+}
+
+TEST(BasicUuid, Order) {
+  // Orders as the strings, so bytes are compared from the first one.
+  const BasicUuid a(0x0000000000000001, 0xFFFFFFFFFFFFFFFF);
+  const BasicUuid b(0x0000000000000100, 0x0000000000000000);
+  const BasicUuid c(0x0000000000000100, 0x0100000000000000);
+  EXPECT_LT(a, b);
+  EXPECT_LT(b, c);
+  EXPECT_GT(c, a);
+  EXPECT_LE(b, b);
+  EXPECT_EQ(b <=> BasicUuid(0x0000000000000100, 0), std::strong_ordering::equal);
+  EXPECT_LT(std::string(a), std::string(b));
+  EXPECT_LT(std::string(b), std::string(c));
+  static_assert(BasicUuid() < BasicUuid(std::array<std::uint8_t, 16>{0x80}));
+}
+
 TEST(BasicUuid, HashNoCollision) {
   BasicUuid uuid_1 = BasicUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF);
   BasicUuid uuid_2 = BasicUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFE);
@@ -145,4 +358,15 @@ TEST(BasicUuidGenerator, GenerateUUIDUsingMt199937_64) {
   EXPECT_NE(uuid, BasicUuid());
 }
 
+TEST(BasicUuidGenerator, GenerateUuids) {
+  BasicUuidGenerator<std::mt19937_64> generator;
+  for (std::size_t count : {0, 1, 63, 64, 1000}) {
+    std::vector<BasicUuid> uuids(count);
+    generator.GenerateUuids(uuids);
+    std::unordered_set<BasicUuid> unique(uuids.begin(), uuids.end());
+    EXPECT_EQ(unique.size(), count);
+    EXPECT_FALSE(unique.contains(BasicUuid()));
+  }
+}
+
 } // namespace andyccs
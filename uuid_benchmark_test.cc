@@ -27,6 +27,28 @@ static void BM_BoostUuidFromString(benchmark::State &state) {
 }
 BENCHMARK(BM_BoostUuidFromString)->Range(1 << 8, 1 << 8);
 
+// string_generator also reads the compact and braced forms, but not URNs.
+static void BM_BoostUuidParse(benchmark::State &state, UuidForm form) {
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  boost::uuids::uuid uuid(data);
+  std::string from = SetUuidForm(boost::uuids::to_string(uuid), form);
+
+  boost::uuids::string_generator gen;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(gen(from));
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK_CAPTURE(BM_BoostUuidParse, hyphenated, UuidForm::kHyphenated)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_CAPTURE(BM_BoostUuidParse, compact, UuidForm::kCompact)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_CAPTURE(BM_BoostUuidParse, braced, UuidForm::kBraced)
+    ->Range(1 << 8, 1 << 8);
+
 static void BM_BoostUuidFromArrayData(benchmark::State &state) {
   std::uint8_t data[16];
   GenerateRandomData(data);
@@ -107,6 +129,29 @@ static void BM_MeyrUuidFromString(benchmark::State &state) {
 }
 BENCHMARK(BM_MeyrUuidFromString)->Range(1 << 8, 1 << 8);
 
+// try_parse reads the same forms as string_generator.
+static void BM_MeyrUuidParse(benchmark::State &state, UuidForm form) {
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  std::string from =
+      SetUuidForm(boost::uuids::to_string(boost::uuids::uuid(data)), form);
+
+  meyr::UUID meyr_uuid;
+  benchmark::DoNotOptimize(meyr_uuid);
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(meyr_uuid.try_parse(from));
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK_CAPTURE(BM_MeyrUuidParse, hyphenated, UuidForm::kHyphenated)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_CAPTURE(BM_MeyrUuidParse, compact, UuidForm::kCompact)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_CAPTURE(BM_MeyrUuidParse, braced, UuidForm::kBraced)
+    ->Range(1 << 8, 1 << 8);
+
 static void BM_MeyrUuidToString(benchmark::State &state) {
   std::uint8_t data[16];
   GenerateRandomData(data);
@@ -1,7 +1,13 @@
 #ifndef ANDYCCS_UUID_BENCHMARK_UTILS_H
 #define ANDYCCS_UUID_BENCHMARK_UTILS_H
 
+#include <cstddef>
+#include <cstdint>
 #include <random>
+#include <string>
+#include <vector>
+
+#include "uuid_simd.h"
 
 namespace andyccs {
 
@@ -18,6 +24,62 @@ template <typename T> void GenerateRandomData(T &data) {
   }
 }
 
+enum class LetterCase { kUpper, kLower, kMixed };
+
+// Changes the case of the letters in `s`. kMixed alternates between lowercase
+// and uppercase letters.
+inline void SetLetterCase(std::string &s, LetterCase letter_case) {
+  bool lower = letter_case != LetterCase::kUpper;
+  for (char &c : s) {
+    if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) {
+      c = lower ? (c | 0x20) : (c & ~0x20);
+      lower ^= letter_case == LetterCase::kMixed;
+    }
+  }
+}
+
+enum class UuidForm { kHyphenated, kCompact, kBraced, kUrn };
+
+// Returns the hyphenated UUID string `s` in the given form.
+inline std::string SetUuidForm(std::string s, UuidForm form) {
+  switch (form) {
+  case UuidForm::kHyphenated:
+    return s;
+  case UuidForm::kCompact:
+    std::erase(s, '-');
+    return s;
+  case UuidForm::kBraced:
+    return "{" + s + "}";
+  case UuidForm::kUrn:
+    return "urn:uuid:" + s;
+  }
+  return s;
+}
+
+// Returns `count` UUIDs of random bits, the same ones for the same `seed`.
+inline std::vector<SimdUuid> RandomUuids(std::size_t count,
+                                         std::uint64_t seed = 42) {
+  std::mt19937_64 rng(seed);
+  std::vector<SimdUuid> uuids;
+  uuids.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    uuids.emplace_back(rng(), rng());
+  }
+  return uuids;
+}
+
+// Returns `count` lookups in a set of `uuids`: even lookups are UUIDs picked
+// from `uuids`, odd lookups are random UUIDs, which are not in the set.
+inline std::vector<SimdUuid> MixedQueries(const std::vector<SimdUuid> &uuids,
+                                          std::size_t count = 1 << 16) {
+  std::vector<SimdUuid> queries = RandomUuids(count, 7);
+  std::mt19937_64 rng(8);
+  for (std::size_t i = 0; i < queries.size(); i += 2) {
+    queries[i] = uuids[rng() % uuids.size()];
+  }
+  return queries;
+}
+
 } // namespace andyccs
 
 #endif // ANDYCCS_UUID_BENCHMARK_UTILS_H
\ No newline at end of file
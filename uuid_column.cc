@@ -0,0 +1,167 @@
+#include "uuid_column.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+#include "uuid_column_kernels.h"
+#include "uuid_cpu.h"
+
+namespace andyccs {
+namespace internal {
+
+std::size_t SelectScalar(const std::uint64_t *highs, const std::uint64_t *lows,
+                         std::size_t size, ColumnKeys keys,
+                         std::uint64_t *selection) {
+  std::size_t count = 0;
+  for (std::size_t block = 0; block * 64 < size; ++block) {
+    const std::size_t rows = std::min<std::size_t>(64, size - block * 64);
+    std::uint64_t bits = 0;
+    for (std::size_t i = 0; i < rows; ++i) {
+      const std::size_t row = block * 64 + i;
+      bool match = false;
+      for (std::size_t k = 0; k < keys.size; ++k) {
+        match |= (highs[row] == keys.highs[k]) & (lows[row] == keys.lows[k]);
+      }
+      bits |= std::uint64_t{match} << i;
+    }
+    selection[block] = bits;
+    count += std::popcount(bits);
+  }
+  return count;
+}
+
+} // namespace internal
+
+namespace {
+
+using internal::ColumnKeys;
+using internal::SelectKernel;
+
+// Rows filtered at a time by Find and Count, whose selection stays on the
+// stack and in the L1 cache.
+constexpr std::size_t kChunkRows = 4096;
+
+using ChunkSelection = std::array<std::uint64_t, kChunkRows / 64>;
+
+SelectKernel ActiveSelectInternal() {
+#ifdef ANDYCCS_ARCH_X86
+  if (ActiveCpuIsa() >= CpuIsa::kAvx2) {
+    return &internal::SelectAvx2;
+  }
+#endif
+  return &internal::SelectScalar;
+}
+
+SelectKernel ActiveSelect() {
+  static const SelectKernel kKernel = ActiveSelectInternal();
+  return kKernel;
+}
+
+// The keys of a filter, split in halves.
+class SplitKeys {
+public:
+  explicit SplitKeys(std::span<const SimdUuid> keys) {
+    highs_.reserve(keys.size());
+    lows_.reserve(keys.size());
+    for (const SimdUuid &key : keys) {
+      highs_.push_back(key.high());
+      lows_.push_back(key.low());
+    }
+  }
+
+  ColumnKeys get() const { return {highs_.data(), lows_.data(), highs_.size()}; }
+
+private:
+  std::vector<std::uint64_t> highs_;
+  std::vector<std::uint64_t> lows_;
+};
+
+std::size_t CountRows(std::span<const std::uint64_t> highs,
+                      std::span<const std::uint64_t> lows, ColumnKeys keys) {
+  const SelectKernel select = ActiveSelect();
+  ChunkSelection selection;
+  std::size_t count = 0;
+  for (std::size_t begin = 0; begin < highs.size(); begin += kChunkRows) {
+    count += select(highs.data() + begin, lows.data() + begin,
+                    std::min(kChunkRows, highs.size() - begin), keys,
+                    selection.data());
+  }
+  return count;
+}
+
+} // namespace
+
+UuidColumn::UuidColumn(std::span<const SimdUuid> uuids) {
+  reserve(uuids.size());
+  for (const SimdUuid &uuid : uuids) {
+    push_back(uuid);
+  }
+}
+
+void UuidColumn::reserve(std::size_t size) {
+  highs_.reserve(size);
+  lows_.reserve(size);
+}
+
+void UuidColumn::push_back(const SimdUuid &uuid) {
+  highs_.push_back(uuid.high());
+  lows_.push_back(uuid.low());
+}
+
+void UuidColumn::clear() {
+  highs_.clear();
+  lows_.clear();
+}
+
+std::optional<std::size_t> UuidColumn::Find(const SimdUuid &key,
+                                            std::size_t from) const {
+  const SelectKernel select = ActiveSelect();
+  const std::uint64_t key_high = key.high();
+  const std::uint64_t key_low = key.low();
+  const ColumnKeys keys = {&key_high, &key_low, 1};
+  ChunkSelection selection;
+  // Chunks start on a word of the selection, and the rows before `from` are
+  // cleared from the first one.
+  for (std::size_t begin = from / 64 * 64; begin < size();
+       begin += kChunkRows) {
+    const std::size_t rows = std::min(kChunkRows, size() - begin);
+    if (select(highs_.data() + begin, lows_.data() + begin, rows, keys,
+               selection.data()) == 0) {
+      continue;
+    }
+    if (begin < from) {
+      selection[0] &= ~std::uint64_t{0} << (from - begin);
+    }
+    for (std::size_t word = 0; word * 64 < rows; ++word) {
+      if (selection[word] != 0) {
+        return begin + word * 64 + std::countr_zero(selection[word]);
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+std::size_t UuidColumn::Count(const SimdUuid &key) const {
+  const std::uint64_t key_high = key.high();
+  const std::uint64_t key_low = key.low();
+  return CountRows(highs_, lows_, {&key_high, &key_low, 1});
+}
+
+std::size_t UuidColumn::CountIn(std::span<const SimdUuid> keys) const {
+  return CountRows(highs_, lows_, SplitKeys(keys).get());
+}
+
+std::size_t UuidColumn::Select(const SimdUuid &key,
+                               UuidSelection &selection) const {
+  return SelectIn(std::span<const SimdUuid>(&key, 1), selection);
+}
+
+std::size_t UuidColumn::SelectIn(std::span<const SimdUuid> keys,
+                                 UuidSelection &selection) const {
+  selection.resize((size() + 63) / 64);
+  return ActiveSelect()(highs_.data(), lows_.data(), size(),
+                        SplitKeys(keys).get(), selection.data());
+}
+
+} // namespace andyccs
@@ -0,0 +1,108 @@
+#ifndef ANDYCCS_UUID_COLUMN_H
+#define ANDYCCS_UUID_COLUMN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "uuid_simd.h"
+
+namespace andyccs {
+namespace internal {
+
+// Allocates arrays of T aligned on cache lines, so that SIMD loads never
+// straddle two lines.
+template <class T> struct CacheLineAllocator {
+  using value_type = T;
+
+  static constexpr std::align_val_t kAlignment{64};
+
+  CacheLineAllocator() = default;
+  template <class U> CacheLineAllocator(const CacheLineAllocator<U> &) {}
+
+  T *allocate(std::size_t size) {
+    return static_cast<T *>(::operator new(size * sizeof(T), kAlignment));
+  }
+  void deallocate(T *data, std::size_t) { ::operator delete(data, kAlignment); }
+
+  template <class U> bool operator==(const CacheLineAllocator<U> &) const {
+    return true;
+  }
+};
+
+} // namespace internal
+
+// Rows selected by a filter of UuidColumn: bit i % 64 of word i / 64 is set if
+// row i is selected. Bits past the last row are 0, so selections of the same
+// column can be combined word by word, e.g. with & and |.
+using UuidSelection = std::vector<std::uint64_t>;
+
+// A column of UUIDs, stored as a structure of arrays: the high and the low
+// halves of the UUIDs, see SimdUuid::high() and SimdUuid::low(), are in two
+// separate arrays aligned on cache lines.
+//
+// Filters compare 4 rows at a time with AVX2, one 64-bit half per lane, and
+// build a bitmap of the matching rows without branches. A scan of the column
+// reads 16 bytes per row and is bound by memory bandwidth, where a loop over
+// std::vector<SimdUuid> with SimdUuid::operator== compares one row at a time.
+class UuidColumn {
+public:
+  UuidColumn() = default;
+  explicit UuidColumn(std::span<const SimdUuid> uuids);
+
+  std::size_t size() const { return highs_.size(); }
+  bool empty() const { return highs_.empty(); }
+
+  void reserve(std::size_t size);
+  void push_back(const SimdUuid &uuid);
+  void clear();
+
+  SimdUuid operator[](std::size_t row) const {
+    return SimdUuid(highs_[row], lows_[row]);
+  }
+
+  // The halves of the UUIDs, one per row.
+  std::span<const std::uint64_t> highs() const { return highs_; }
+  std::span<const std::uint64_t> lows() const { return lows_; }
+
+  // Returns the first row at or after `from` that is `key`, or std::nullopt if
+  // there is none.
+  std::optional<std::size_t> Find(const SimdUuid &key,
+                                  std::size_t from = 0) const;
+
+  // Returns the number of rows that are `key`.
+  std::size_t Count(const SimdUuid &key) const;
+
+  // Returns the number of rows that are any of `keys`.
+  //
+  // Every row is compared with every key, so this is meant for small key sets,
+  // e.g. the IN list of a query. Above a few dozen keys, probing a hash set,
+  // e.g. UuidFlatSet, with every row is faster.
+  std::size_t CountIn(std::span<const SimdUuid> keys) const;
+
+  // Sets `selection` to the rows that are `key`, see UuidSelection.
+  //
+  // Returns the number of rows selected.
+  std::size_t Select(const SimdUuid &key, UuidSelection &selection) const;
+
+  // Sets `selection` to the rows that are any of `keys`, see UuidSelection and
+  // CountIn.
+  //
+  // Returns the number of rows selected.
+  std::size_t SelectIn(std::span<const SimdUuid> keys,
+                       UuidSelection &selection) const;
+
+private:
+  using Array =
+      std::vector<std::uint64_t, internal::CacheLineAllocator<std::uint64_t>>;
+
+  Array highs_;
+  Array lows_;
+};
+
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_COLUMN_H
@@ -0,0 +1,123 @@
+#include "uuid_column_kernels.h"
+
+#ifdef ANDYCCS_ARCH_X86
+
+#include <bit>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace andyccs {
+namespace internal {
+namespace {
+
+ANDYCCS_TARGET_AVX2 inline __m256i Load(const std::uint64_t *p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+// Returns all ones in the lanes of `high` and `low` that are the key.
+ANDYCCS_TARGET_AVX2 inline __m256i Equals(__m256i high, __m256i low,
+                                          __m256i key_high, __m256i key_low) {
+  return _mm256_and_si256(_mm256_cmpeq_epi64(high, key_high),
+                          _mm256_cmpeq_epi64(low, key_low));
+}
+
+ANDYCCS_TARGET_AVX2 inline std::uint64_t MoveMask(__m256i matches) {
+  return _mm256_movemask_pd(_mm256_castsi256_pd(matches));
+}
+
+// Returns bit i set if row i of the 64 rows at `highs` and `lows` is the key.
+ANDYCCS_TARGET_AVX2 inline std::uint64_t
+SelectBlock(const std::uint64_t *highs, const std::uint64_t *lows,
+            __m256i key_high, __m256i key_low) {
+  std::uint64_t bits = 0;
+  for (int i = 0; i < 64; i += 4) {
+    bits |= MoveMask(Equals(Load(highs + i), Load(lows + i), key_high, key_low))
+            << i;
+  }
+  return bits;
+}
+
+// Returns bit i set if row i of the 64 rows at `highs` and `lows` is any of
+// the keys.
+//
+// Rows are compared 16 at a time, first with the high halves of the keys only.
+// Rows whose high half is one of a key are rare, unless the keys and the rows
+// share a prefix, so the low halves are only compared in their groups.
+ANDYCCS_TARGET_AVX2 inline std::uint64_t SelectBlockIn(const std::uint64_t *highs,
+                                                       const std::uint64_t *lows,
+                                                       ColumnKeys keys) {
+  std::uint64_t bits = 0;
+  for (int i = 0; i < 64; i += 16) {
+    const __m256i high[4] = {Load(highs + i), Load(highs + i + 4),
+                             Load(highs + i + 8), Load(highs + i + 12)};
+    __m256i candidates = _mm256_setzero_si256();
+    for (std::size_t k = 0; k < keys.size; ++k) {
+      const __m256i key_high = _mm256_set1_epi64x(keys.highs[k]);
+      for (int j = 0; j < 4; ++j) {
+        candidates =
+            _mm256_or_si256(candidates, _mm256_cmpeq_epi64(high[j], key_high));
+      }
+    }
+    if (_mm256_testz_si256(candidates, candidates)) {
+      continue;
+    }
+    for (int j = 0; j < 4; ++j) {
+      const __m256i low = Load(lows + i + 4 * j);
+      __m256i matches = _mm256_setzero_si256();
+      for (std::size_t k = 0; k < keys.size; ++k) {
+        matches = _mm256_or_si256(
+            matches, Equals(high[j], low, _mm256_set1_epi64x(keys.highs[k]),
+                            _mm256_set1_epi64x(keys.lows[k])));
+      }
+      bits |= MoveMask(matches) << (i + 4 * j);
+    }
+  }
+  return bits;
+}
+
+template <class SelectBlockFunction>
+ANDYCCS_TARGET_AVX2 std::size_t SelectBlocks(std::size_t blocks,
+                                             std::uint64_t *selection,
+                                             const SelectBlockFunction &select) {
+  std::size_t count = 0;
+  for (std::size_t block = 0; block < blocks; ++block) {
+    const std::uint64_t bits = select(block * 64);
+    selection[block] = bits;
+    count += std::popcount(bits);
+  }
+  return count;
+}
+
+} // namespace
+
+ANDYCCS_TARGET_AVX2 std::size_t SelectAvx2(const std::uint64_t *highs,
+                                           const std::uint64_t *lows,
+                                           std::size_t size, ColumnKeys keys,
+                                           std::uint64_t *selection) {
+  // The loads are unaligned, but never cross a cache line in a UuidColumn,
+  // whose arrays are aligned on cache lines.
+  const std::size_t blocks = size / 64;
+  std::size_t count = 0;
+  if (keys.size == 1) {
+    // Most filters have a single key, which then stays in registers.
+    const __m256i key_high = _mm256_set1_epi64x(keys.highs[0]);
+    const __m256i key_low = _mm256_set1_epi64x(keys.lows[0]);
+    count = SelectBlocks(blocks, selection,
+                         [&](std::size_t row) ANDYCCS_TARGET_AVX2 {
+                           return SelectBlock(highs + row, lows + row,
+                                              key_high, key_low);
+                         });
+  } else {
+    count = SelectBlocks(blocks, selection,
+                         [&](std::size_t row) ANDYCCS_TARGET_AVX2 {
+                           return SelectBlockIn(highs + row, lows + row, keys);
+                         });
+  }
+  return count + SelectScalar(highs + blocks * 64, lows + blocks * 64,
+                              size - blocks * 64, keys, selection + blocks);
+}
+
+} // namespace internal
+} // namespace andyccs
+
+#endif
@@ -0,0 +1,163 @@
+#include "uuid_column.h"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "uuid_benchmark_utils.h"
+#include "uuid_column_kernels.h"
+#include "uuid_cpu.h"
+
+namespace andyccs {
+
+// The key of the benchmarks, at one row out of a million.
+static const SimdUuid kKey(0x6BBBB416EDC3405F, 0xA86D231D5800235E);
+
+// Random UUIDs, with kKey at every millionth row.
+static std::vector<SimdUuid> RowsWithKey(std::size_t count) {
+  std::vector<SimdUuid> uuids = RandomUuids(count);
+  for (std::size_t i = 0; i < count; i += 1'000'000) {
+    uuids[i] = kKey;
+  }
+  return uuids;
+}
+
+// 8 keys, of which only kKey is in the column, as in an IN list.
+static std::vector<SimdUuid> Keys() {
+  std::vector<SimdUuid> keys = {kKey};
+  for (std::uint64_t i = 1; i < 8; ++i) {
+    keys.emplace_back(i, i);
+  }
+  return keys;
+}
+
+// Columns from 10M to 1B UUIDs, i.e. 160 MB to 16 GB. The std::vector and the
+// UuidColumn benchmarks are not run together, so 1B UUIDs need 16 GB of memory.
+static void ColumnArguments(benchmark::internal::Benchmark *benchmark) {
+  for (int size : {10'000'000, 100'000'000, 1'000'000'000}) {
+    benchmark->Arg(size);
+  }
+  benchmark->Unit(benchmark::kMillisecond);
+}
+
+// What UuidColumn::Count replaces.
+static void BM_VectorCount(benchmark::State &state) {
+  const std::vector<SimdUuid> uuids = RowsWithKey(state.range(0));
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (const SimdUuid &uuid : uuids) {
+      count += uuid == kKey;
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetBytesProcessed(state.iterations() * uuids.size() * 16);
+}
+BENCHMARK(BM_VectorCount)->Apply(ColumnArguments);
+
+static void BM_ColumnCount(benchmark::State &state) {
+  const UuidColumn column(RowsWithKey(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(column.Count(kKey));
+  }
+  state.SetBytesProcessed(state.iterations() * column.size() * 16);
+}
+BENCHMARK(BM_ColumnCount)->Apply(ColumnArguments);
+
+// What UuidColumn::CountIn replaces.
+static void BM_VectorCountIn(benchmark::State &state) {
+  const std::vector<SimdUuid> uuids = RowsWithKey(state.range(0));
+  const std::vector<SimdUuid> keys = Keys();
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (const SimdUuid &uuid : uuids) {
+      for (const SimdUuid &key : keys) {
+        if (uuid == key) {
+          ++count;
+          break;
+        }
+      }
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetBytesProcessed(state.iterations() * uuids.size() * 16);
+}
+BENCHMARK(BM_VectorCountIn)->Apply(ColumnArguments);
+
+static void BM_ColumnCountIn(benchmark::State &state) {
+  const UuidColumn column(RowsWithKey(state.range(0)));
+  const std::vector<SimdUuid> keys = Keys();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(column.CountIn(keys));
+  }
+  state.SetBytesProcessed(state.iterations() * column.size() * 16);
+}
+BENCHMARK(BM_ColumnCountIn)->Apply(ColumnArguments);
+
+// What UuidColumn::Select replaces.
+static void BM_VectorSelect(benchmark::State &state) {
+  const std::vector<SimdUuid> uuids = RowsWithKey(state.range(0));
+  UuidSelection selection;
+  for (auto _ : state) {
+    selection.assign((uuids.size() + 63) / 64, 0);
+    for (std::size_t row = 0; row < uuids.size(); ++row) {
+      if (uuids[row] == kKey) {
+        selection[row / 64] |= std::uint64_t{1} << (row % 64);
+      }
+    }
+    benchmark::DoNotOptimize(selection.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * uuids.size() * 16);
+}
+BENCHMARK(BM_VectorSelect)->Apply(ColumnArguments);
+
+static void BM_ColumnSelect(benchmark::State &state) {
+  const UuidColumn column(RowsWithKey(state.range(0)));
+  UuidSelection selection;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(column.Select(kKey, selection));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * column.size() * 16);
+}
+BENCHMARK(BM_ColumnSelect)->Apply(ColumnArguments);
+
+// Selects the rows of a column that fits in the L2 cache with each kernel, to
+// compare the kernels rather than the memory.
+static void BM_SelectKernel(benchmark::State &state,
+                            internal::SelectKernel kernel, CpuIsa isa) {
+  if (!CpuSupports(isa)) {
+    state.SkipWithError("Instruction set not supported by the CPU");
+    return;
+  }
+  const UuidColumn column(RowsWithKey(state.range(0)));
+  const std::vector<SimdUuid> keys = Keys();
+  std::vector<std::uint64_t> highs;
+  std::vector<std::uint64_t> lows;
+  for (const SimdUuid &key : keys) {
+    highs.push_back(key.high());
+    lows.push_back(key.low());
+  }
+  const internal::ColumnKeys column_keys = {highs.data(), lows.data(),
+                                            static_cast<std::size_t>(
+                                                state.range(1))};
+  UuidSelection selection((column.size() + 63) / 64);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kernel(column.highs().data(),
+                                    column.lows().data(), column.size(),
+                                    column_keys, selection.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * column.size() * 16);
+}
+BENCHMARK_CAPTURE(BM_SelectKernel, scalar, &internal::SelectScalar,
+                  CpuIsa::kScalar)
+    ->Args({1 << 14, 1})
+    ->Args({1 << 14, 8});
+#ifdef ANDYCCS_ARCH_X86
+BENCHMARK_CAPTURE(BM_SelectKernel, avx2, &internal::SelectAvx2, CpuIsa::kAvx2)
+    ->Args({1 << 14, 1})
+    ->Args({1 << 14, 8});
+#endif
+
+} // namespace andyccs
+
+BENCHMARK_MAIN();
@@ -0,0 +1,41 @@
+#ifndef ANDYCCS_UUID_COLUMN_KERNELS_H
+#define ANDYCCS_UUID_COLUMN_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "uuid_cpu.h"
+
+namespace andyccs {
+namespace internal {
+
+// Keys of a UuidColumn filter, split in halves like the column.
+struct ColumnKeys {
+  const std::uint64_t *highs;
+  const std::uint64_t *lows;
+  std::size_t size;
+};
+
+// Writes the bitmap of the `size` rows of `highs` and `lows` that are any of
+// `keys` to `selection`, i.e. (size + 63) / 64 words, see UuidSelection.
+//
+// Returns the number of rows selected.
+using SelectKernel = std::size_t (*)(const std::uint64_t *highs,
+                                     const std::uint64_t *lows,
+                                     std::size_t size, ColumnKeys keys,
+                                     std::uint64_t *selection);
+
+std::size_t SelectScalar(const std::uint64_t *highs, const std::uint64_t *lows,
+                         std::size_t size, ColumnKeys keys,
+                         std::uint64_t *selection);
+
+#ifdef ANDYCCS_ARCH_X86
+std::size_t SelectAvx2(const std::uint64_t *highs, const std::uint64_t *lows,
+                       std::size_t size, ColumnKeys keys,
+                       std::uint64_t *selection);
+#endif
+
+} // namespace internal
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_COLUMN_KERNELS_H
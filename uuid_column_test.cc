@@ -0,0 +1,135 @@
+#include "uuid_column.h"
+
+#include <bit>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace andyccs {
+namespace {
+
+const SimdUuid kUuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E);
+
+// Random UUIDs, with `key` at every row in `rows`, and UUIDs that share one of
+// its halves around, which must not match.
+std::vector<SimdUuid> MakeRows(std::size_t size, const SimdUuid &key,
+                               const std::vector<std::size_t> &rows) {
+  std::mt19937_64 rng(42);
+  std::vector<SimdUuid> uuids;
+  for (std::size_t i = 0; i < size; ++i) {
+    switch (rng() % 3) {
+    case 0:
+      uuids.emplace_back(key.high(), rng());
+      break;
+    case 1:
+      uuids.emplace_back(rng(), key.low());
+      break;
+    default:
+      uuids.emplace_back(rng(), rng());
+    }
+  }
+  for (std::size_t row : rows) {
+    uuids[row] = key;
+  }
+  return uuids;
+}
+
+// Same as UuidColumn::SelectIn, one row at a time.
+UuidSelection SelectEveryRow(const std::vector<SimdUuid> &uuids,
+                             const std::vector<SimdUuid> &keys) {
+  UuidSelection selection((uuids.size() + 63) / 64);
+  for (std::size_t row = 0; row < uuids.size(); ++row) {
+    for (const SimdUuid &key : keys) {
+      if (uuids[row] == key) {
+        selection[row / 64] |= std::uint64_t{1} << (row % 64);
+      }
+    }
+  }
+  return selection;
+}
+
+TEST(UuidColumn, Rows) {
+  UuidColumn column;
+  EXPECT_TRUE(column.empty());
+  column.push_back(kUuid);
+  column.push_back(SimdUuid());
+  ASSERT_EQ(column.size(), 2u);
+  EXPECT_EQ(column[0], kUuid);
+  EXPECT_EQ(column[1], SimdUuid());
+  EXPECT_EQ(column.highs()[0], kUuid.high());
+  EXPECT_EQ(column.lows()[0], kUuid.low());
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(column.highs().data()) % 64, 0u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(column.lows().data()) % 64, 0u);
+  column.clear();
+  EXPECT_TRUE(column.empty());
+}
+
+TEST(UuidColumn, Empty) {
+  const UuidColumn column;
+  UuidSelection selection = {1};
+  EXPECT_FALSE(column.Find(kUuid));
+  EXPECT_EQ(column.Count(kUuid), 0u);
+  EXPECT_EQ(column.Select(kUuid, selection), 0u);
+  EXPECT_TRUE(selection.empty());
+}
+
+TEST(UuidColumn, Find) {
+  const std::vector<std::size_t> rows = {3, 64, 4095, 4096, 10000, 10006};
+  const UuidColumn column(MakeRows(10007, kUuid, rows));
+  EXPECT_EQ(column.Find(kUuid), 3u);
+  for (std::size_t i = 0; i + 1 < rows.size(); ++i) {
+    EXPECT_EQ(column.Find(kUuid, rows[i]), rows[i]);
+    EXPECT_EQ(column.Find(kUuid, rows[i] + 1), rows[i + 1]);
+  }
+  EXPECT_FALSE(column.Find(kUuid, 10007));
+  EXPECT_FALSE(column.Find(kUuid, 20000));
+  EXPECT_FALSE(column.Find(SimdUuid()));
+}
+
+// Every size around the 64-row blocks and the chunks of Find and Count.
+TEST(UuidColumn, Count) {
+  for (std::size_t size : {1, 63, 64, 65, 127, 4095, 4096, 4097, 10000}) {
+    std::vector<std::size_t> rows;
+    for (std::size_t row = 0; row < size; row += 7) {
+      rows.push_back(row);
+    }
+    rows.push_back(size - 1);
+    const std::vector<SimdUuid> uuids = MakeRows(size, kUuid, rows);
+    const UuidColumn column(uuids);
+    const UuidSelection expected = SelectEveryRow(uuids, {kUuid});
+    std::size_t count = 0;
+    for (std::uint64_t word : expected) {
+      count += std::popcount(word);
+    }
+    EXPECT_EQ(column.Count(kUuid), count) << size;
+
+    UuidSelection selection;
+    EXPECT_EQ(column.Select(kUuid, selection), count) << size;
+    EXPECT_EQ(selection, expected) << size;
+  }
+}
+
+TEST(UuidColumn, SelectIn) {
+  std::mt19937_64 rng(7);
+  std::vector<SimdUuid> keys;
+  for (int i = 0; i < 5; ++i) {
+    keys.emplace_back(rng(), rng());
+  }
+  std::vector<SimdUuid> uuids = MakeRows(1000, keys[0], {});
+  for (std::size_t row = 0; row < uuids.size(); row += 3) {
+    uuids[row] = keys[rng() % keys.size()];
+  }
+  const UuidColumn column(uuids);
+  UuidSelection selection;
+  for (std::size_t size = 0; size <= keys.size(); ++size) {
+    const std::vector<SimdUuid> some_keys(keys.begin(), keys.begin() + size);
+    const UuidSelection expected = SelectEveryRow(uuids, some_keys);
+    const std::size_t count = column.SelectIn(some_keys, selection);
+    EXPECT_EQ(selection, expected) << size;
+    EXPECT_EQ(column.CountIn(some_keys), count) << size;
+  }
+  EXPECT_EQ(column.CountIn(keys), 334u);
+}
+
+} // namespace
+} // namespace andyccs
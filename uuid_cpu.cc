@@ -0,0 +1,93 @@
+#include "uuid_cpu.h"
+
+#include <cstdlib>
+
+namespace andyccs {
+namespace {
+
+CpuIsa DetectCpuIsaInternal() {
+#if defined(ANDYCCS_ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+  __builtin_cpu_init();
+  // __builtin_cpu_supports also checks that the operating system saves the
+  // AVX and AVX-512 registers on context switches.
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+      __builtin_cpu_supports("avx512vl") &&
+      __builtin_cpu_supports("avx512vbmi")) {
+    return CpuIsa::kAvx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return CpuIsa::kAvx2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return CpuIsa::kSse42;
+  }
+#endif
+  return CpuIsa::kScalar;
+}
+
+bool DetectShaInternal() {
+#if defined(ANDYCCS_ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+#else
+  return false;
+#endif
+}
+
+CpuIsa ActiveCpuIsaInternal() {
+  CpuIsa detected = DetectCpuIsa();
+  const char *name = std::getenv("ANDYCCS_UUID_ISA");
+  if (name == nullptr) {
+    return detected;
+  }
+  std::optional<CpuIsa> requested = ParseCpuIsa(name);
+  if (!requested.has_value() || *requested > detected) {
+    return detected;
+  }
+  return *requested;
+}
+
+} // namespace
+
+std::string_view CpuIsaName(CpuIsa isa) {
+  switch (isa) {
+  case CpuIsa::kScalar:
+    return "scalar";
+  case CpuIsa::kSse42:
+    return "sse4.2";
+  case CpuIsa::kAvx2:
+    return "avx2";
+  case CpuIsa::kAvx512:
+    return "avx512";
+  }
+  return "unknown";
+}
+
+std::optional<CpuIsa> ParseCpuIsa(std::string_view name) {
+  for (CpuIsa isa :
+       {CpuIsa::kScalar, CpuIsa::kSse42, CpuIsa::kAvx2, CpuIsa::kAvx512}) {
+    if (name == CpuIsaName(isa)) {
+      return isa;
+    }
+  }
+  return std::nullopt;
+}
+
+CpuIsa DetectCpuIsa() {
+  static const CpuIsa kDetected = DetectCpuIsaInternal();
+  return kDetected;
+}
+
+bool CpuSupports(CpuIsa isa) { return isa <= DetectCpuIsa(); }
+
+bool CpuSupportsSha() {
+  static const bool kDetected = DetectShaInternal();
+  return kDetected;
+}
+
+CpuIsa ActiveCpuIsa() {
+  static const CpuIsa kActive = ActiveCpuIsaInternal();
+  return kActive;
+}
+
+} // namespace andyccs
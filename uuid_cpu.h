@@ -0,0 +1,72 @@
+#ifndef ANDYCCS_UUID_CPU_H
+#define ANDYCCS_UUID_CPU_H
+
+#include <optional>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||             \
+    defined(_M_IX86)
+#define ANDYCCS_ARCH_X86
+#endif
+
+// Functions marked with these attributes may use the instruction set in their
+// name, regardless of the flags the translation unit is compiled with. They
+// must only be called after checking CpuSupports().
+#if defined(__GNUC__) || defined(__clang__)
+#define ANDYCCS_TARGET_SSE42 __attribute__((target("sse4.2")))
+#define ANDYCCS_TARGET_AVX2 __attribute__((target("avx2")))
+#define ANDYCCS_TARGET_AVX512                                                  \
+  __attribute__((target("avx512f,avx512bw,avx512vl,avx512vbmi")))
+#define ANDYCCS_TARGET_SHA __attribute__((target("sha,sse4.1")))
+#else
+#define ANDYCCS_TARGET_SSE42
+#define ANDYCCS_TARGET_AVX2
+#define ANDYCCS_TARGET_AVX512
+#define ANDYCCS_TARGET_SHA
+#endif
+
+namespace andyccs {
+
+// Instruction sets with dedicated UUID kernels, from the most portable to the
+// fastest. A CPU that supports one of them supports all the previous ones.
+enum class CpuIsa {
+  kScalar,
+  kSse42,
+  kAvx2,
+  // AVX-512 F, BW, VL and VBMI, i.e. Ice Lake, Zen 4 and later.
+  kAvx512,
+};
+
+// Returns the name of the instruction set: "scalar", "sse4.2", "avx2" or
+// "avx512".
+std::string_view CpuIsaName(CpuIsa isa);
+
+// Returns the instruction set with the given name, as returned by CpuIsaName.
+std::optional<CpuIsa> ParseCpuIsa(std::string_view name);
+
+// Returns the fastest instruction set supported by the running CPU and
+// operating system. The CPU is only queried on the first call.
+CpuIsa DetectCpuIsa();
+
+// Returns true if the running CPU supports the instruction set.
+bool CpuSupports(CpuIsa isa);
+
+// Returns true if the running CPU has the SHA extensions, i.e. SHA-NI, which
+// are not part of any CpuIsa. Kernels using them should also check that
+// ActiveCpuIsa() is at least kSse42, so that ANDYCCS_UUID_ISA=scalar turns
+// them off.
+bool CpuSupportsSha();
+
+// Returns the instruction set that UUID kernels use. This is DetectCpuIsa(),
+// unless the ANDYCCS_UUID_ISA environment variable names a slower one, which
+// is useful to exercise every code path on a single machine, e.g.
+//
+// ANDYCCS_UUID_ISA=sse4.2 ./uuid_simd_test
+//
+// Names of unsupported or unknown instruction sets are ignored. The
+// environment is only read on the first call.
+CpuIsa ActiveCpuIsa();
+
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_CPU_H
@@ -0,0 +1,39 @@
+#include "uuid_cpu.h"
+
+#include <gtest/gtest.h>
+
+namespace andyccs {
+
+TEST(CpuIsa, NameRoundTrip) {
+  for (CpuIsa isa :
+       {CpuIsa::kScalar, CpuIsa::kSse42, CpuIsa::kAvx2, CpuIsa::kAvx512}) {
+    EXPECT_EQ(ParseCpuIsa(CpuIsaName(isa)), isa);
+  }
+}
+
+TEST(CpuIsa, ParseUnknownName) {
+  EXPECT_FALSE(ParseCpuIsa("").has_value());
+  EXPECT_FALSE(ParseCpuIsa("AVX2").has_value());
+  EXPECT_FALSE(ParseCpuIsa("neon").has_value());
+}
+
+TEST(CpuIsa, DetectedIsSupported) {
+  EXPECT_TRUE(CpuSupports(CpuIsa::kScalar));
+  EXPECT_TRUE(CpuSupports(DetectCpuIsa()));
+  EXPECT_EQ(DetectCpuIsa(), DetectCpuIsa());
+}
+
+TEST(CpuIsa, ActiveIsSupported) {
+  EXPECT_TRUE(CpuSupports(ActiveCpuIsa()));
+  EXPECT_EQ(ActiveCpuIsa(), ActiveCpuIsa());
+}
+
+TEST(CpuIsa, Sha) {
+  // Every CPU with SHA-NI has SSE4.2.
+  if (CpuSupportsSha()) {
+    EXPECT_TRUE(CpuSupports(CpuIsa::kSse42));
+  }
+  EXPECT_EQ(CpuSupportsSha(), CpuSupportsSha());
+}
+
+} // namespace andyccs
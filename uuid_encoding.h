@@ -0,0 +1,125 @@
+#ifndef ANDYCCS_UUID_ENCODING_H
+#define ANDYCCS_UUID_ENCODING_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace andyccs {
+
+// Shorter text forms of a UUID, for logs, URLs and keys where the 36
+// characters of the hex form are too many:
+//
+// - Base64url: the 16 bytes in the URL and filename safe base64 alphabet of
+//   RFC 4648, Section 5, without padding. 22 characters, e.g.
+//   "a7u0Fu3DQF-obSMdWAAjXg". The last character only carries 2 bits, the
+//   other 4 must be zeros.
+// - Base32: the 128-bit number in Crockford's base32, as in ULIDs. 26
+//   characters, e.g. "3BQET1DVE381FTGV933NC008TY". The first character only
+//   carries 3 bits, so it is at most '7'. Decoding ignores case and reads 'I'
+//   and 'L' as '1' and 'O' as '0'.
+inline constexpr std::size_t kBase64UrlSize = 22;
+inline constexpr std::size_t kBase32Size = 26;
+
+inline constexpr char kBase64UrlAlphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+inline constexpr char kBase32Alphabet[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+
+namespace internal {
+
+// Maps an ASCII character to its value, or to 0xFF if the character is not
+// part of the encoding.
+struct DecodeTable {
+  std::uint8_t value[256];
+
+  constexpr DecodeTable(const char *alphabet, std::size_t size) : value{} {
+    for (int i = 0; i < 256; ++i) {
+      value[i] = 0xFF;
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+      value[static_cast<std::uint8_t>(alphabet[i])] = i;
+    }
+  }
+};
+
+inline constexpr DecodeTable kBase64UrlTable(kBase64UrlAlphabet, 64);
+
+inline constexpr DecodeTable kBase32Table = [] {
+  DecodeTable table(kBase32Alphabet, 32);
+  for (int c = 'A'; c <= 'Z'; ++c) {
+    table.value[c + 'a' - 'A'] = table.value[c];
+  }
+  table.value['I'] = table.value['i'] = 1;
+  table.value['L'] = table.value['l'] = 1;
+  table.value['O'] = table.value['o'] = 0;
+  return table;
+}();
+
+// Portable base64url and base32 encodings, used by BasicUuid and by the
+// scalar SimdUuid kernels.
+//
+// The bytes of the UUID are read as a stream of bits, most significant bit
+// first, after kLeadingZeros zero bits, and every kBits bits become one
+// character. The last character is padded with zeros.
+template <int kBits, int kLeadingZeros>
+inline void EncodeBits(const std::uint8_t *data, const char *alphabet,
+                       char *out) {
+  constexpr std::uint32_t kMask = (1u << kBits) - 1;
+  std::uint32_t buffer = 0;
+  int bits = kLeadingZeros;
+  for (int i = 0; i < 16; ++i) {
+    buffer = (buffer << 8) | data[i];
+    bits += 8;
+    while (bits >= kBits) {
+      bits -= kBits;
+      *out++ = alphabet[(buffer >> bits) & kMask];
+    }
+  }
+  if (bits > 0) {
+    *out++ = alphabet[(buffer << (kBits - bits)) & kMask];
+  }
+}
+
+// The inverse of EncodeBits. Returns false if a character is not part of the
+// encoding, or if the leading or padding bits are not zeros, so that every
+// UUID has exactly one encoding.
+template <int kBits, int kLeadingZeros, std::size_t kSize>
+inline bool DecodeBits(const char *in, const DecodeTable &table,
+                       std::uint8_t *out) {
+  std::uint32_t buffer = 0;
+  int bits = -kLeadingZeros;
+  std::uint8_t invalid = 0;
+  for (std::size_t i = 0; i < kSize; ++i) {
+    const std::uint8_t value = table.value[static_cast<std::uint8_t>(in[i])];
+    invalid |= value;
+    buffer = (buffer << kBits) | (value & 0x3F);
+    bits += kBits;
+    if (bits >= 8) {
+      bits -= 8;
+      *out++ = buffer >> bits;
+    }
+  }
+  const std::uint8_t first = table.value[static_cast<std::uint8_t>(in[0])];
+  return (invalid & 0x80) == 0 && (first >> (kBits - kLeadingZeros)) == 0 &&
+         (buffer & ((1u << bits) - 1)) == 0;
+}
+
+inline void EncodeBase64Url(const std::uint8_t *data, char *out) {
+  EncodeBits<6, 0>(data, kBase64UrlAlphabet, out);
+}
+
+inline bool DecodeBase64Url(const char *in, std::uint8_t *out) {
+  return DecodeBits<6, 0, kBase64UrlSize>(in, kBase64UrlTable, out);
+}
+
+inline void EncodeBase32(const std::uint8_t *data, char *out) {
+  EncodeBits<5, 2>(data, kBase32Alphabet, out);
+}
+
+inline bool DecodeBase32(const char *in, std::uint8_t *out) {
+  return DecodeBits<5, 2, kBase32Size>(in, kBase32Table, out);
+}
+
+} // namespace internal
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_ENCODING_H
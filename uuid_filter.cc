@@ -0,0 +1,368 @@
+#include "uuid_filter.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#include "uuid_cpu.h"
+
+namespace andyccs {
+namespace internal {
+
+void BloomInsertScalar(BloomBlock *blocks, std::size_t size,
+                       const SimdUuid *uuids, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::uint64_t bits = FilterBits(uuids[i]);
+    BloomBlock &block = blocks[BloomBlockIndex(bits, size)];
+    const auto key = static_cast<std::uint32_t>(bits >> 32);
+    for (int word = 0; word < 8; ++word) {
+      block.words[word] |= std::uint32_t{1} << ((key * kBloomSalts[word]) >> 27);
+    }
+  }
+}
+
+std::size_t BloomQueryScalar(const BloomBlock *blocks, std::size_t size,
+                             const SimdUuid *uuids, std::size_t count,
+                             bool *found) {
+  std::size_t found_count = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::uint64_t bits = FilterBits(uuids[i]);
+    const BloomBlock &block = blocks[BloomBlockIndex(bits, size)];
+    const auto key = static_cast<std::uint32_t>(bits >> 32);
+    bool all = true;
+    for (int word = 0; word < 8; ++word) {
+      all &= (block.words[word] >> ((key * kBloomSalts[word]) >> 27)) & 1;
+    }
+    found[i] = all;
+    found_count += all;
+  }
+  return found_count;
+}
+
+std::size_t CuckooQueryScalar(const std::uint64_t *buckets, std::size_t size,
+                              const SimdUuid *uuids, std::size_t count,
+                              bool *found) {
+  std::size_t found_count = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::uint64_t bits = FilterBits(uuids[i]);
+    const std::uint16_t fingerprint = CuckooFingerprint(bits);
+    const std::size_t bucket = CuckooBucketIndex(bits, size);
+    found[i] = CuckooBucketHas(buckets[bucket], fingerprint) ||
+               CuckooBucketHas(
+                   buckets[CuckooAltIndex(bucket, fingerprint, size)],
+                   fingerprint);
+    found_count += found[i];
+  }
+  return found_count;
+}
+
+} // namespace internal
+
+namespace {
+
+using internal::BloomBlock;
+
+// Block and bucket indices are taken from 32 bits of the UUIDs.
+constexpr std::size_t kMaxFilterSize = std::size_t{1} << 32;
+
+// Fingerprints moved before an insertion gives up.
+constexpr int kMaxKicks = 500;
+
+constexpr std::string_view kBloomMagic = "UUIDBLM1";
+constexpr std::string_view kCuckooMagic = "UUIDCKO1";
+
+struct FilterKernels {
+  internal::BloomInsertKernel bloom_insert;
+  internal::BloomQueryKernel bloom_query;
+  internal::CuckooQueryKernel cuckoo_query;
+};
+
+FilterKernels ActiveFilterKernelsInternal() {
+#ifdef ANDYCCS_ARCH_X86
+  if (ActiveCpuIsa() >= CpuIsa::kAvx2) {
+    return {&internal::BloomInsertAvx2, &internal::BloomQueryAvx2,
+            &internal::CuckooQueryAvx2};
+  }
+#endif
+  return {&internal::BloomInsertScalar, &internal::BloomQueryScalar,
+          &internal::CuckooQueryScalar};
+}
+
+const FilterKernels &ActiveFilterKernels() {
+  static const FilterKernels kKernels = ActiveFilterKernelsInternal();
+  return kKernels;
+}
+
+// Appends the `count` words at `words` to `out`, in little-endian order.
+template <class T>
+void AppendWords(std::string &out, const T *words, std::size_t count) {
+  if constexpr (std::endian::native == std::endian::little) {
+    out.append(reinterpret_cast<const char *>(words), count * sizeof(T));
+  } else {
+    for (std::size_t i = 0; i < count; ++i) {
+      const T word = std::byteswap(words[i]);
+      out.append(reinterpret_cast<const char *>(&word), sizeof(T));
+    }
+  }
+}
+
+// Reads `count` little-endian words from `in` to `words`.
+template <class T> void ReadWords(const char *in, T *words, std::size_t count) {
+  std::memcpy(words, in, count * sizeof(T));
+  if constexpr (std::endian::native != std::endian::little) {
+    for (std::size_t i = 0; i < count; ++i) {
+      words[i] = std::byteswap(words[i]);
+    }
+  }
+}
+
+// Reads the header of a serialised filter: `magic`, followed by `fields`
+// words of 64 bits. Returns the rest of `data`, or std::nullopt if `data` does
+// not start with `magic`.
+std::optional<std::string_view> ReadHeader(std::string_view data,
+                                           std::string_view magic,
+                                           std::uint64_t *fields,
+                                           std::size_t count) {
+  if (!data.starts_with(magic) ||
+      data.size() < magic.size() + count * sizeof(std::uint64_t)) {
+    return std::nullopt;
+  }
+  data.remove_prefix(magic.size());
+  ReadWords(data.data(), fields, count);
+  data.remove_prefix(count * sizeof(std::uint64_t));
+  return data;
+}
+
+} // namespace
+
+UuidBloomFilter::UuidBloomFilter(std::size_t capacity, double bits_per_uuid) {
+  const double bits = std::ceil(capacity * bits_per_uuid);
+  const double blocks = std::ceil(bits / (8 * sizeof(BloomBlock)));
+  blocks_.resize(
+      std::clamp<double>(blocks, 1, static_cast<double>(kMaxFilterSize - 1)));
+}
+
+void UuidBloomFilter::Insert(const SimdUuid &uuid) {
+  ActiveFilterKernels().bloom_insert(blocks_.data(), blocks_.size(), &uuid, 1);
+}
+
+bool UuidBloomFilter::MayContain(const SimdUuid &uuid) const {
+  bool found;
+  ActiveFilterKernels().bloom_query(blocks_.data(), blocks_.size(), &uuid, 1,
+                                    &found);
+  return found;
+}
+
+void UuidBloomFilter::InsertBatch(std::span<const SimdUuid> uuids) {
+  ActiveFilterKernels().bloom_insert(blocks_.data(), blocks_.size(),
+                                     uuids.data(), uuids.size());
+}
+
+std::size_t UuidBloomFilter::MayContainBatch(std::span<const SimdUuid> uuids,
+                                             std::span<bool> found) const {
+  return ActiveFilterKernels().bloom_query(blocks_.data(), blocks_.size(),
+                                           uuids.data(), uuids.size(),
+                                           found.data());
+}
+
+std::string UuidBloomFilter::Serialize() const {
+  std::string data(kBloomMagic);
+  const std::uint64_t size = blocks_.size();
+  AppendWords(data, &size, 1);
+  AppendWords(data, blocks_.data()->words, blocks_.size() * 8);
+  return data;
+}
+
+std::optional<UuidBloomFilter>
+UuidBloomFilter::Deserialize(std::string_view data) {
+  std::uint64_t size;
+  std::optional<std::string_view> words =
+      ReadHeader(data, kBloomMagic, &size, 1);
+  if (!words.has_value() || size == 0 || size >= kMaxFilterSize ||
+      words->size() != size * sizeof(BloomBlock)) {
+    return std::nullopt;
+  }
+  UuidBloomFilter filter;
+  filter.blocks_.resize(size);
+  ReadWords(words->data(), filter.blocks_.data()->words, size * 8);
+  return filter;
+}
+
+UuidCuckooFilter::UuidCuckooFilter(std::size_t capacity) {
+  const auto buckets = static_cast<std::size_t>(std::ceil(capacity / (4 * 0.95)));
+  buckets_.resize(
+      std::bit_ceil(std::clamp<std::size_t>(buckets, 1, kMaxFilterSize)));
+}
+
+bool UuidCuckooFilter::TryStore(std::size_t bucket, std::uint16_t fingerprint) {
+  for (int slot = 0; slot < 64; slot += 16) {
+    if (((buckets_[bucket] >> slot) & 0xFFFF) == 0) {
+      buckets_[bucket] |= std::uint64_t{fingerprint} << slot;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool UuidCuckooFilter::VictimHas(std::uint64_t bits) const {
+  const std::uint16_t fingerprint = internal::CuckooFingerprint(bits);
+  const std::size_t bucket = internal::CuckooBucketIndex(bits, buckets_.size());
+  return victim_ != 0 && victim_ == fingerprint &&
+         (victim_bucket_ == bucket ||
+          victim_bucket_ ==
+              internal::CuckooAltIndex(bucket, fingerprint, buckets_.size()));
+}
+
+std::uint64_t UuidCuckooFilter::NextRandom() {
+  random_ ^= random_ << 13;
+  random_ ^= random_ >> 7;
+  random_ ^= random_ << 17;
+  return random_;
+}
+
+void UuidCuckooFilter::InsertFingerprint(std::size_t bucket,
+                                         std::uint16_t fingerprint) {
+  ++size_;
+  const std::size_t alt_bucket =
+      internal::CuckooAltIndex(bucket, fingerprint, buckets_.size());
+  if (TryStore(bucket, fingerprint) || TryStore(alt_bucket, fingerprint)) {
+    return;
+  }
+
+  // Both buckets are full: move a random fingerprint of one of them to its
+  // other bucket, and so on.
+  if (NextRandom() & 1) {
+    bucket = alt_bucket;
+  }
+  for (int kick = 0; kick < kMaxKicks; ++kick) {
+    const int slot = 16 * (NextRandom() & 3);
+    const auto moved = static_cast<std::uint16_t>(buckets_[bucket] >> slot);
+    buckets_[bucket] ^= std::uint64_t{static_cast<std::uint16_t>(
+                            moved ^ fingerprint)}
+                        << slot;
+    fingerprint = moved;
+    bucket = internal::CuckooAltIndex(bucket, fingerprint, buckets_.size());
+    if (TryStore(bucket, fingerprint)) {
+      return;
+    }
+  }
+  // The last fingerprint moved is kept aside, so that every UUID inserted is
+  // still found, and the filter is full.
+  victim_ = fingerprint;
+  victim_bucket_ = bucket;
+}
+
+bool UuidCuckooFilter::Insert(const SimdUuid &uuid) {
+  if (victim_ != 0) {
+    return false;
+  }
+  const std::uint64_t bits = internal::FilterBits(uuid);
+  InsertFingerprint(internal::CuckooBucketIndex(bits, buckets_.size()),
+                    internal::CuckooFingerprint(bits));
+  return true;
+}
+
+bool UuidCuckooFilter::MayContain(const SimdUuid &uuid) const {
+  bool found;
+  ActiveFilterKernels().cuckoo_query(buckets_.data(), buckets_.size(), &uuid,
+                                     1, &found);
+  return found || VictimHas(internal::FilterBits(uuid));
+}
+
+bool UuidCuckooFilter::Erase(const SimdUuid &uuid) {
+  const std::uint64_t bits = internal::FilterBits(uuid);
+  if (VictimHas(bits)) {
+    victim_ = 0;
+    --size_;
+    return true;
+  }
+  const std::uint16_t fingerprint = internal::CuckooFingerprint(bits);
+  const std::size_t bucket = internal::CuckooBucketIndex(bits, buckets_.size());
+  for (std::size_t b :
+       {bucket, internal::CuckooAltIndex(bucket, fingerprint, buckets_.size())}) {
+    for (int slot = 0; slot < 64; slot += 16) {
+      if (((buckets_[b] >> slot) & 0xFFFF) == fingerprint) {
+        buckets_[b] &= ~(std::uint64_t{0xFFFF} << slot);
+        --size_;
+        // There is room for the fingerprint kept aside now.
+        if (victim_ != 0) {
+          --size_;
+          InsertFingerprint(victim_bucket_, std::exchange(victim_, 0));
+        }
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+std::size_t UuidCuckooFilter::InsertBatch(std::span<const SimdUuid> uuids) {
+  std::size_t inserted = 0;
+  for (std::size_t i = 0; i < uuids.size(); ++i) {
+    if (i + internal::kFilterBatchSize < uuids.size()) {
+      const std::uint64_t bits =
+          internal::FilterBits(uuids[i + internal::kFilterBatchSize]);
+      const std::size_t bucket =
+          internal::CuckooBucketIndex(bits, buckets_.size());
+#if defined(__GNUC__) || defined(__clang__)
+      __builtin_prefetch(&buckets_[bucket], 1);
+      __builtin_prefetch(&buckets_[internal::CuckooAltIndex(
+                             bucket, internal::CuckooFingerprint(bits),
+                             buckets_.size())],
+                         1);
+#endif
+    }
+    inserted += Insert(uuids[i]);
+  }
+  return inserted;
+}
+
+std::size_t UuidCuckooFilter::MayContainBatch(std::span<const SimdUuid> uuids,
+                                              std::span<bool> found) const {
+  std::size_t count = ActiveFilterKernels().cuckoo_query(
+      buckets_.data(), buckets_.size(), uuids.data(), uuids.size(),
+      found.data());
+  if (victim_ != 0) {
+    for (std::size_t i = 0; i < uuids.size(); ++i) {
+      if (!found[i] && VictimHas(internal::FilterBits(uuids[i]))) {
+        found[i] = true;
+        ++count;
+      }
+    }
+  }
+  return count;
+}
+
+std::string UuidCuckooFilter::Serialize() const {
+  std::string data(kCuckooMagic);
+  const std::uint64_t header[] = {buckets_.size(), size_, victim_,
+                                  victim_bucket_, random_};
+  AppendWords(data, header, std::size(header));
+  AppendWords(data, buckets_.data(), buckets_.size());
+  return data;
+}
+
+std::optional<UuidCuckooFilter>
+UuidCuckooFilter::Deserialize(std::string_view data) {
+  std::uint64_t header[5] = {};
+  std::optional<std::string_view> words =
+      ReadHeader(data, kCuckooMagic, header, std::size(header));
+  const auto [size, count, victim, victim_bucket, random] = header;
+  if (!words.has_value() || !std::has_single_bit(size) ||
+      size > kMaxFilterSize || victim > 0xFFFF || victim_bucket >= size ||
+      words->size() != size * sizeof(std::uint64_t)) {
+    return std::nullopt;
+  }
+  UuidCuckooFilter filter;
+  filter.buckets_.resize(size);
+  ReadWords(words->data(), filter.buckets_.data(), size);
+  filter.size_ = count;
+  filter.victim_ = victim;
+  filter.victim_bucket_ = victim_bucket;
+  filter.random_ = random;
+  return filter;
+}
+
+} // namespace andyccs
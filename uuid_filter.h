@@ -0,0 +1,158 @@
+#ifndef ANDYCCS_UUID_FILTER_H
+#define ANDYCCS_UUID_FILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "uuid_filter_kernels.h"
+#include "uuid_simd.h"
+
+namespace andyccs {
+
+// Approximate sets of UUIDs, e.g. to check whether a UUID has been seen before
+// going to storage. A UUID that was inserted is always found, and a UUID that
+// was not is found with a small probability, the false positive rate.
+//
+// Generic filters hash their keys. Random UUIDs are already uniformly
+// distributed, so these filters take the positions of a UUID directly from its
+// bits, as UuidBitsHash does. Use them for version 4 and version 7 UUIDs, but
+// not for UUIDs whose bits are not random, e.g. sequential ids, nor for UUIDs
+// that may come from untrusted sources, which could pick UUIDs that collide.
+//
+// Both filters can be serialised, to be built once and shipped to the readers.
+// The format is little-endian, with a magic number and the size of the filter,
+// and is the same on every platform.
+
+// A split block Bloom filter: every UUID sets 8 bits in a block of 256 bits,
+// one bit in every word of 32 bits. A lookup reads one cache line, and tests
+// the 8 bits at once with AVX2.
+//
+// False positive rates: about 3% at 8 bits per UUID, 0.5% at 12, 0.13% at 16
+// and 0.04% at 20.
+class UuidBloomFilter {
+public:
+  // Creates a filter for `capacity` UUIDs, at `bits_per_uuid` bits per UUID.
+  // More UUIDs can be inserted, at a higher false positive rate.
+  explicit UuidBloomFilter(std::size_t capacity, double bits_per_uuid = 16);
+
+  void Insert(const SimdUuid &uuid);
+
+  // Returns true if `uuid` may have been inserted, and false if it has
+  // certainly not been.
+  bool MayContain(const SimdUuid &uuid) const;
+
+  // Same as Insert for every UUID. The blocks of the UUIDs are prefetched
+  // together, so that their cache misses overlap.
+  void InsertBatch(std::span<const SimdUuid> uuids);
+
+  // Sets `found[i]` to MayContain(uuids[i]) for every i. `found` has the size
+  // of `uuids`. The blocks of the UUIDs are prefetched together.
+  //
+  // Returns the number of UUIDs found.
+  std::size_t MayContainBatch(std::span<const SimdUuid> uuids,
+                              std::span<bool> found) const;
+
+  // Returns the size of the filter in bytes, without the header of Serialize.
+  std::size_t size_in_bytes() const {
+    return blocks_.size() * sizeof(internal::BloomBlock);
+  }
+
+  std::string Serialize() const;
+
+  // Returns the filter serialised in `data`, or std::nullopt if `data` is not
+  // a serialised UuidBloomFilter.
+  static std::optional<UuidBloomFilter> Deserialize(std::string_view data);
+
+private:
+  UuidBloomFilter() = default;
+
+  std::vector<internal::BloomBlock> blocks_;
+};
+
+// A cuckoo filter: every UUID stores a fingerprint of 16 bits in one of its 2
+// buckets of 4 fingerprints, moving other fingerprints to their other bucket
+// to make room if needed. A lookup reads 2 buckets of 8 bytes.
+//
+// Unlike UuidBloomFilter, UUIDs can be erased, and the false positive rate,
+// about 0.01%, does not depend on the size. The filter holds up to 95% of the
+// slots it was created with; Insert fails past that.
+class UuidCuckooFilter {
+public:
+  // Creates a filter for at least `capacity` UUIDs.
+  explicit UuidCuckooFilter(std::size_t capacity);
+
+  // Returns false, and does not insert `uuid`, if the filter is full, i.e. if a
+  // previous insertion could not find room for every fingerprint. Erasing a
+  // UUID makes room again.
+  bool Insert(const SimdUuid &uuid);
+
+  // Returns true if `uuid` may have been inserted, and false if it has
+  // certainly not been.
+  bool MayContain(const SimdUuid &uuid) const;
+
+  // Erases `uuid`, which must have been inserted, or it may erase another UUID
+  // with the same fingerprint. Returns false if `uuid` is not found.
+  bool Erase(const SimdUuid &uuid);
+
+  // Same as Insert for every UUID, prefetching the buckets of the next UUIDs.
+  //
+  // Returns the number of UUIDs inserted, which is the size of `uuids` unless
+  // the filter gets full.
+  std::size_t InsertBatch(std::span<const SimdUuid> uuids);
+
+  // Sets `found[i]` to MayContain(uuids[i]) for every i. `found` has the size
+  // of `uuids`. The buckets of the UUIDs are prefetched together, and compared
+  // 2 UUIDs at a time with AVX2.
+  //
+  // Returns the number of UUIDs found.
+  std::size_t MayContainBatch(std::span<const SimdUuid> uuids,
+                              std::span<bool> found) const;
+
+  // Returns the number of fingerprints in the filter.
+  std::size_t size() const { return size_; }
+
+  std::size_t size_in_bytes() const {
+    return buckets_.size() * sizeof(std::uint64_t);
+  }
+
+  std::string Serialize() const;
+
+  // Returns the filter serialised in `data`, or std::nullopt if `data` is not
+  // a serialised UuidCuckooFilter.
+  static std::optional<UuidCuckooFilter> Deserialize(std::string_view data);
+
+private:
+  UuidCuckooFilter() = default;
+
+  std::uint64_t NextRandom();
+
+  // Stores `fingerprint` in `bucket` or its other bucket, moving other
+  // fingerprints if both are full. If none is free after kMaxKicks moves, the
+  // last fingerprint moved is kept aside, see `victim_`.
+  void InsertFingerprint(std::size_t bucket, std::uint16_t fingerprint);
+
+  // Stores `fingerprint` in `bucket` if it has an empty slot.
+  bool TryStore(std::size_t bucket, std::uint16_t fingerprint);
+
+  // Returns true if the fingerprint that did not find a bucket is the one of
+  // `bits`.
+  bool VictimHas(std::uint64_t bits) const;
+
+  std::vector<std::uint64_t> buckets_;
+  std::size_t size_ = 0;
+  // The fingerprint that did not find a bucket when the filter got full, and
+  // one of its buckets, or 0 if the filter is not full.
+  std::uint16_t victim_ = 0;
+  std::size_t victim_bucket_ = 0;
+  // State of the random choice of the fingerprint to move.
+  std::uint64_t random_ = 0x9E3779B97F4A7C15;
+};
+
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_FILTER_H
@@ -0,0 +1,126 @@
+#include "uuid_filter_kernels.h"
+
+#ifdef ANDYCCS_ARCH_X86
+
+#include <algorithm>
+#include <immintrin.h>
+
+namespace andyccs {
+namespace internal {
+namespace {
+
+// Returns the 8 bits of a UUID in a block, one per word of 32 bits, from the
+// bits 32 to 63 of FilterBits.
+ANDYCCS_TARGET_AVX2 inline __m256i BloomMask(std::uint64_t bits) {
+  const __m256i salts =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(kBloomSalts));
+  const __m256i shifts = _mm256_srli_epi32(
+      _mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(bits >> 32)),
+                         salts),
+      27);
+  return _mm256_sllv_epi32(_mm256_set1_epi32(1), shifts);
+}
+
+// Computes the blocks of the `count` UUIDs, at most kFilterBatchSize, to
+// `bits` and `indices`, and prefetches them, so that their cache misses
+// overlap.
+inline void PrefetchBlocks(const BloomBlock *blocks, std::size_t size,
+                           const SimdUuid *uuids, std::size_t count,
+                           std::uint64_t *bits, std::size_t *indices) {
+  for (std::size_t i = 0; i < count; ++i) {
+    bits[i] = FilterBits(uuids[i]);
+    indices[i] = BloomBlockIndex(bits[i], size);
+    _mm_prefetch(reinterpret_cast<const char *>(blocks + indices[i]),
+                 _MM_HINT_T0);
+  }
+}
+
+} // namespace
+
+ANDYCCS_TARGET_AVX2 void BloomInsertAvx2(BloomBlock *blocks, std::size_t size,
+                                         const SimdUuid *uuids,
+                                         std::size_t count) {
+  std::uint64_t bits[kFilterBatchSize];
+  std::size_t indices[kFilterBatchSize];
+  for (std::size_t begin = 0; begin < count; begin += kFilterBatchSize) {
+    const std::size_t batch = std::min(kFilterBatchSize, count - begin);
+    PrefetchBlocks(blocks, size, uuids + begin, batch, bits, indices);
+    for (std::size_t i = 0; i < batch; ++i) {
+      auto *block = reinterpret_cast<__m256i *>(blocks + indices[i]);
+      _mm256_store_si256(block, _mm256_or_si256(_mm256_load_si256(block),
+                                                BloomMask(bits[i])));
+    }
+  }
+}
+
+ANDYCCS_TARGET_AVX2 std::size_t BloomQueryAvx2(const BloomBlock *blocks,
+                                               std::size_t size,
+                                               const SimdUuid *uuids,
+                                               std::size_t count,
+                                               bool *found) {
+  std::uint64_t bits[kFilterBatchSize];
+  std::size_t indices[kFilterBatchSize];
+  std::size_t found_count = 0;
+  for (std::size_t begin = 0; begin < count; begin += kFilterBatchSize) {
+    const std::size_t batch = std::min(kFilterBatchSize, count - begin);
+    PrefetchBlocks(blocks, size, uuids + begin, batch, bits, indices);
+    for (std::size_t i = 0; i < batch; ++i) {
+      const __m256i block = _mm256_load_si256(
+          reinterpret_cast<const __m256i *>(blocks + indices[i]));
+      // Whether every bit of the mask is set in the block.
+      found[begin + i] = _mm256_testc_si256(block, BloomMask(bits[i]));
+      found_count += found[begin + i];
+    }
+  }
+  return found_count;
+}
+
+ANDYCCS_TARGET_AVX2 std::size_t CuckooQueryAvx2(const std::uint64_t *buckets,
+                                                std::size_t size,
+                                                const SimdUuid *uuids,
+                                                std::size_t count,
+                                                bool *found) {
+  std::uint16_t fingerprints[kFilterBatchSize];
+  std::size_t indices[kFilterBatchSize];
+  std::size_t alt_indices[kFilterBatchSize];
+  std::size_t found_count = 0;
+  for (std::size_t begin = 0; begin < count; begin += kFilterBatchSize) {
+    const std::size_t batch = std::min(kFilterBatchSize, count - begin);
+    for (std::size_t i = 0; i < batch; ++i) {
+      const std::uint64_t bits = FilterBits(uuids[begin + i]);
+      fingerprints[i] = CuckooFingerprint(bits);
+      indices[i] = CuckooBucketIndex(bits, size);
+      alt_indices[i] = CuckooAltIndex(indices[i], fingerprints[i], size);
+      _mm_prefetch(reinterpret_cast<const char *>(buckets + indices[i]),
+                   _MM_HINT_T0);
+      _mm_prefetch(reinterpret_cast<const char *>(buckets + alt_indices[i]),
+                   _MM_HINT_T0);
+    }
+    // The 2 buckets of 2 UUIDs are compared at once, one UUID per 128-bit
+    // lane, with its fingerprint in every 16-bit slot. An odd last UUID is
+    // compared twice.
+    for (std::size_t i = 0; i < batch; i += 2) {
+      const std::size_t j = std::min(i + 1, batch - 1);
+      const __m256i slots = _mm256_setr_epi64x(
+          static_cast<long long>(buckets[indices[i]]),
+          static_cast<long long>(buckets[alt_indices[i]]),
+          static_cast<long long>(buckets[indices[j]]),
+          static_cast<long long>(buckets[alt_indices[j]]));
+      const __m256i fingerprint = _mm256_setr_m128i(
+          _mm_set1_epi16(static_cast<short>(fingerprints[i])),
+          _mm_set1_epi16(static_cast<short>(fingerprints[j])));
+      const auto mask = static_cast<std::uint32_t>(
+          _mm256_movemask_epi8(_mm256_cmpeq_epi16(slots, fingerprint)));
+      found[begin + i] = (mask & 0xFFFF) != 0;
+      found[begin + j] = (mask >> 16) != 0;
+      found_count += found[begin + i];
+      found_count += j != i && found[begin + j];
+    }
+  }
+  return found_count;
+}
+
+} // namespace internal
+} // namespace andyccs
+
+#endif
@@ -0,0 +1,255 @@
+#include "uuid_filter.h"
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "uuid_benchmark_utils.h"
+#include "uuid_cpu.h"
+#include "uuid_filter_kernels.h"
+
+namespace andyccs {
+
+// Reports the false positive rate of the odd lookups of MixedQueries, given
+// the number of lookups found, which includes every even lookup.
+static void SetFalsePositiveRate(benchmark::State &state, std::size_t found,
+                                 std::size_t queries) {
+  state.counters["fpr"] = static_cast<double>(found - queries / 2) /
+                          static_cast<double>(queries / 2);
+}
+
+// Filters from the L2 cache to far larger than the last level cache: at 16
+// bits per UUID, 1M UUIDs are 2 MB, 100M UUIDs 200 MB.
+static void FilterArguments(benchmark::internal::Benchmark *benchmark) {
+  for (int size : {1 << 20, 10'000'000, 100'000'000}) {
+    benchmark->Arg(size);
+  }
+}
+
+// What the filters replace: a Bloom filter of k bits anywhere in the filter,
+// from the double hashing of std::hash.
+class HashBloomFilter {
+public:
+  HashBloomFilter(std::size_t capacity, double bits_per_uuid)
+      : bits_((static_cast<std::size_t>(capacity * bits_per_uuid) + 63) / 64),
+        hashes_(static_cast<int>(std::round(bits_per_uuid * std::log(2.0)))) {}
+
+  void Insert(const SimdUuid &uuid) {
+    std::uint64_t hash = std::hash<SimdUuid>()(uuid);
+    const std::uint64_t step = (hash >> 32) | 1;
+    for (int i = 0; i < hashes_; ++i, hash += step) {
+      const std::size_t bit = hash % (bits_.size() * 64);
+      bits_[bit / 64] |= std::uint64_t{1} << (bit % 64);
+    }
+  }
+
+  bool MayContain(const SimdUuid &uuid) const {
+    std::uint64_t hash = std::hash<SimdUuid>()(uuid);
+    const std::uint64_t step = (hash >> 32) | 1;
+    for (int i = 0; i < hashes_; ++i, hash += step) {
+      const std::size_t bit = hash % (bits_.size() * 64);
+      if (((bits_[bit / 64] >> (bit % 64)) & 1) == 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  std::vector<std::uint64_t> bits_;
+  int hashes_;
+};
+
+static void BM_HashBloomFilterInsert(benchmark::State &state) {
+  const std::vector<SimdUuid> uuids = RandomUuids(1 << 16, 42);
+  HashBloomFilter filter(state.range(0), 16);
+  for (auto _ : state) {
+    for (const SimdUuid &uuid : uuids) {
+      filter.Insert(uuid);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * uuids.size());
+}
+BENCHMARK(BM_HashBloomFilterInsert)->Apply(FilterArguments);
+
+static void BM_HashBloomFilterMayContain(benchmark::State &state) {
+  const std::vector<SimdUuid> uuids = RandomUuids(state.range(0), 42);
+  const std::vector<SimdUuid> queries = MixedQueries(uuids);
+  HashBloomFilter filter(uuids.size(), 16);
+  for (const SimdUuid &uuid : uuids) {
+    filter.Insert(uuid);
+  }
+  std::size_t found = 0;
+  for (auto _ : state) {
+    found = 0;
+    for (const SimdUuid &query : queries) {
+      found += filter.MayContain(query);
+    }
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+  SetFalsePositiveRate(state, found, queries.size());
+}
+BENCHMARK(BM_HashBloomFilterMayContain)->Apply(FilterArguments);
+
+static void BM_UuidBloomFilterInsertBatch(benchmark::State &state) {
+  const std::vector<SimdUuid> uuids = RandomUuids(1 << 16, 42);
+  UuidBloomFilter filter(state.range(0));
+  for (auto _ : state) {
+    filter.InsertBatch(uuids);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * uuids.size());
+}
+BENCHMARK(BM_UuidBloomFilterInsertBatch)->Apply(FilterArguments);
+
+static void BM_UuidBloomFilterMayContain(benchmark::State &state) {
+  const std::vector<SimdUuid> uuids = RandomUuids(state.range(0), 42);
+  const std::vector<SimdUuid> queries = MixedQueries(uuids);
+  UuidBloomFilter filter(uuids.size());
+  filter.InsertBatch(uuids);
+  std::size_t found = 0;
+  for (auto _ : state) {
+    found = 0;
+    for (const SimdUuid &query : queries) {
+      found += filter.MayContain(query);
+    }
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+  SetFalsePositiveRate(state, found, queries.size());
+}
+BENCHMARK(BM_UuidBloomFilterMayContain)->Apply(FilterArguments);
+
+static void BM_UuidBloomFilterMayContainBatch(benchmark::State &state) {
+  const std::vector<SimdUuid> uuids = RandomUuids(state.range(0), 42);
+  const std::vector<SimdUuid> queries = MixedQueries(uuids);
+  UuidBloomFilter filter(uuids.size());
+  filter.InsertBatch(uuids);
+  std::unique_ptr<bool[]> results(new bool[queries.size()]);
+  std::size_t found = 0;
+  for (auto _ : state) {
+    found = filter.MayContainBatch(queries, {results.get(), queries.size()});
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+  SetFalsePositiveRate(state, found, queries.size());
+}
+BENCHMARK(BM_UuidBloomFilterMayContainBatch)->Apply(FilterArguments);
+
+static void BM_UuidCuckooFilterInsertBatch(benchmark::State &state) {
+  const std::vector<SimdUuid> uuids = RandomUuids(1 << 16, 42);
+  for (auto _ : state) {
+    // Half full, so that every insertion succeeds and none kicks much.
+    state.PauseTiming();
+    UuidCuckooFilter filter(state.range(0));
+    filter.InsertBatch(RandomUuids(state.range(0) / 2 - uuids.size(), 43));
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(filter.InsertBatch(uuids));
+  }
+  state.SetItemsProcessed(state.iterations() * uuids.size());
+}
+BENCHMARK(BM_UuidCuckooFilterInsertBatch)
+    ->Apply(FilterArguments)
+    ->Iterations(4);
+
+static void BM_UuidCuckooFilterMayContain(benchmark::State &state) {
+  const std::vector<SimdUuid> uuids = RandomUuids(state.range(0), 42);
+  const std::vector<SimdUuid> queries = MixedQueries(uuids);
+  UuidCuckooFilter filter(uuids.size());
+  filter.InsertBatch(uuids);
+  std::size_t found = 0;
+  for (auto _ : state) {
+    found = 0;
+    for (const SimdUuid &query : queries) {
+      found += filter.MayContain(query);
+    }
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+  SetFalsePositiveRate(state, found, queries.size());
+}
+BENCHMARK(BM_UuidCuckooFilterMayContain)->Apply(FilterArguments);
+
+static void BM_UuidCuckooFilterMayContainBatch(benchmark::State &state) {
+  const std::vector<SimdUuid> uuids = RandomUuids(state.range(0), 42);
+  const std::vector<SimdUuid> queries = MixedQueries(uuids);
+  UuidCuckooFilter filter(uuids.size());
+  filter.InsertBatch(uuids);
+  std::unique_ptr<bool[]> results(new bool[queries.size()]);
+  std::size_t found = 0;
+  for (auto _ : state) {
+    found = filter.MayContainBatch(queries, {results.get(), queries.size()});
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+  SetFalsePositiveRate(state, found, queries.size());
+}
+BENCHMARK(BM_UuidCuckooFilterMayContainBatch)->Apply(FilterArguments);
+
+// Queries a filter larger than the cache with each kernel.
+static void BM_BloomQueryKernel(benchmark::State &state,
+                                internal::BloomQueryKernel kernel,
+                                CpuIsa isa) {
+  if (!CpuSupports(isa)) {
+    state.SkipWithError("Instruction set not supported by the CPU");
+    return;
+  }
+  const std::vector<SimdUuid> uuids = RandomUuids(10'000'000, 42);
+  const std::vector<SimdUuid> queries = MixedQueries(uuids);
+  std::vector<internal::BloomBlock> blocks(uuids.size() / 16);
+  internal::BloomInsertScalar(blocks.data(), blocks.size(), uuids.data(),
+                              uuids.size());
+  std::unique_ptr<bool[]> found(new bool[queries.size()]);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kernel(blocks.data(), blocks.size(),
+                                    queries.data(), queries.size(),
+                                    found.get()));
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK_CAPTURE(BM_BloomQueryKernel, scalar, &internal::BloomQueryScalar,
+                  CpuIsa::kScalar);
+#ifdef ANDYCCS_ARCH_X86
+BENCHMARK_CAPTURE(BM_BloomQueryKernel, avx2, &internal::BloomQueryAvx2,
+                  CpuIsa::kAvx2);
+#endif
+
+static void BM_CuckooQueryKernel(benchmark::State &state,
+                                 internal::CuckooQueryKernel kernel,
+                                 CpuIsa isa) {
+  if (!CpuSupports(isa)) {
+    state.SkipWithError("Instruction set not supported by the CPU");
+    return;
+  }
+  const std::vector<SimdUuid> uuids = RandomUuids(10'000'000, 42);
+  const std::vector<SimdUuid> queries = MixedQueries(uuids);
+  UuidCuckooFilter filter(uuids.size());
+  filter.InsertBatch(uuids);
+  // The buckets, from the serialised filter after its header.
+  const std::string data = filter.Serialize();
+  std::vector<std::uint64_t> buckets(filter.size_in_bytes() / 8);
+  std::memcpy(buckets.data(), data.data() + data.size() - filter.size_in_bytes(),
+              filter.size_in_bytes());
+  std::unique_ptr<bool[]> found(new bool[queries.size()]);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kernel(buckets.data(), buckets.size(),
+                                    queries.data(), queries.size(),
+                                    found.get()));
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK_CAPTURE(BM_CuckooQueryKernel, scalar, &internal::CuckooQueryScalar,
+                  CpuIsa::kScalar);
+#ifdef ANDYCCS_ARCH_X86
+BENCHMARK_CAPTURE(BM_CuckooQueryKernel, avx2, &internal::CuckooQueryAvx2,
+                  CpuIsa::kAvx2);
+#endif
+
+} // namespace andyccs
+
+BENCHMARK_MAIN();
@@ -0,0 +1,123 @@
+#ifndef ANDYCCS_UUID_FILTER_KERNELS_H
+#define ANDYCCS_UUID_FILTER_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "uuid_cpu.h"
+#include "uuid_simd.h"
+
+namespace andyccs {
+namespace internal {
+
+// Returns the 64 bits of `uuid` that the filters use, as UuidBitsHash: the XOR
+// of its halves, whose bits are all random for version 4 UUIDs, and all but
+// the top 2 for version 7 UUIDs.
+//
+// Bits 0 to 31 pick the block or the bucket, and bits 32 to 63 the bits of the
+// block or the fingerprint, so that they are independent.
+inline std::uint64_t FilterBits(const SimdUuid &uuid) {
+  return uuid.high() ^ uuid.low();
+}
+
+// Lookups whose blocks or buckets are prefetched together in the batch
+// kernels.
+constexpr std::size_t kFilterBatchSize = 16;
+
+// A block of UuidBloomFilter, i.e. 8 words of 32 bits, in which every UUID
+// sets one bit per word. One block is one AVX2 register.
+struct alignas(32) BloomBlock {
+  std::uint32_t words[8];
+};
+
+// Odd multipliers that spread the 32 bits of a UUID for a block over the 8
+// words, as in the split block Bloom filters of Parquet and Impala.
+inline constexpr std::uint32_t kBloomSalts[8] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+// Returns the block of the bits of a UUID in a filter of `size` blocks, which
+// is below 2^32.
+inline std::size_t BloomBlockIndex(std::uint64_t bits, std::size_t size) {
+  return ((bits & 0xFFFFFFFF) * size) >> 32;
+}
+
+// Sets the blocks of the `count` UUIDs in the `size` blocks.
+using BloomInsertKernel = void (*)(BloomBlock *blocks, std::size_t size,
+                                   const SimdUuid *uuids, std::size_t count);
+
+// Sets `found[i]` to true if the bits of `uuids[i]` are set in the `size`
+// blocks, and to false otherwise.
+//
+// Returns the number of UUIDs found.
+using BloomQueryKernel = std::size_t (*)(const BloomBlock *blocks,
+                                         std::size_t size,
+                                         const SimdUuid *uuids,
+                                         std::size_t count, bool *found);
+
+void BloomInsertScalar(BloomBlock *blocks, std::size_t size,
+                       const SimdUuid *uuids, std::size_t count);
+std::size_t BloomQueryScalar(const BloomBlock *blocks, std::size_t size,
+                             const SimdUuid *uuids, std::size_t count,
+                             bool *found);
+
+// Buckets of UuidCuckooFilter hold 4 fingerprints of 16 bits, the lowest one
+// first. 0 is an empty slot, so a fingerprint of 0 is stored as 1.
+inline std::uint16_t CuckooFingerprint(std::uint64_t bits) {
+  const auto fingerprint = static_cast<std::uint16_t>(bits >> 32);
+  return fingerprint + (fingerprint == 0);
+}
+
+// Returns the first bucket of the bits of a UUID in a filter of `size`
+// buckets, which is a power of two below 2^32.
+inline std::size_t CuckooBucketIndex(std::uint64_t bits, std::size_t size) {
+  return bits & (size - 1);
+}
+
+// Returns the other bucket of a fingerprint in `bucket`. Called on either
+// bucket, it returns the other one, so that fingerprints can be moved without
+// the UUID.
+inline std::size_t CuckooAltIndex(std::size_t bucket, std::uint16_t fingerprint,
+                                  std::size_t size) {
+  // Multiplied, so that the fingerprints that differ in one bit do not end up
+  // in neighbouring buckets.
+  return (bucket ^ (fingerprint * std::uint64_t{0x5bd1e995})) & (size - 1);
+}
+
+// Returns true if `bucket` holds `fingerprint`, checking the 4 slots at once.
+inline bool CuckooBucketHas(std::uint64_t bucket, std::uint16_t fingerprint) {
+  constexpr std::uint64_t kOnes = 0x0001000100010001;
+  constexpr std::uint64_t kHighs = 0x8000800080008000;
+  const std::uint64_t diff = bucket ^ (fingerprint * kOnes);
+  // Sets the high bit of every slot that is 0, i.e. the fingerprint.
+  return ((diff - kOnes) & ~diff & kHighs) != 0;
+}
+
+// Sets `found[i]` to true if the fingerprint of `uuids[i]` is in one of its
+// buckets in the `size` buckets, and to false otherwise.
+//
+// Returns the number of UUIDs found.
+using CuckooQueryKernel = std::size_t (*)(const std::uint64_t *buckets,
+                                          std::size_t size,
+                                          const SimdUuid *uuids,
+                                          std::size_t count, bool *found);
+
+std::size_t CuckooQueryScalar(const std::uint64_t *buckets, std::size_t size,
+                              const SimdUuid *uuids, std::size_t count,
+                              bool *found);
+
+#ifdef ANDYCCS_ARCH_X86
+void BloomInsertAvx2(BloomBlock *blocks, std::size_t size,
+                     const SimdUuid *uuids, std::size_t count);
+std::size_t BloomQueryAvx2(const BloomBlock *blocks, std::size_t size,
+                           const SimdUuid *uuids, std::size_t count,
+                           bool *found);
+std::size_t CuckooQueryAvx2(const std::uint64_t *buckets, std::size_t size,
+                            const SimdUuid *uuids, std::size_t count,
+                            bool *found);
+#endif
+
+} // namespace internal
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_FILTER_KERNELS_H
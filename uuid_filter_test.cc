@@ -0,0 +1,218 @@
+#include "uuid_filter.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace andyccs {
+namespace {
+
+// Version 4 UUIDs, as SimdUuidGenerator generates them.
+std::vector<SimdUuid> RandomUuids(std::size_t count, std::uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<SimdUuid> uuids;
+  for (std::size_t i = 0; i < count; ++i) {
+    uuids.emplace_back((rng() & ~0xF000ULL) | 0x4000,
+                       (rng() >> 2) | 0x8000000000000000);
+  }
+  return uuids;
+}
+
+// Version 7 UUIDs generated within a few seconds: only the lowest bits of the
+// timestamp change.
+std::vector<SimdUuid> TimeOrderedUuids(std::size_t count, std::uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<SimdUuid> uuids;
+  const std::uint64_t timestamp = 1735506000000;
+  for (std::size_t i = 0; i < count; ++i) {
+    uuids.emplace_back((timestamp + i / 1000) << 16 | 0x7000 | (rng() & 0xFFF),
+                       (rng() >> 2) | 0x8000000000000000);
+  }
+  return uuids;
+}
+
+template <class Filter>
+double FalsePositiveRate(const Filter &filter,
+                         const std::vector<SimdUuid> &others) {
+  std::size_t found = 0;
+  for (const SimdUuid &uuid : others) {
+    found += filter.MayContain(uuid);
+  }
+  return static_cast<double>(found) / others.size();
+}
+
+// Checks MayContainBatch against MayContain.
+template <class Filter>
+void ExpectSameAsMayContain(const Filter &filter,
+                            const std::vector<SimdUuid> &uuids) {
+  std::unique_ptr<bool[]> found(new bool[uuids.size()]);
+  const std::size_t count =
+      filter.MayContainBatch(uuids, {found.get(), uuids.size()});
+  std::size_t expected_count = 0;
+  for (std::size_t i = 0; i < uuids.size(); ++i) {
+    EXPECT_EQ(found[i], filter.MayContain(uuids[i])) << i;
+    expected_count += found[i];
+  }
+  EXPECT_EQ(count, expected_count);
+}
+
+TEST(UuidBloomFilter, NoFalseNegatives) {
+  const std::vector<SimdUuid> uuids = RandomUuids(10000, 1);
+  UuidBloomFilter filter(uuids.size());
+  for (const SimdUuid &uuid : uuids) {
+    filter.Insert(uuid);
+    EXPECT_TRUE(filter.MayContain(uuid));
+  }
+  for (const SimdUuid &uuid : uuids) {
+    EXPECT_TRUE(filter.MayContain(uuid));
+  }
+  ExpectSameAsMayContain(filter, uuids);
+  ExpectSameAsMayContain(filter, RandomUuids(1001, 2));
+}
+
+TEST(UuidBloomFilter, InsertBatch) {
+  const std::vector<SimdUuid> uuids = RandomUuids(1001, 1);
+  UuidBloomFilter filter(uuids.size());
+  UuidBloomFilter batch_filter(uuids.size());
+  for (const SimdUuid &uuid : uuids) {
+    filter.Insert(uuid);
+  }
+  batch_filter.InsertBatch(uuids);
+  EXPECT_EQ(batch_filter.Serialize(), filter.Serialize());
+}
+
+TEST(UuidBloomFilter, FalsePositiveRate) {
+  const std::vector<SimdUuid> others = RandomUuids(100000, 2);
+  for (auto [bits_per_uuid, max_rate] :
+       {std::pair{8.0, 0.04}, {12.0, 0.008}, {16.0, 0.002}}) {
+    for (const std::vector<SimdUuid> &uuids :
+         {RandomUuids(100000, 1), TimeOrderedUuids(100000, 1)}) {
+      UuidBloomFilter filter(uuids.size(), bits_per_uuid);
+      filter.InsertBatch(uuids);
+      EXPECT_LT(FalsePositiveRate(filter, others), max_rate) << bits_per_uuid;
+      EXPECT_LT(FalsePositiveRate(filter, TimeOrderedUuids(100000, 2)),
+                max_rate)
+          << bits_per_uuid;
+    }
+  }
+}
+
+TEST(UuidBloomFilter, Serialize) {
+  const std::vector<SimdUuid> uuids = RandomUuids(1000, 1);
+  UuidBloomFilter filter(uuids.size());
+  filter.InsertBatch(uuids);
+  const std::string data = filter.Serialize();
+  EXPECT_EQ(data.size(), 16 + filter.size_in_bytes());
+
+  std::optional<UuidBloomFilter> copy = UuidBloomFilter::Deserialize(data);
+  ASSERT_TRUE(copy.has_value());
+  EXPECT_EQ(copy->Serialize(), data);
+  for (const SimdUuid &uuid : RandomUuids(1000, 2)) {
+    EXPECT_EQ(copy->MayContain(uuid), filter.MayContain(uuid));
+  }
+
+  EXPECT_FALSE(UuidBloomFilter::Deserialize(""));
+  EXPECT_FALSE(UuidBloomFilter::Deserialize(data.substr(0, data.size() - 1)));
+  EXPECT_FALSE(UuidBloomFilter::Deserialize(data + "x"));
+  EXPECT_FALSE(UuidBloomFilter::Deserialize("X" + data.substr(1)));
+  EXPECT_FALSE(UuidCuckooFilter::Deserialize(data));
+}
+
+TEST(UuidCuckooFilter, NoFalseNegatives) {
+  const std::vector<SimdUuid> uuids = RandomUuids(10000, 1);
+  UuidCuckooFilter filter(uuids.size());
+  for (const SimdUuid &uuid : uuids) {
+    EXPECT_TRUE(filter.Insert(uuid));
+    EXPECT_TRUE(filter.MayContain(uuid));
+  }
+  EXPECT_EQ(filter.size(), uuids.size());
+  for (const SimdUuid &uuid : uuids) {
+    EXPECT_TRUE(filter.MayContain(uuid));
+  }
+  ExpectSameAsMayContain(filter, uuids);
+  ExpectSameAsMayContain(filter, RandomUuids(1001, 2));
+}
+
+TEST(UuidCuckooFilter, FalsePositiveRate) {
+  const std::vector<SimdUuid> others = RandomUuids(100000, 2);
+  for (const std::vector<SimdUuid> &uuids :
+       {RandomUuids(100000, 1), TimeOrderedUuids(100000, 1)}) {
+    UuidCuckooFilter filter(uuids.size());
+    EXPECT_EQ(filter.InsertBatch(uuids), uuids.size());
+    EXPECT_LT(FalsePositiveRate(filter, others), 0.0005);
+    EXPECT_LT(FalsePositiveRate(filter, TimeOrderedUuids(100000, 2)), 0.0005);
+  }
+}
+
+TEST(UuidCuckooFilter, Erase) {
+  const std::vector<SimdUuid> uuids = RandomUuids(1000, 1);
+  UuidCuckooFilter filter(uuids.size());
+  filter.InsertBatch(uuids);
+  for (std::size_t i = 0; i < uuids.size(); i += 2) {
+    EXPECT_TRUE(filter.Erase(uuids[i]));
+  }
+  EXPECT_EQ(filter.size(), uuids.size() / 2);
+  for (std::size_t i = 1; i < uuids.size(); i += 2) {
+    EXPECT_TRUE(filter.MayContain(uuids[i]));
+  }
+  std::size_t erased_found = 0;
+  for (std::size_t i = 0; i < uuids.size(); i += 2) {
+    erased_found += filter.MayContain(uuids[i]);
+  }
+  EXPECT_LT(erased_found, 5u);
+  EXPECT_FALSE(filter.Erase(RandomUuids(1, 3)[0]));
+}
+
+TEST(UuidCuckooFilter, Full) {
+  const std::vector<SimdUuid> uuids = RandomUuids(2000, 1);
+  UuidCuckooFilter filter(100);
+  std::size_t inserted = 0;
+  while (inserted < uuids.size() && filter.Insert(uuids[inserted])) {
+    ++inserted;
+  }
+  // 32 buckets of 4 fingerprints, and one kept aside.
+  EXPECT_GT(inserted, 100u);
+  EXPECT_LE(inserted, 129u);
+  EXPECT_EQ(filter.size(), inserted);
+  EXPECT_FALSE(filter.Insert(uuids[inserted]));
+  for (std::size_t i = 0; i < inserted; ++i) {
+    EXPECT_TRUE(filter.MayContain(uuids[i])) << i;
+  }
+  ExpectSameAsMayContain(filter, uuids);
+
+  // Erasing a UUID makes room for the fingerprint kept aside, and then for
+  // another UUID.
+  EXPECT_TRUE(filter.Erase(uuids[0]));
+  EXPECT_EQ(filter.size(), inserted - 1);
+  for (std::size_t i = 1; i < inserted; ++i) {
+    EXPECT_TRUE(filter.MayContain(uuids[i])) << i;
+  }
+  EXPECT_TRUE(filter.Insert(uuids[inserted]));
+  EXPECT_TRUE(filter.MayContain(uuids[inserted]));
+}
+
+TEST(UuidCuckooFilter, Serialize) {
+  const std::vector<SimdUuid> uuids = RandomUuids(1000, 1);
+  UuidCuckooFilter filter(uuids.size());
+  filter.InsertBatch(uuids);
+  const std::string data = filter.Serialize();
+  EXPECT_EQ(data.size(), 48 + filter.size_in_bytes());
+
+  std::optional<UuidCuckooFilter> copy = UuidCuckooFilter::Deserialize(data);
+  ASSERT_TRUE(copy.has_value());
+  EXPECT_EQ(copy->size(), filter.size());
+  EXPECT_EQ(copy->Serialize(), data);
+  for (const SimdUuid &uuid : RandomUuids(1000, 2)) {
+    EXPECT_EQ(copy->MayContain(uuid), filter.MayContain(uuid));
+  }
+  EXPECT_TRUE(copy->Erase(uuids[0]));
+
+  EXPECT_FALSE(UuidCuckooFilter::Deserialize(""));
+  EXPECT_FALSE(UuidCuckooFilter::Deserialize(data.substr(0, data.size() - 8)));
+  EXPECT_FALSE(UuidCuckooFilter::Deserialize(data + "x"));
+  EXPECT_FALSE(UuidBloomFilter::Deserialize(data));
+}
+
+} // namespace
+} // namespace andyccs
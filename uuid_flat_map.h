@@ -0,0 +1,592 @@
+#ifndef ANDYCCS_UUID_FLAT_MAP_H
+#define ANDYCCS_UUID_FLAT_MAP_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "uuid_cpu.h"
+#include "uuid_simd.h"
+
+#ifdef ANDYCCS_ARCH_X86
+#include <emmintrin.h>
+#endif
+
+namespace andyccs {
+
+// Hash for UuidFlatMap and UuidFlatSet that returns the bits of the UUID as
+// they are, without mixing them. Random UUIDs are already uniformly
+// distributed, so there is nothing to gain from a real hash function.
+//
+// XORing both halves keeps the distribution uniform as long as one of them is
+// random, which covers version 4 and version 7 UUIDs, and version 1 UUIDs
+// generated in the same process. Use std::hash<SimdUuid> for keys that are not
+// random, e.g. sequential ids, or SeededUuidHash for keys that come from
+// untrusted sources.
+struct UuidBitsHash {
+  std::size_t operator()(const SimdUuid &uuid) const noexcept {
+    return static_cast<std::size_t>(uuid.high() ^ uuid.low());
+  }
+};
+
+namespace internal {
+
+// Control bytes of UuidFlatTable. Every slot has one control byte, which is
+// either one of these values, or the lowest 7 bits of the hash of the key in
+// the slot (H2).
+enum ControlByte : std::int8_t {
+  kEmpty = -128,
+  kDeleted = -2,
+  // After the last slot, to stop iterators.
+  kSentinel = -1,
+};
+
+// Bitmask with one bit per slot of a group, lowest slot first.
+class GroupBitMask {
+public:
+  explicit GroupBitMask(std::uint32_t mask) : mask_(mask) {}
+
+  explicit operator bool() const { return mask_ != 0; }
+
+  // Returns the index of the lowest set bit.
+  int Lowest() const { return std::countr_zero(mask_); }
+
+  // Clears the lowest set bit.
+  void ClearLowest() { mask_ &= mask_ - 1; }
+
+private:
+  std::uint32_t mask_;
+};
+
+// 16 control bytes, compared at once. Groups are aligned on 16 slots, so a
+// probe that finds an empty slot in a group never looks past this group.
+class Group {
+public:
+  static constexpr std::size_t kWidth = 16;
+
+#ifdef ANDYCCS_ARCH_X86
+  // SSE2 is part of x86-64, so there is no need for runtime dispatch here.
+  explicit Group(const std::int8_t *control)
+      : control_(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(control))) {}
+
+  // Returns the slots whose control byte is `h2`.
+  GroupBitMask Match(std::int8_t h2) const {
+    return GroupBitMask(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(control_, _mm_set1_epi8(h2))));
+  }
+
+  GroupBitMask MatchEmpty() const { return Match(kEmpty); }
+
+  // Returns the slots that do not hold a key.
+  GroupBitMask MatchEmptyOrDeleted() const {
+    // kEmpty and kDeleted are the only values below kSentinel.
+    return GroupBitMask(_mm_movemask_epi8(
+        _mm_cmpgt_epi8(_mm_set1_epi8(kSentinel), control_)));
+  }
+
+private:
+  __m128i control_;
+#else
+  explicit Group(const std::int8_t *control) {
+    std::memcpy(control_, control, kWidth);
+  }
+
+  GroupBitMask Match(std::int8_t h2) const {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<std::uint32_t>(control_[i] == h2) << i;
+    }
+    return GroupBitMask(mask);
+  }
+
+  GroupBitMask MatchEmpty() const { return Match(kEmpty); }
+
+  GroupBitMask MatchEmptyOrDeleted() const {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<std::uint32_t>(control_[i] < kSentinel) << i;
+    }
+    return GroupBitMask(mask);
+  }
+
+private:
+  std::int8_t control_[kWidth];
+#endif
+};
+
+// Open-addressing hash table behind UuidFlatMap and UuidFlatSet, in the style
+// of Swiss tables. Slots are stored inline in one array, and a second array has
+// one control byte per slot. A lookup compares the 7-bit H2 of its hash with
+// the 16 control bytes of a group at once, and only compares keys on a match,
+// so most lookups touch one control group and one slot.
+//
+// `Policy` describes the slots:
+// - Policy::slot_type is the type stored in the table.
+// - Policy::Key(slot) returns the SimdUuid key of a slot.
+template <typename Policy, typename Hash> class UuidFlatTable {
+public:
+  using slot_type = typename Policy::slot_type;
+
+  template <bool kConst> class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = slot_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<kConst, const slot_type &, slot_type &>;
+    using pointer = std::conditional_t<kConst, const slot_type *, slot_type *>;
+
+    Iterator() = default;
+
+    // Iterators convert to const iterators.
+    template <bool kOtherConst,
+              typename = std::enable_if_t<kConst && !kOtherConst>>
+    Iterator(const Iterator<kOtherConst> &other)
+        : control_(other.control_), slot_(other.slot_) {}
+
+    reference operator*() const { return *slot_; }
+    pointer operator->() const { return slot_; }
+
+    Iterator &operator++() {
+      ++control_;
+      ++slot_;
+      SkipEmptySlots();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator result = *this;
+      ++*this;
+      return result;
+    }
+
+    friend bool operator==(const Iterator &a, const Iterator &b) {
+      return a.slot_ == b.slot_;
+    }
+
+  private:
+    friend class UuidFlatTable;
+    template <bool> friend class Iterator;
+
+    Iterator(const std::int8_t *control, pointer slot)
+        : control_(control), slot_(slot) {}
+
+    void SkipEmptySlots() {
+      while (*control_ < kSentinel) {
+        ++control_;
+        ++slot_;
+      }
+    }
+
+    const std::int8_t *control_ = nullptr;
+    pointer slot_ = nullptr;
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  UuidFlatTable() = default;
+
+  UuidFlatTable(const UuidFlatTable &other) : hash_(other.hash_) {
+    reserve(other.size_);
+    for (const slot_type &slot : other) {
+      InsertNew(hash_(Policy::Key(slot)), slot);
+    }
+  }
+
+  UuidFlatTable &operator=(const UuidFlatTable &other) {
+    if (this != &other) {
+      UuidFlatTable copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  UuidFlatTable(UuidFlatTable &&other) noexcept { swap(other); }
+
+  UuidFlatTable &operator=(UuidFlatTable &&other) noexcept {
+    if (this != &other) {
+      UuidFlatTable moved(std::move(other));
+      swap(moved);
+    }
+    return *this;
+  }
+
+  ~UuidFlatTable() { Deallocate(); }
+
+  void swap(UuidFlatTable &other) noexcept {
+    using std::swap;
+    swap(control_, other.control_);
+    swap(slots_, other.slots_);
+    swap(capacity_, other.capacity_);
+    swap(size_, other.size_);
+    swap(growth_left_, other.growth_left_);
+    swap(hash_, other.hash_);
+  }
+
+  iterator begin() {
+    if (capacity_ == 0) {
+      return end();
+    }
+    iterator it(control_, slots_);
+    it.SkipEmptySlots();
+    return it;
+  }
+  iterator end() { return iterator(control_ + capacity_, slots_ + capacity_); }
+  const_iterator begin() const {
+    return const_cast<UuidFlatTable *>(this)->begin();
+  }
+  const_iterator end() const {
+    return const_cast<UuidFlatTable *>(this)->end();
+  }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Number of slots, i.e. a power of two, or zero.
+  std::size_t capacity() const { return capacity_; }
+
+  // Makes room for `count` keys, so that inserting them does not rehash.
+  void reserve(std::size_t count) {
+    if (count > size_ + growth_left_) {
+      Rehash(CapacityFor(count));
+    }
+  }
+
+  void clear() {
+    DestroySlots();
+    if (capacity_ != 0) {
+      ResetControl();
+    }
+    size_ = 0;
+    growth_left_ = MaxLoad(capacity_);
+  }
+
+  iterator find(const SimdUuid &key) { return Find(key, hash_(key)); }
+
+  const_iterator find(const SimdUuid &key) const {
+    return const_cast<UuidFlatTable *>(this)->find(key);
+  }
+
+  bool contains(const SimdUuid &key) const { return find(key) != end(); }
+
+  // Inserts the slot built from `args` if `key` is not in the table yet.
+  // Returns the slot with `key`, and whether it was inserted.
+  template <typename... Args>
+  std::pair<iterator, bool> TryEmplace(const SimdUuid &key, Args &&...args) {
+    std::size_t hash = hash_(key);
+    iterator it = Find(key, hash);
+    if (it != end()) {
+      return {it, false};
+    }
+    return {InsertNew(hash, std::forward<Args>(args)...), true};
+  }
+
+  // Removes the slot at `it`, which must be valid.
+  void erase(const_iterator it) {
+    std::size_t index = it.slot_ - slots_;
+    std::destroy_at(slots_ + index);
+    --size_;
+    // Probes stop at the first group with an empty slot. If this group has
+    // one, no probe went past it, so the slot can be reused right away.
+    // Otherwise a tombstone keeps the probes that went past it going.
+    std::size_t offset = index / Group::kWidth * Group::kWidth;
+    if (Group(control_ + offset).MatchEmpty()) {
+      control_[index] = kEmpty;
+      ++growth_left_;
+    } else {
+      control_[index] = kDeleted;
+    }
+  }
+
+  // Removes `key`. Returns the number of removed keys, i.e. 0 or 1.
+  std::size_t erase(const SimdUuid &key) {
+    iterator it = find(key);
+    if (it == end()) {
+      return 0;
+    }
+    erase(it);
+    return 1;
+  }
+
+private:
+  // Maximum number of keys in a table with `capacity` slots: 7/8 of it, which
+  // keeps probe sequences short.
+  static std::size_t MaxLoad(std::size_t capacity) {
+    return capacity - capacity / 8;
+  }
+
+  static std::size_t CapacityFor(std::size_t count) {
+    std::size_t capacity = Group::kWidth;
+    while (MaxLoad(capacity) < count) {
+      capacity *= 2;
+    }
+    return capacity;
+  }
+
+  // H1 picks the first group to probe, and H2 is stored in the control byte.
+  // They come from different bits of the hash.
+  static std::size_t H1(std::size_t hash) { return hash >> 7; }
+  static std::int8_t H2(std::size_t hash) { return hash & 0x7F; }
+
+  iterator Find(const SimdUuid &key, std::size_t hash) {
+    if (capacity_ == 0) {
+      return end();
+    }
+    std::int8_t h2 = H2(hash);
+    std::size_t group_mask = capacity_ / Group::kWidth - 1;
+    std::size_t group = H1(hash) & group_mask;
+    for (std::size_t step = 1;; ++step) {
+      std::size_t offset = group * Group::kWidth;
+      Group g(control_ + offset);
+      for (GroupBitMask match = g.Match(h2); match; match.ClearLowest()) {
+        std::size_t index = offset + match.Lowest();
+        if (Policy::Key(slots_[index]) == key) {
+          return iterator(control_ + index, slots_ + index);
+        }
+      }
+      if (g.MatchEmpty()) {
+        return end();
+      }
+      // Triangular probing visits every group when their count is a power of
+      // two.
+      group = (group + step) & group_mask;
+    }
+  }
+
+  // Constructs a slot for a key with the given hash that is not in the table.
+  template <typename... Args>
+  iterator InsertNew(std::size_t hash, Args &&...args) {
+    if (growth_left_ == 0) {
+      // `args` may refer to a slot of the table, so build the new slot before
+      // rehashing.
+      alignas(slot_type) unsigned char buffer[sizeof(slot_type)];
+      slot_type *slot = ::new (buffer) slot_type(std::forward<Args>(args)...);
+      // Reclaim tombstones when they take more than half of the room,
+      // otherwise grow.
+      Rehash(capacity_ != 0 && size_ * 2 <= MaxLoad(capacity_)
+                 ? capacity_
+                 : CapacityFor(size_ + 1));
+      std::size_t index = ClaimFreeSlot(hash);
+      ::new (slots_ + index) slot_type(std::move(*slot));
+      std::destroy_at(slot);
+      return iterator(control_ + index, slots_ + index);
+    }
+    std::size_t index = ClaimFreeSlot(hash);
+    ::new (slots_ + index) slot_type(std::forward<Args>(args)...);
+    return iterator(control_ + index, slots_ + index);
+  }
+
+  // Marks the first free slot on the probe sequence of `hash` as taken, and
+  // returns its index. The table must have room for one more key.
+  std::size_t ClaimFreeSlot(std::size_t hash) {
+    std::size_t group_mask = capacity_ / Group::kWidth - 1;
+    std::size_t group = H1(hash) & group_mask;
+    for (std::size_t step = 1;; ++step) {
+      std::size_t offset = group * Group::kWidth;
+      GroupBitMask free = Group(control_ + offset).MatchEmptyOrDeleted();
+      if (free) {
+        std::size_t index = offset + free.Lowest();
+        growth_left_ -= control_[index] == kEmpty;
+        control_[index] = H2(hash);
+        ++size_;
+        return index;
+      }
+      group = (group + step) & group_mask;
+    }
+  }
+
+  // Moves all the slots to a new table with `capacity` slots.
+  void Rehash(std::size_t capacity) {
+    UuidFlatTable old;
+    swap(old);
+    hash_ = old.hash_;
+    Allocate(capacity);
+    for (slot_type &slot : old) {
+      std::size_t index = ClaimFreeSlot(hash_(Policy::Key(slot)));
+      ::new (slots_ + index) slot_type(std::move(slot));
+    }
+  }
+
+  void Allocate(std::size_t capacity) {
+    capacity_ = capacity;
+    // One more control byte for the sentinel.
+    control_ = new std::int8_t[capacity + 1];
+    slots_ = std::allocator<slot_type>().allocate(capacity);
+    ResetControl();
+    growth_left_ = MaxLoad(capacity);
+  }
+
+  void ResetControl() {
+    std::memset(control_, kEmpty, capacity_);
+    control_[capacity_] = kSentinel;
+  }
+
+  void DestroySlots() {
+    for (iterator it = begin(); it != end(); ++it) {
+      std::destroy_at(&*it);
+    }
+  }
+
+  void Deallocate() {
+    if (capacity_ == 0) {
+      return;
+    }
+    DestroySlots();
+    delete[] control_;
+    std::allocator<slot_type>().deallocate(slots_, capacity_);
+    control_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = 0;
+    size_ = 0;
+    growth_left_ = 0;
+  }
+
+  std::int8_t *control_ = nullptr;
+  slot_type *slots_ = nullptr;
+  std::size_t capacity_ = 0;
+  std::size_t size_ = 0;
+  // Number of keys that can be inserted before the next rehash.
+  std::size_t growth_left_ = 0;
+  [[no_unique_address]] Hash hash_;
+};
+
+template <typename T> struct UuidFlatMapPolicy {
+  using slot_type = std::pair<const SimdUuid, T>;
+  static const SimdUuid &Key(const slot_type &slot) { return slot.first; }
+};
+
+struct UuidFlatSetPolicy {
+  using slot_type = SimdUuid;
+  static const SimdUuid &Key(const slot_type &slot) { return slot; }
+};
+
+} // namespace internal
+
+// Hash map from SimdUuid to T, for large maps where std::unordered_map spends
+// most of its time allocating nodes and chasing pointers. Keys and values are
+// stored inline in a single array, and lookups probe 16 slots at once with
+// SSE2, see internal::UuidFlatTable.
+//
+// The interface is a subset of std::unordered_map. Unlike std::unordered_map,
+// inserting into or erasing from the map invalidates all iterators and
+// references, and keys are hashed with UuidBitsHash by default.
+//
+// Example:
+//
+// UuidFlatMap<Session> sessions;
+// sessions[id] = session;
+// if (auto it = sessions.find(id); it != sessions.end()) {
+//   it->second.Touch();
+// }
+template <typename T, typename Hash = UuidBitsHash> class UuidFlatMap {
+  using Table = internal::UuidFlatTable<internal::UuidFlatMapPolicy<T>, Hash>;
+
+public:
+  using key_type = SimdUuid;
+  using mapped_type = T;
+  using value_type = std::pair<const SimdUuid, T>;
+  using iterator = typename Table::iterator;
+  using const_iterator = typename Table::const_iterator;
+
+  UuidFlatMap() = default;
+
+  iterator begin() { return table_.begin(); }
+  iterator end() { return table_.end(); }
+  const_iterator begin() const { return table_.begin(); }
+  const_iterator end() const { return table_.end(); }
+
+  std::size_t size() const { return table_.size(); }
+  bool empty() const { return table_.empty(); }
+  std::size_t capacity() const { return table_.capacity(); }
+  void reserve(std::size_t count) { table_.reserve(count); }
+  void clear() { table_.clear(); }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return table_.TryEmplace(value.first, value);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const SimdUuid &key, Args &&...args) {
+    return table_.TryEmplace(key, std::piecewise_construct,
+                             std::forward_as_tuple(key),
+                             std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  T &operator[](const SimdUuid &key) { return try_emplace(key).first->second; }
+
+  // Throws std::out_of_range if `key` is not in the map.
+  T &at(const SimdUuid &key) {
+    iterator it = find(key);
+    if (it == end()) {
+      throw std::out_of_range("UuidFlatMap::at");
+    }
+    return it->second;
+  }
+  const T &at(const SimdUuid &key) const {
+    return const_cast<UuidFlatMap *>(this)->at(key);
+  }
+
+  iterator find(const SimdUuid &key) { return table_.find(key); }
+  const_iterator find(const SimdUuid &key) const { return table_.find(key); }
+  bool contains(const SimdUuid &key) const { return table_.contains(key); }
+  std::size_t count(const SimdUuid &key) const { return contains(key); }
+
+  void erase(const_iterator it) { table_.erase(it); }
+  std::size_t erase(const SimdUuid &key) { return table_.erase(key); }
+
+  void swap(UuidFlatMap &other) noexcept { table_.swap(other.table_); }
+
+private:
+  Table table_;
+};
+
+// Hash set of SimdUuid, see UuidFlatMap.
+template <typename Hash = UuidBitsHash> class UuidFlatSet {
+  using Table = internal::UuidFlatTable<internal::UuidFlatSetPolicy, Hash>;
+
+public:
+  using key_type = SimdUuid;
+  using value_type = SimdUuid;
+  using iterator = typename Table::const_iterator;
+  using const_iterator = typename Table::const_iterator;
+
+  UuidFlatSet() = default;
+
+  const_iterator begin() const { return table_.begin(); }
+  const_iterator end() const { return table_.end(); }
+
+  std::size_t size() const { return table_.size(); }
+  bool empty() const { return table_.empty(); }
+  std::size_t capacity() const { return table_.capacity(); }
+  void reserve(std::size_t count) { table_.reserve(count); }
+  void clear() { table_.clear(); }
+
+  std::pair<const_iterator, bool> insert(const SimdUuid &key) {
+    return table_.TryEmplace(key, key);
+  }
+
+  const_iterator find(const SimdUuid &key) const { return table_.find(key); }
+  bool contains(const SimdUuid &key) const { return table_.contains(key); }
+  std::size_t count(const SimdUuid &key) const { return contains(key); }
+
+  void erase(const_iterator it) { table_.erase(it); }
+  std::size_t erase(const SimdUuid &key) { return table_.erase(key); }
+
+  void swap(UuidFlatSet &other) noexcept { table_.swap(other.table_); }
+
+private:
+  Table table_;
+};
+
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_FLAT_MAP_H
@@ -0,0 +1,101 @@
+#include "uuid_flat_map.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace andyccs {
+
+static std::vector<SimdUuid> GenerateUuids(std::size_t count) {
+  SimdUuidGenerator<std::mt19937_64> generator;
+  std::vector<SimdUuid> uuids;
+  uuids.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    uuids.push_back(generator.GenerateUuid());
+  }
+  return uuids;
+}
+
+using StdMap = std::unordered_map<SimdUuid, std::uint64_t>;
+using FlatMap = UuidFlatMap<std::uint64_t>;
+
+// From 1K to 100M entries. Maps of 100M entries take a few GB of memory.
+static void MapSizes(benchmark::internal::Benchmark *b) {
+  b->RangeMultiplier(10)
+      ->Range(1000, 100000000)
+      ->Unit(benchmark::kMillisecond);
+}
+
+template <typename Map> static void BM_MapInsert(benchmark::State &state) {
+  std::vector<SimdUuid> uuids = GenerateUuids(state.range(0));
+  for (auto _ : state) {
+    Map map;
+    for (const SimdUuid &uuid : uuids) {
+      map.try_emplace(uuid, 0);
+    }
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MapInsert<StdMap>)->Apply(MapSizes);
+BENCHMARK(BM_MapInsert<FlatMap>)->Apply(MapSizes);
+
+// Looks up `count` keys of the map, in random order.
+template <typename Map> static void BM_MapFindHit(benchmark::State &state) {
+  std::vector<SimdUuid> uuids = GenerateUuids(state.range(0));
+  Map map;
+  for (const SimdUuid &uuid : uuids) {
+    map.try_emplace(uuid, 0);
+  }
+  for (auto _ : state) {
+    for (const SimdUuid &uuid : uuids) {
+      benchmark::DoNotOptimize(map.find(uuid));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MapFindHit<StdMap>)->Apply(MapSizes);
+BENCHMARK(BM_MapFindHit<FlatMap>)->Apply(MapSizes);
+
+// Looks up `count` keys that are not in the map.
+template <typename Map> static void BM_MapFindMiss(benchmark::State &state) {
+  std::vector<SimdUuid> uuids = GenerateUuids(state.range(0));
+  Map map;
+  for (const SimdUuid &uuid : uuids) {
+    map.try_emplace(uuid, 0);
+  }
+  std::vector<SimdUuid> misses = GenerateUuids(state.range(0));
+  for (auto _ : state) {
+    for (const SimdUuid &uuid : misses) {
+      benchmark::DoNotOptimize(map.find(uuid));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MapFindMiss<StdMap>)->Apply(MapSizes);
+BENCHMARK(BM_MapFindMiss<FlatMap>)->Apply(MapSizes);
+
+// Erases all the keys of the map. Building the map is not measured.
+template <typename Map> static void BM_MapErase(benchmark::State &state) {
+  std::vector<SimdUuid> uuids = GenerateUuids(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Map map;
+    for (const SimdUuid &uuid : uuids) {
+      map.try_emplace(uuid, 0);
+    }
+    state.ResumeTiming();
+    for (const SimdUuid &uuid : uuids) {
+      map.erase(uuid);
+    }
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MapErase<StdMap>)->Apply(MapSizes);
+BENCHMARK(BM_MapErase<FlatMap>)->Apply(MapSizes);
+
+} // namespace andyccs
+
+BENCHMARK_MAIN();
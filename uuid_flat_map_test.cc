@@ -0,0 +1,245 @@
+#include "uuid_flat_map.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace andyccs {
+
+std::vector<SimdUuid> GenerateUuids(std::size_t count) {
+  SimdUuidGenerator<std::mt19937_64> generator;
+  std::vector<SimdUuid> uuids;
+  for (std::size_t i = 0; i < count; ++i) {
+    uuids.push_back(generator.GenerateUuid());
+  }
+  return uuids;
+}
+
+// Sends every key to the same group, to exercise long probe sequences.
+struct ConstantHash {
+  std::size_t operator()(const SimdUuid &) const { return 42; }
+};
+
+TEST(UuidFlatMap, Empty) {
+  UuidFlatMap<int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.size(), 0u);
+  EXPECT_EQ(map.capacity(), 0u);
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.find(SimdUuid()), map.end());
+  EXPECT_FALSE(map.contains(SimdUuid()));
+  EXPECT_EQ(map.erase(SimdUuid()), 0u);
+}
+
+TEST(UuidFlatMap, InsertFind) {
+  UuidFlatMap<std::string> map;
+  SimdUuid uuid = SimdUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF);
+  auto [it, inserted] = map.insert({uuid, "Hello World"});
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(it->first, uuid);
+  EXPECT_EQ(it->second, "Hello World");
+
+  auto [it_2, inserted_2] = map.insert({uuid, "Bye"});
+  EXPECT_FALSE(inserted_2);
+  EXPECT_EQ(it_2, it);
+  EXPECT_EQ(it_2->second, "Hello World");
+
+  EXPECT_EQ(map.size(), 1u);
+  EXPECT_EQ(map.find(uuid)->second, "Hello World");
+  EXPECT_EQ(map.at(uuid), "Hello World");
+  EXPECT_EQ(map.count(uuid), 1u);
+  EXPECT_FALSE(map.contains(SimdUuid()));
+  EXPECT_THROW(map.at(SimdUuid()), std::out_of_range);
+}
+
+TEST(UuidFlatMap, Subscript) {
+  UuidFlatMap<int> map;
+  SimdUuid uuid = SimdUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF);
+  EXPECT_EQ(map[uuid], 0);
+  map[uuid] += 5;
+  map[uuid] += 5;
+  EXPECT_EQ(map[uuid], 10);
+  EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(UuidFlatMap, TryEmplaceMoveOnly) {
+  UuidFlatMap<std::unique_ptr<int>> map;
+  SimdUuid uuid = SimdUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF);
+  EXPECT_TRUE(map.try_emplace(uuid, std::make_unique<int>(42)).second);
+  EXPECT_FALSE(map.try_emplace(uuid, std::make_unique<int>(0)).second);
+  EXPECT_EQ(*map.at(uuid), 42);
+}
+
+TEST(UuidFlatMap, Erase) {
+  UuidFlatMap<int> map;
+  SimdUuid uuid_1 = SimdUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF);
+  SimdUuid uuid_2 = SimdUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFE);
+  map[uuid_1] = 1;
+  map[uuid_2] = 2;
+  EXPECT_EQ(map.erase(uuid_1), 1u);
+  EXPECT_EQ(map.erase(uuid_1), 0u);
+  EXPECT_EQ(map.size(), 1u);
+  EXPECT_FALSE(map.contains(uuid_1));
+  EXPECT_EQ(map.at(uuid_2), 2);
+
+  map.erase(map.find(uuid_2));
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(UuidFlatMap, Grow) {
+  std::vector<SimdUuid> uuids = GenerateUuids(10000);
+  UuidFlatMap<std::size_t> map;
+  for (std::size_t i = 0; i < uuids.size(); ++i) {
+    map[uuids[i]] = i;
+  }
+  EXPECT_EQ(map.size(), uuids.size());
+  EXPECT_GE(map.capacity() * 7 / 8, map.size());
+  for (std::size_t i = 0; i < uuids.size(); ++i) {
+    ASSERT_EQ(map.at(uuids[i]), i);
+  }
+}
+
+TEST(UuidFlatMap, Reserve) {
+  std::vector<SimdUuid> uuids = GenerateUuids(1000);
+  UuidFlatMap<int> map;
+  map.reserve(uuids.size());
+  std::size_t capacity = map.capacity();
+  for (const SimdUuid &uuid : uuids) {
+    map[uuid] = 0;
+  }
+  EXPECT_EQ(map.capacity(), capacity);
+}
+
+TEST(UuidFlatMap, Iterate) {
+  std::vector<SimdUuid> uuids = GenerateUuids(1000);
+  UuidFlatMap<int> map;
+  for (const SimdUuid &uuid : uuids) {
+    map[uuid] = 1;
+  }
+  std::size_t count = 0;
+  for (auto &[uuid, value] : map) {
+    EXPECT_EQ(value, 1);
+    value = 2;
+    ++count;
+  }
+  EXPECT_EQ(count, uuids.size());
+
+  const UuidFlatMap<int> &const_map = map;
+  for (const auto &[uuid, value] : const_map) {
+    EXPECT_EQ(value, 2);
+  }
+}
+
+TEST(UuidFlatMap, EraseInsertCycles) {
+  // Tombstones are reclaimed, so a map with a stable size does not keep
+  // growing.
+  std::vector<SimdUuid> uuids = GenerateUuids(100000);
+  UuidFlatMap<int> map;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    map[uuids[i]] = 0;
+  }
+  std::size_t capacity = map.capacity();
+  for (std::size_t i = 1000; i < uuids.size(); ++i) {
+    map[uuids[i]] = 0;
+    ASSERT_EQ(map.erase(uuids[i - 1000]), 1u);
+  }
+  EXPECT_EQ(map.size(), 1000u);
+  EXPECT_LE(map.capacity(), capacity * 2);
+  for (std::size_t i = uuids.size() - 1000; i < uuids.size(); ++i) {
+    ASSERT_TRUE(map.contains(uuids[i]));
+  }
+}
+
+TEST(UuidFlatMap, Collisions) {
+  std::vector<SimdUuid> uuids = GenerateUuids(100);
+  UuidFlatMap<std::size_t, ConstantHash> map;
+  for (std::size_t i = 0; i < uuids.size(); ++i) {
+    map[uuids[i]] = i;
+  }
+  for (std::size_t i = 0; i < uuids.size(); i += 2) {
+    map.erase(uuids[i]);
+  }
+  for (std::size_t i = 0; i < uuids.size(); ++i) {
+    EXPECT_EQ(map.contains(uuids[i]), i % 2 == 1);
+  }
+}
+
+TEST(UuidFlatMap, CopyMove) {
+  std::vector<SimdUuid> uuids = GenerateUuids(100);
+  UuidFlatMap<std::string> map;
+  for (const SimdUuid &uuid : uuids) {
+    map[uuid] = std::string(uuid);
+  }
+
+  UuidFlatMap<std::string> copy = map;
+  EXPECT_EQ(copy.size(), map.size());
+  for (const SimdUuid &uuid : uuids) {
+    EXPECT_EQ(copy.at(uuid), std::string(uuid));
+  }
+
+  UuidFlatMap<std::string> moved = std::move(map);
+  EXPECT_EQ(moved.size(), uuids.size());
+  EXPECT_TRUE(map.empty());
+
+  copy.clear();
+  EXPECT_TRUE(copy.empty());
+  EXPECT_FALSE(copy.contains(uuids[0]));
+  copy = moved;
+  EXPECT_EQ(copy.at(uuids[0]), std::string(uuids[0]));
+}
+
+TEST(UuidFlatMap, SameAsUnorderedMap) {
+  std::vector<SimdUuid> uuids = GenerateUuids(2000);
+  std::mt19937 random(42);
+  UuidFlatMap<int> map;
+  std::unordered_map<SimdUuid, int> expected;
+  for (int i = 0; i < 100000; ++i) {
+    const SimdUuid &uuid = uuids[random() % uuids.size()];
+    switch (random() % 3) {
+    case 0:
+      map[uuid] = i;
+      expected[uuid] = i;
+      break;
+    case 1:
+      ASSERT_EQ(map.erase(uuid), expected.erase(uuid));
+      break;
+    case 2:
+      ASSERT_EQ(map.contains(uuid), expected.contains(uuid));
+      break;
+    }
+  }
+  ASSERT_EQ(map.size(), expected.size());
+  for (const auto &[uuid, value] : map) {
+    EXPECT_EQ(expected.at(uuid), value);
+  }
+}
+
+TEST(UuidFlatSet, InsertFindErase) {
+  std::vector<SimdUuid> uuids = GenerateUuids(1000);
+  UuidFlatSet<> set;
+  for (const SimdUuid &uuid : uuids) {
+    EXPECT_TRUE(set.insert(uuid).second);
+    EXPECT_FALSE(set.insert(uuid).second);
+  }
+  EXPECT_EQ(set.size(), uuids.size());
+  for (const SimdUuid &uuid : uuids) {
+    EXPECT_EQ(*set.find(uuid), uuid);
+  }
+  std::size_t count = 0;
+  for (const SimdUuid &uuid : set) {
+    EXPECT_TRUE(set.contains(uuid));
+    ++count;
+  }
+  EXPECT_EQ(count, uuids.size());
+
+  for (const SimdUuid &uuid : uuids) {
+    EXPECT_EQ(set.erase(uuid), 1u);
+  }
+  EXPECT_TRUE(set.empty());
+}
+
+} // namespace andyccs
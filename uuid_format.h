@@ -0,0 +1,252 @@
+#ifndef ANDYCCS_UUID_FORMAT_H
+#define ANDYCCS_UUID_FORMAT_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace andyccs {
+
+// Text layouts of a UUID.
+enum class UuidLayout {
+  // 6BBBB416-EDC3-405F-A86D-231D5800235E
+  kHyphenated,
+  // 6BBBB416EDC3405FA86D231D5800235E
+  kCompact,
+  // {6BBBB416-EDC3-405F-A86D-231D5800235E}
+  kBraced,
+  // urn:uuid:6BBBB416-EDC3-405F-A86D-231D5800235E
+  kUrn,
+};
+
+// Text format of a UUID: a layout, and the case of the hex digits.
+//
+// Formats are template arguments, e.g. uuid.ToString<kUuidLowercase>(result),
+// so that every format is compiled to its own kernel, and choosing a format
+// costs no branch at runtime.
+struct UuidFormat {
+  UuidLayout layout = UuidLayout::kHyphenated;
+  bool lowercase = false;
+
+  // Returns the number of characters of a UUID in this format.
+  constexpr std::size_t size() const {
+    return prefix().size() + (dashes() ? 36 : 32) + suffix().size();
+  }
+
+  // Returns true if the hex digits are grouped 8-4-4-4-12 by dashes.
+  constexpr bool dashes() const { return layout != UuidLayout::kCompact; }
+
+  // Returns the characters before the hex digits.
+  constexpr std::string_view prefix() const {
+    switch (layout) {
+    case UuidLayout::kBraced:
+      return "{";
+    case UuidLayout::kUrn:
+      return "urn:uuid:";
+    default:
+      return "";
+    }
+  }
+
+  // Returns the characters after the hex digits.
+  constexpr std::string_view suffix() const {
+    return layout == UuidLayout::kBraced ? "}" : "";
+  }
+
+  // Returns a number below kUuidFormatCount, different for every format.
+  constexpr std::size_t index() const {
+    return static_cast<std::size_t>(layout) * 2 + lowercase;
+  }
+};
+
+inline constexpr std::size_t kUuidFormatCount = 8;
+
+// Returns the format whose index() is `index`.
+constexpr UuidFormat UuidFormatAt(std::size_t index) {
+  return {static_cast<UuidLayout>(index / 2), index % 2 == 1};
+}
+
+// The format of operator std::string.
+inline constexpr UuidFormat kUuidUppercase = {};
+
+// The canonical format of RFC 9562.
+inline constexpr UuidFormat kUuidLowercase = {.lowercase = true};
+
+inline constexpr UuidFormat kUuidCompact = {.layout = UuidLayout::kCompact};
+
+inline constexpr UuidFormat kUuidBraced = {.layout = UuidLayout::kBraced};
+
+// Lowercase, like the URNs of RFC 9562.
+inline constexpr UuidFormat kUuidUrn = {.layout = UuidLayout::kUrn,
+                                        .lowercase = true};
+
+// A UUID string of at most 45 characters, the size of kUuidUrn, followed by a
+// null character, stored in the object itself. It is what
+// BasicUuid::ToString() and SimdUuid::ToString() return, so that formatting a
+// UUID does not allocate: 36 characters do not fit in the small string buffer
+// of std::string, which is 15 characters in libstdc++ and 22 in libc++.
+class UuidString {
+public:
+  static constexpr std::size_t kCapacity = kUuidUrn.size();
+
+  // An empty string.
+  constexpr UuidString() { data_[0] = '\0'; }
+
+  constexpr const char *data() const { return data_; }
+  constexpr const char *c_str() const { return data_; }
+  constexpr std::size_t size() const { return size_; }
+  constexpr bool empty() const { return size_ == 0; }
+
+  constexpr const char *begin() const { return data_; }
+  constexpr const char *end() const { return data_ + size_; }
+  constexpr char operator[](std::size_t index) const { return data_[index]; }
+
+  constexpr operator std::string_view() const { return {data_, size_}; }
+
+  // Allocates, as std::string does for every UUID string.
+  explicit operator std::string() const { return std::string(data_, size_); }
+
+  friend constexpr bool operator==(const UuidString &string,
+                                   std::string_view other) {
+    return std::string_view(string) == other;
+  }
+
+  // The stream operator of std::string_view is a template, which does not
+  // consider the conversion above.
+  friend std::ostream &operator<<(std::ostream &out,
+                                  const UuidString &string) {
+    return out << std::string_view(string);
+  }
+
+private:
+  friend class BasicUuid;
+  friend class SimdUuid;
+
+  // A string of `size` characters, which the UUID classes write to `data_`.
+  explicit constexpr UuidString(std::size_t size)
+      : size_(static_cast<std::uint8_t>(size)) {
+    data_[size] = '\0';
+  }
+
+  char data_[kCapacity + 1];
+  std::uint8_t size_ = 0;
+};
+
+namespace internal {
+
+// Writes the prefix and the suffix of `Format`, for the UUID string starting
+// at `out`. The hex digits in between are left as they are.
+template <UuidFormat Format> inline void WriteAffixes(char *out) {
+  constexpr std::string_view kPrefix = Format.prefix();
+  constexpr std::string_view kSuffix = Format.suffix();
+  std::copy(kPrefix.begin(), kPrefix.end(), out);
+  std::copy(kSuffix.begin(), kSuffix.end(),
+            out + Format.size() - kSuffix.size());
+}
+
+// The two hex digits of every byte.
+template <bool kLowercase> struct HexPairs {
+  char pair[256][2];
+
+  constexpr HexPairs() : pair{} {
+    constexpr const char *kHexMap =
+        kLowercase ? "0123456789abcdef" : "0123456789ABCDEF";
+    for (int i = 0; i < 256; ++i) {
+      pair[i][0] = kHexMap[i >> 4];
+      pair[i][1] = kHexMap[i & 0x0F];
+    }
+  }
+};
+
+template <bool kLowercase>
+inline constexpr HexPairs<kLowercase> kHexPairs;
+
+// Writes the UUID at `data` to `out` in `Format`, two hex digits at a time.
+// Portable version of the SimdUuid kernels, also used by BasicUuid.
+template <UuidFormat Format>
+inline void FormatUuid(const std::uint8_t *data, char *out) {
+  WriteAffixes<Format>(out);
+  out += Format.prefix().size();
+  for (std::size_t i = 0; i < 16; ++i) {
+    std::memcpy(out, kHexPairs<Format.lowercase>.pair[data[i]], 2);
+    out += 2;
+    if (Format.dashes() && (i == 3 || i == 5 || i == 7 || i == 9)) {
+      *out++ = '-';
+    }
+  }
+}
+
+// Returns the value of the hex digit `c`, in any case, or -1.
+constexpr int HexDigitValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  return -1;
+}
+
+// Parses any of the layouts of SimdUuid::Parse, with hex digits and the
+// "urn:uuid:" prefix in any case. Slower than the SimdUuid kernels, but usable
+// in constant expressions, for the _uuid literals.
+constexpr std::optional<std::array<std::uint8_t, 16>>
+ParseUuidConstexpr(std::string_view from) {
+  UuidFormat format;
+  switch (from.size()) {
+  case 36:
+    break;
+  case 32:
+    format.layout = UuidLayout::kCompact;
+    break;
+  case 38:
+    format.layout = UuidLayout::kBraced;
+    break;
+  case 45:
+    format.layout = UuidLayout::kUrn;
+    break;
+  default:
+    return std::nullopt;
+  }
+  for (std::size_t i = 0; i < format.prefix().size(); ++i) {
+    const char c = from[i] >= 'A' && from[i] <= 'Z' ? from[i] + 'a' - 'A'
+                                                    : from[i];
+    if (c != format.prefix()[i]) {
+      return std::nullopt;
+    }
+  }
+  if (format.suffix() != from.substr(from.size() - format.suffix().size())) {
+    return std::nullopt;
+  }
+
+  std::array<std::uint8_t, 16> data = {};
+  std::size_t in = format.prefix().size();
+  for (std::size_t i = 0; i < 16; ++i) {
+    if (format.dashes() && (i == 4 || i == 6 || i == 8 || i == 10)) {
+      if (from[in++] != '-') {
+        return std::nullopt;
+      }
+    }
+    const int high = HexDigitValue(from[in++]);
+    const int low = HexDigitValue(from[in++]);
+    if (high < 0 || low < 0) {
+      return std::nullopt;
+    }
+    data[i] = high << 4 | low;
+  }
+  return data;
+}
+
+} // namespace internal
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_FORMAT_H
@@ -5,18 +5,14 @@
 #define ANDYCCS_IS_64_BITS
 #endif
 
-#if __AVX2__
-#define ANDYCCS_HAS_AVX2
-#endif
-
-#include <mutex>
+#include <array>
 #include <random>
+#include <span>
+#include <type_traits>
 #include <variant>
 
 #include "uuid_basic.h"
-#ifdef ANDYCCS_HAS_AVX2
 #include "uuid_simd.h"
-#endif // __AVX2__
 
 namespace andyccs {
 
@@ -28,21 +24,20 @@ using DefaultRNG =
 #endif
     ;
 
-using Uuid =
-#ifdef ANDYCCS_HAS_AVX2
-    SimdUuid
-#else
-    BasicUuid
-#endif
-    ;
+// SimdUuid picks the fastest kernels for the running CPU, and falls back to
+// portable code on CPUs without SIMD support.
+using Uuid = SimdUuid;
 
+// Generates random UuidT, using RNG.
+//
+// When ThreadSafe is true, GenerateUuid can be called from many threads at
+// once. Every thread then uses its own RNG, seeded on its first call, so
+// threads never wait for each other. These RNGs are shared by all the
+// thread-safe UuidGenerator with the same template arguments.
 template <class RNG = DefaultRNG, class UuidT = Uuid, bool ThreadSafe = true>
 class UuidGenerator {
 public:
-  UuidGenerator()
-      : generator_(RNG(std::random_device()())),
-        distribution_(std::numeric_limits<uint64_t>::min(),
-                      std::numeric_limits<uint64_t>::max()) {}
+  UuidGenerator() = default;
 
   // Copyable. Only available when ThreadSafe is false.
   UuidGenerator(const UuidGenerator &other)
@@ -62,24 +57,51 @@ public:
 
   UuidT GenerateUuid() {
     if constexpr (ThreadSafe) {
-      std::lock_guard<std::mutex> lock(mutex_);
+      return ThreadLocalState().GenerateUuid();
+    } else {
+      return state_.GenerateUuid();
+    }
+  }
+
+  // Fills `uuids` with new UUIDs in one pass, using a vectorized RNG seeded
+  // from RNG, see Xoshiro256StarStarX8. This is several times faster than
+  // calling GenerateUuid for each of them when there are more than a few dozen.
+  void GenerateUuids(std::span<UuidT> uuids) {
+    if constexpr (ThreadSafe) {
+      State &state = ThreadLocalState();
+      internal::GenerateUuids(uuids, state.generator, state.distribution);
+    } else {
+      internal::GenerateUuids(uuids, state_.generator, state_.distribution);
     }
-    std::array<uint8_t, 16> data;
-    *reinterpret_cast<uint64_t *>(data.data()) = distribution_(generator_);
-    *reinterpret_cast<uint64_t *>(data.data() + 8) = distribution_(generator_);
-    return UuidT(data);
   }
 
 private:
-  RNG generator_;
-  std::uniform_int_distribution<uint64_t> distribution_;
-
-  // Conditional creation.
-  // The size of UuidGenerator is 2520 bytes without this field.
-  // With this field, the size of UuidGenerator is 2528 bytes when ThreadSafe is
-  // false. If ThreadSafe is true, it requires an additional 32 bytes, making
-  // the total size 2560 bytes.
-  std::conditional_t<ThreadSafe, std::mutex, std::monostate> mutex_;
+  struct State {
+    State() : generator(internal::SeedRandomEngine<RNG>()) {}
+
+    UuidT GenerateUuid() {
+      std::array<uint8_t, 16> data;
+      *reinterpret_cast<uint64_t *>(data.data()) = distribution(generator);
+      *reinterpret_cast<uint64_t *>(data.data() + 8) = distribution(generator);
+      return UuidT(data);
+    }
+
+    RNG generator;
+    [[no_unique_address]] internal::Uniform64<RNG> distribution;
+  };
+
+  // Every thread has its own State in its thread-local storage, which is
+  // allocated per thread, so States of different threads do not share cache
+  // lines either.
+  static State &ThreadLocalState() {
+    thread_local State state;
+    return state;
+  }
+
+  // Conditional creation. When ThreadSafe is true, the state lives in
+  // ThreadLocalState() instead, and UuidGenerator is empty.
+  [[no_unique_address]] std::conditional_t<ThreadSafe, std::monostate, State>
+      state_;
 };
 
 } // namespace andyccs
@@ -0,0 +1,163 @@
+#include "uuid_generator.h"
+
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
+
+namespace andyccs {
+
+// A thread-safe generator that shares one RNG behind a mutex, as UuidGenerator
+// used to do, to compare with the thread-local RNGs of UuidGenerator.
+class MutexUuidGenerator {
+public:
+  MutexUuidGenerator()
+      : generator_(std::random_device()()),
+        distribution_(std::numeric_limits<uint64_t>::min(),
+                      std::numeric_limits<uint64_t>::max()) {}
+
+  Uuid GenerateUuid() {
+    std::array<uint8_t, 16> data;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      *reinterpret_cast<uint64_t *>(data.data()) = distribution_(generator_);
+      *reinterpret_cast<uint64_t *>(data.data() + 8) =
+          distribution_(generator_);
+    }
+    return Uuid(data);
+  }
+
+private:
+  std::mutex mutex_;
+  DefaultRNG generator_;
+  std::uniform_int_distribution<uint64_t> distribution_;
+};
+
+// Shared by all the benchmark threads.
+template <typename Generator> Generator &SharedGenerator() {
+  static Generator generator;
+  return generator;
+}
+
+template <typename Generator>
+static void BM_GenerateUuid(benchmark::State &state) {
+  Generator &generator = SharedGenerator<Generator>();
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(generator.GenerateUuid());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GenerateUuid<MutexUuidGenerator>)
+    ->Range(1 << 8, 1 << 8)
+    ->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->UseRealTime();
+BENCHMARK(BM_GenerateUuid<UuidGenerator<DefaultRNG, Uuid, true>>)
+    ->Range(1 << 8, 1 << 8)
+    ->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->UseRealTime();
+BENCHMARK(BM_GenerateUuid<UuidGenerator<DefaultRNG, Uuid, false>>)
+    ->Range(1 << 8, 1 << 8)
+    ->UseRealTime();
+
+// Generates `count` UUIDs one by one, for comparison with GenerateUuids.
+static void BM_GenerateUuidLoop(benchmark::State &state) {
+  UuidGenerator<DefaultRNG, Uuid, false> generator;
+  std::vector<Uuid> uuids(state.range(0));
+  for (auto _ : state) {
+    for (Uuid &uuid : uuids) {
+      uuid = generator.GenerateUuid();
+    }
+    benchmark::DoNotOptimize(uuids.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GenerateUuidLoop)->RangeMultiplier(8)->Range(8, 1 << 18);
+
+static void BM_GenerateUuids(benchmark::State &state) {
+  UuidGenerator<DefaultRNG, Uuid, false> generator;
+  std::vector<Uuid> uuids(state.range(0));
+  for (auto _ : state) {
+    generator.GenerateUuids(uuids);
+    benchmark::DoNotOptimize(uuids.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GenerateUuids)->RangeMultiplier(8)->Range(8, 1 << 18);
+
+static void BM_Xoshiro256StarStarX8Fill(benchmark::State &state) {
+  Xoshiro256StarStarX8 random(std::random_device{}());
+  std::vector<std::uint64_t> words(state.range(0));
+  for (auto _ : state) {
+    random.Fill(words);
+    benchmark::DoNotOptimize(words.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 8);
+}
+BENCHMARK(BM_Xoshiro256StarStarX8Fill)->Range(1 << 10, 1 << 10);
+
+// Cost per UUID of every RNG backend. The "bytes" counter is the size of the
+// generator.
+template <typename RNG> static void BM_GenerateUuidRng(benchmark::State &state) {
+  UuidGenerator<RNG, Uuid, false> generator;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(generator.GenerateUuid());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["bytes"] = sizeof(generator);
+}
+BENCHMARK(BM_GenerateUuidRng<std::mt19937>)->Range(1 << 8, 1 << 8);
+BENCHMARK(BM_GenerateUuidRng<std::mt19937_64>)->Range(1 << 8, 1 << 8);
+BENCHMARK(BM_GenerateUuidRng<Xoshiro256StarStar>)->Range(1 << 8, 1 << 8);
+BENCHMARK(BM_GenerateUuidRng<WyRand>)->Range(1 << 8, 1 << 8);
+#if defined(__SIZEOF_INT128__)
+BENCHMARK(BM_GenerateUuidRng<Pcg64>)->Range(1 << 8, 1 << 8);
+#endif
+
+BENCHMARK(BM_GenerateUuidRng<SecureRandom>)->Range(1 << 8, 1 << 8);
+
+#if defined(__linux__)
+// One getrandom call per UUID, for comparison with the buffer of SecureRandom.
+static void BM_GenerateUuidGetrandom(benchmark::State &state) {
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      std::array<std::uint8_t, 16> data;
+      if (getrandom(data.data(), data.size(), 0) != 16) {
+        state.SkipWithError("getrandom failed");
+      }
+      benchmark::DoNotOptimize(Uuid(data));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GenerateUuidGetrandom)->Range(1 << 8, 1 << 8);
+#endif
+
+// Cost of creating a generator, e.g. one per coroutine.
+template <typename RNG> static void BM_CreateGenerator(benchmark::State &state) {
+  for (auto _ : state) {
+    UuidGenerator<RNG, Uuid, false> generator;
+    benchmark::DoNotOptimize(generator);
+  }
+}
+BENCHMARK(BM_CreateGenerator<std::mt19937_64>);
+BENCHMARK(BM_CreateGenerator<Xoshiro256StarStar>);
+BENCHMARK(BM_CreateGenerator<WyRand>);
+#if defined(__SIZEOF_INT128__)
+BENCHMARK(BM_CreateGenerator<Pcg64>);
+#endif
+
+} // namespace andyccs
+
+BENCHMARK_MAIN();
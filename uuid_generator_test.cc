@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 #include <random>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 
 #include "uuid_basic.h"
 #include "uuid_simd.h"
@@ -96,4 +99,59 @@ TEST(UuidGenerator, GenerateSimdUUIDUsingMt199937_64ThreadSafe) {
   EXPECT_NE(uuid, SimdUuid());
 }
 
+TEST(UuidGenerator, ThreadSafeIsEmpty) {
+  // The state of thread-safe generators lives in thread-local storage.
+  EXPECT_EQ(sizeof(UuidGenerator<std::mt19937_64, SimdUuid, true>), 1u);
+}
+
+TEST(UuidGenerator, ThreadSafeManyThreads) {
+  constexpr int kThreads = 8;
+  constexpr int kUuidsPerThread = 10000;
+  UuidGenerator<std::mt19937_64, SimdUuid, true> generator;
+  std::vector<std::vector<SimdUuid>> uuids(kThreads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&generator, &uuids, i] {
+      for (int j = 0; j < kUuidsPerThread; ++j) {
+        uuids[i].push_back(generator.GenerateUuid());
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  // Threads are seeded independently, so no UUID shows up twice.
+  std::unordered_set<SimdUuid> unique;
+  for (const std::vector<SimdUuid> &thread_uuids : uuids) {
+    unique.insert(thread_uuids.begin(), thread_uuids.end());
+  }
+  EXPECT_EQ(unique.size(), kThreads * kUuidsPerThread);
+}
+
+TEST(UuidGenerator, GenerateUuids) {
+  UuidGenerator<std::mt19937_64, SimdUuid, false> generator;
+  std::vector<SimdUuid> uuids(1000);
+  generator.GenerateUuids(uuids);
+  std::unordered_set<SimdUuid> unique(uuids.begin(), uuids.end());
+  EXPECT_EQ(unique.size(), uuids.size());
+}
+
+TEST(UuidGenerator, GenerateUuidsThreadSafe) {
+  UuidGenerator<std::mt19937_64, BasicUuid, true> generator;
+  std::vector<BasicUuid> uuids(1000);
+  generator.GenerateUuids(uuids);
+  std::unordered_set<BasicUuid> unique(uuids.begin(), uuids.end());
+  EXPECT_EQ(unique.size(), uuids.size());
+}
+
+TEST(UuidGenerator, SecureRandom) {
+  UuidGenerator<SecureRandom, SimdUuid, true> generator;
+  std::vector<SimdUuid> uuids(1000);
+  generator.GenerateUuids(uuids);
+  uuids.push_back(generator.GenerateUuid());
+  std::unordered_set<SimdUuid> unique(uuids.begin(), uuids.end());
+  EXPECT_EQ(unique.size(), uuids.size());
+}
+
 } // namespace andyccs
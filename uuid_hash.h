@@ -0,0 +1,103 @@
+#ifndef ANDYCCS_UUID_HASH_H
+#define ANDYCCS_UUID_HASH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+namespace andyccs {
+
+namespace internal {
+
+// Multiplies two 64-bits unsigned ints and folds the 128-bits product into 64
+// bits. Every bit of the result depends on every bit of both inputs.
+inline std::uint64_t MultiplyFold(std::uint64_t a, std::uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t product = static_cast<__uint128_t>(a) * b;
+  return static_cast<std::uint64_t>(product) ^
+         static_cast<std::uint64_t>(product >> 64);
+#else
+  // Portable 64 x 64 -> 128 bits multiplication.
+  std::uint64_t a_low = a & 0xFFFFFFFF, a_high = a >> 32;
+  std::uint64_t b_low = b & 0xFFFFFFFF, b_high = b >> 32;
+  std::uint64_t low_low = a_low * b_low;
+  std::uint64_t high_low = a_high * b_low;
+  std::uint64_t low_high = a_low * b_high;
+  std::uint64_t high_high = a_high * b_high;
+  std::uint64_t cross =
+      (low_low >> 32) + (high_low & 0xFFFFFFFF) + low_high;
+  std::uint64_t low = (cross << 32) | (low_low & 0xFFFFFFFF);
+  std::uint64_t high = high_high + (high_low >> 32) + (cross >> 32);
+  return low ^ high;
+#endif
+}
+
+} // namespace internal
+
+// Hashes the 16 bytes of a UUID without formatting it.
+//
+// Random UUIDs are already uniformly distributed, but UUIDs with a timestamp or
+// a counter are not, and hash tables often only look at the lowest bits of the
+// hash. Both 64-bits halves are therefore mixed with a single 64 x 64 -> 128
+// bits multiplication, so that changing any bit of the UUID changes about half
+// of the bits of the hash.
+//
+// With the default seed, the hash is the same on every run, which makes it easy
+// to build a sequence of keys that all land in the same bucket. Tables that
+// store untrusted UUIDs should use a random seed, see SeededUuidHash.
+inline std::size_t HashUuid(const std::array<std::uint8_t, 16> &data,
+                            std::uint64_t seed = 0) {
+  // Arbitrary odd constants with about half of their bits set.
+  constexpr std::uint64_t kSecret0 = 0xA0761D6478BD642F;
+  constexpr std::uint64_t kSecret1 = 0xE7037ED1A0B428DB;
+
+  std::uint64_t high;
+  std::uint64_t low;
+  std::memcpy(&high, data.data(), 8);
+  std::memcpy(&low, data.data() + 8, 8);
+  // The seed goes into both factors: a factor of 0 makes the product 0
+  // whatever the other half is, so the halves that do so must depend on the
+  // seed, or they would collide under every seed.
+  std::uint64_t mixed = internal::MultiplyFold(high ^ seed ^ kSecret0,
+                                               low ^ seed ^ kSecret1);
+  // A second round, so that UUIDs that only differ in a few bits do not end up
+  // with hashes that only differ in a few bits either.
+  return static_cast<std::size_t>(
+      internal::MultiplyFold(mixed ^ seed ^ kSecret1, kSecret0));
+}
+
+// Hash function object for BasicUuid and SimdUuid with a random seed, picked
+// when the object is created. Use it instead of std::hash for hash tables that
+// store UUIDs coming from untrusted sources, e.g.
+//
+// std::unordered_map<Uuid, Session, SeededUuidHash<Uuid>> sessions;
+//
+// Two SeededUuidHash objects hash the same UUID differently, unless one is a
+// copy of the other.
+template <typename UuidT> class SeededUuidHash {
+public:
+  SeededUuidHash() : seed_(RandomSeed()) {}
+
+  explicit SeededUuidHash(std::uint64_t seed) : seed_(seed) {}
+
+  std::size_t operator()(const UuidT &uuid) const noexcept {
+    return uuid.hash(seed_);
+  }
+
+  std::uint64_t seed() const { return seed_; }
+
+private:
+  static std::uint64_t RandomSeed() {
+    std::random_device random_device;
+    return (static_cast<std::uint64_t>(random_device()) << 32) ^
+           random_device();
+  }
+
+  std::uint64_t seed_;
+};
+
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_HASH_H
@@ -0,0 +1,101 @@
+#include "uuid_hash.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "uuid_basic.h"
+#include "uuid_benchmark_utils.h"
+#include "uuid_simd.h"
+
+namespace andyccs {
+
+// The hash that BasicUuid used to have: format the UUID, then hash the string.
+template <typename UuidT> struct StringUuidHash {
+  std::size_t operator()(const UuidT &uuid) const {
+    return std::hash<std::string>()(std::string(uuid));
+  }
+};
+
+template <typename UuidT> static std::vector<UuidT> GenerateUuids(int count) {
+  std::vector<UuidT> uuids;
+  uuids.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    std::array<std::uint8_t, 16> data;
+    GenerateRandomData(data);
+    uuids.push_back(UuidT(data));
+  }
+  return uuids;
+}
+
+template <typename UuidT, typename Hash>
+static void BM_UuidHash(benchmark::State &state) {
+  std::vector<UuidT> uuids = GenerateUuids<UuidT>(state.range(0));
+  Hash hash;
+  for (auto _ : state) {
+    for (const UuidT &uuid : uuids) {
+      benchmark::DoNotOptimize(hash(uuid));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_UuidHash<BasicUuid, StringUuidHash<BasicUuid>>)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK(BM_UuidHash<BasicUuid, std::hash<BasicUuid>>)->Range(1 << 8, 1 << 8);
+BENCHMARK(BM_UuidHash<SimdUuid, StringUuidHash<SimdUuid>>)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK(BM_UuidHash<SimdUuid, std::hash<SimdUuid>>)->Range(1 << 8, 1 << 8);
+BENCHMARK(BM_UuidHash<SimdUuid, SeededUuidHash<SimdUuid>>)
+    ->Range(1 << 8, 1 << 8);
+
+template <typename UuidT, typename Hash>
+static void BM_UnorderedMapInsert(benchmark::State &state) {
+  std::vector<UuidT> uuids = GenerateUuids<UuidT>(state.range(0));
+  for (auto _ : state) {
+    std::unordered_map<UuidT, int, Hash> map;
+    map.reserve(uuids.size());
+    for (const UuidT &uuid : uuids) {
+      map.emplace(uuid, 0);
+    }
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_UnorderedMapInsert<SimdUuid, StringUuidHash<SimdUuid>>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 16);
+BENCHMARK(BM_UnorderedMapInsert<SimdUuid, std::hash<SimdUuid>>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 16);
+
+template <typename UuidT, typename Hash>
+static void BM_UnorderedMapLookup(benchmark::State &state) {
+  std::vector<UuidT> uuids = GenerateUuids<UuidT>(state.range(0));
+  std::unordered_map<UuidT, int, Hash> map;
+  for (const UuidT &uuid : uuids) {
+    map.emplace(uuid, 0);
+  }
+  // Half of the lookups miss.
+  std::vector<UuidT> keys = GenerateUuids<UuidT>(state.range(0));
+  for (std::size_t i = 0; i < keys.size(); i += 2) {
+    keys[i] = uuids[(i * 7919) % uuids.size()];
+  }
+
+  for (auto _ : state) {
+    for (const UuidT &key : keys) {
+      benchmark::DoNotOptimize(map.find(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_UnorderedMapLookup<SimdUuid, StringUuidHash<SimdUuid>>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 16);
+BENCHMARK(BM_UnorderedMapLookup<SimdUuid, std::hash<SimdUuid>>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 16);
+
+} // namespace andyccs
+
+BENCHMARK_MAIN();
@@ -0,0 +1,128 @@
+#include "uuid_hash.h"
+
+#include <bit>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_set>
+
+#include "uuid_basic.h"
+#include "uuid_simd.h"
+
+namespace andyccs {
+
+std::array<std::uint8_t, 16> FromHighLow(std::uint64_t high,
+                                         std::uint64_t low) {
+  std::array<std::uint8_t, 16> data;
+  for (int i = 0; i < 8; ++i) {
+    data[i] = high >> (56 - i * 8);
+    data[i + 8] = low >> (56 - i * 8);
+  }
+  return data;
+}
+
+TEST(HashUuid, Deterministic) {
+  std::array<std::uint8_t, 16> data =
+      FromHighLow(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF);
+  EXPECT_EQ(HashUuid(data), HashUuid(data));
+  EXPECT_EQ(HashUuid(data, 42), HashUuid(data, 42));
+}
+
+TEST(HashUuid, Seed) {
+  std::array<std::uint8_t, 16> data =
+      FromHighLow(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF);
+  EXPECT_NE(HashUuid(data, 1), HashUuid(data, 2));
+  EXPECT_EQ(HashUuid(data), HashUuid(data, 0));
+}
+
+// A half that zeroes one factor of the multiplication must not make every
+// other half collide, whatever the seed.
+TEST(HashUuid, SeedMixedIntoBothHalves) {
+  // The first half of the UUID as HashUuid loads it, XORed with kSecret0.
+  constexpr std::uint64_t kSecret0 = 0xA0761D6478BD642F;
+  std::array<std::uint8_t, 16> data_1 = {};
+  std::memcpy(data_1.data(), &kSecret0, 8);
+  std::array<std::uint8_t, 16> data_2 = data_1;
+  data_1[15] = 1;
+  data_2[15] = 2;
+
+  std::mt19937_64 rng(42);
+  for (int i = 0; i < 100; ++i) {
+    const std::uint64_t seed = rng();
+    EXPECT_NE(HashUuid(data_1, seed), HashUuid(data_2, seed)) << seed;
+  }
+}
+
+TEST(HashUuid, SameAsUuidTypes) {
+  std::array<std::uint8_t, 16> data =
+      FromHighLow(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF);
+  EXPECT_EQ(BasicUuid(data).hash(), HashUuid(data));
+  EXPECT_EQ(SimdUuid(data).hash(), HashUuid(data));
+  EXPECT_EQ(BasicUuid(data).hash(7), HashUuid(data, 7));
+  EXPECT_EQ(SimdUuid(data).hash(7), HashUuid(data, 7));
+}
+
+TEST(HashUuid, Avalanche) {
+  // Flipping a single bit of the UUID flips about half of the bits of the
+  // hash, in particular the lowest ones that hash tables use.
+  std::array<std::uint8_t, 16> data =
+      FromHighLow(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF);
+  std::size_t hash = HashUuid(data);
+  int total = 0;
+  for (int bit = 0; bit < 128; ++bit) {
+    std::array<std::uint8_t, 16> flipped = data;
+    flipped[bit / 8] ^= 1 << (bit % 8);
+    std::size_t difference = hash ^ HashUuid(flipped);
+    EXPECT_NE(difference & 0xFF, 0u) << "bit " << bit;
+    total += std::popcount(difference);
+  }
+  EXPECT_GT(total, 128 * 24);
+  EXPECT_LT(total, 128 * 40);
+}
+
+TEST(HashUuid, SequentialUuidsSpreadOverBuckets) {
+  // UUIDs that only differ in their lowest bits, like counters, must not all
+  // land in a handful of buckets.
+  constexpr int kCount = 1 << 12;
+  constexpr std::size_t kBuckets = 1 << 10;
+  std::unordered_set<std::size_t> buckets;
+  for (int i = 0; i < kCount; ++i) {
+    buckets.insert(HashUuid(FromHighLow(0x0192F3C4D5E67000, i)) % kBuckets);
+  }
+  EXPECT_GT(buckets.size(), kBuckets * 9 / 10);
+
+  buckets.clear();
+  for (int i = 0; i < kCount; ++i) {
+    buckets.insert(
+        HashUuid(FromHighLow(static_cast<std::uint64_t>(i) << 48, 0)) %
+        kBuckets);
+  }
+  EXPECT_GT(buckets.size(), kBuckets * 9 / 10);
+}
+
+TEST(SeededUuidHash, RandomSeed) {
+  SeededUuidHash<SimdUuid> hash_1;
+  SeededUuidHash<SimdUuid> hash_2;
+  EXPECT_NE(hash_1.seed(), hash_2.seed());
+
+  SimdUuid uuid = SimdUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF);
+  EXPECT_EQ(hash_1(uuid), uuid.hash(hash_1.seed()));
+  EXPECT_NE(hash_1(uuid), hash_2(uuid));
+}
+
+TEST(SeededUuidHash, Copy) {
+  SeededUuidHash<BasicUuid> hash_1;
+  SeededUuidHash<BasicUuid> hash_2 = hash_1;
+  BasicUuid uuid = BasicUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF);
+  EXPECT_EQ(hash_1(uuid), hash_2(uuid));
+}
+
+TEST(SeededUuidHash, UnorderedMap) {
+  std::unordered_map<SimdUuid, std::string, SeededUuidHash<SimdUuid>> my_map;
+  SimdUuid uuid = SimdUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF);
+  my_map[uuid] = "Hello World";
+  EXPECT_EQ(my_map[uuid], "Hello World");
+  EXPECT_EQ(my_map.size(), 1u);
+}
+
+} // namespace andyccs
@@ -0,0 +1,148 @@
+#include "uuid_index.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#include "uuid_cpu.h"
+#include "uuid_sort.h"
+
+namespace andyccs {
+namespace internal {
+
+void IndexSearchScalar(const IndexNode *nodes, std::size_t size,
+                       const SimdUuid *uuids, std::size_t count,
+                       std::size_t *slots) {
+  SearchIndexAll(
+      nodes, size, uuids, count, slots,
+      [](const IndexNode &node, std::int64_t high, std::int64_t low) {
+        int less = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+          less += (node.highs[lane] < high) |
+                  ((node.highs[lane] == high) & (node.lows[lane] < low));
+        }
+        return less;
+      });
+}
+
+} // namespace internal
+
+namespace {
+
+using internal::IndexNode;
+using internal::IndexSearchKernel;
+using internal::kIndexFanout;
+using internal::kIndexSignBit;
+
+const SimdUuid kMaxUuid(std::numeric_limits<std::uint64_t>::max(),
+                        std::numeric_limits<std::uint64_t>::max());
+
+IndexSearchKernel ActiveIndexSearchInternal() {
+#ifdef ANDYCCS_ARCH_X86
+  if (ActiveCpuIsa() >= CpuIsa::kAvx2) {
+    return &internal::IndexSearchAvx2;
+  }
+#endif
+  return &internal::IndexSearchScalar;
+}
+
+IndexSearchKernel ActiveIndexSearch() {
+  static const IndexSearchKernel kKernel = ActiveIndexSearchInternal();
+  return kKernel;
+}
+
+// Asks for the pages of [data, data + size) to be backed by huge pages, before
+// they are touched. Every level of a lookup in a large index reads a different
+// page, and with 4 KB pages, a TLB miss on top of the cache miss.
+void AdviseHugePages(void *data, std::size_t size) {
+#ifdef __linux__
+  constexpr std::uintptr_t kHugePageSize = 1 << 21;
+  const auto address = reinterpret_cast<std::uintptr_t>(data);
+  // madvise takes whole pages, so the partial huge pages at the ends are left
+  // out.
+  const std::uintptr_t begin = (address + kHugePageSize - 1) & -kHugePageSize;
+  const std::uintptr_t end = (address + size) & -kHugePageSize;
+  if (begin < end) {
+    madvise(reinterpret_cast<void *>(begin), end - begin, MADV_HUGEPAGE);
+  }
+#endif
+}
+
+// Fills the subtree of `node` with the sorted `uuids` from `next` on, in
+// order: the subtree of the first child, the first key, the subtree of the
+// second child, and so on. Slots past the UUIDs are padding.
+void Build(std::vector<IndexNode> &nodes, std::size_t node,
+           const std::vector<SimdUuid> &uuids, std::size_t &next) {
+  if (node >= nodes.size()) {
+    return;
+  }
+  for (int lane = 0; lane < 4; ++lane) {
+    Build(nodes, node * kIndexFanout + lane + 1, uuids, next);
+    const SimdUuid &uuid = next < uuids.size() ? uuids[next++] : kMaxUuid;
+    nodes[node].highs[lane] = static_cast<std::int64_t>(uuid.high() ^ kIndexSignBit);
+    nodes[node].lows[lane] = static_cast<std::int64_t>(uuid.low() ^ kIndexSignBit);
+  }
+  Build(nodes, node * kIndexFanout + 5, uuids, next);
+}
+
+} // namespace
+
+UuidIndex::UuidIndex(std::span<const SimdUuid> uuids) {
+  std::vector<SimdUuid> sorted(uuids.begin(), uuids.end());
+  SortUniqueUuids(sorted);
+  size_ = sorted.size();
+  contains_max_ = !sorted.empty() && sorted.back() == kMaxUuid;
+  const std::size_t nodes = (size_ + 3) / 4;
+  nodes_.reserve(nodes);
+  AdviseHugePages(nodes_.data(), nodes * sizeof(IndexNode));
+  nodes_.resize(nodes);
+  std::size_t next = 0;
+  Build(nodes_, 0, sorted, next);
+}
+
+std::optional<SimdUuid> UuidIndex::UuidAt(std::size_t slot) const {
+  if (slot >= nodes_.size() * 4) {
+    return std::nullopt;
+  }
+  const IndexNode &node = nodes_[slot / 4];
+  const SimdUuid uuid(node.highs[slot % 4] ^ kIndexSignBit,
+                      node.lows[slot % 4] ^ kIndexSignBit);
+  if (uuid == kMaxUuid && !contains_max_) {
+    return std::nullopt;
+  }
+  return uuid;
+}
+
+bool UuidIndex::Contains(const SimdUuid &uuid) const {
+  return LowerBound(uuid) == uuid;
+}
+
+std::optional<SimdUuid> UuidIndex::LowerBound(const SimdUuid &uuid) const {
+  std::size_t slot;
+  ActiveIndexSearch()(nodes_.data(), nodes_.size(), &uuid, 1, &slot);
+  return UuidAt(slot);
+}
+
+std::size_t UuidIndex::ContainsBatch(std::span<const SimdUuid> uuids,
+                                     std::span<bool> found) const {
+  const IndexSearchKernel search = ActiveIndexSearch();
+  std::array<std::size_t, 256> slots;
+  std::size_t count = 0;
+  for (std::size_t begin = 0; begin < uuids.size(); begin += slots.size()) {
+    const std::size_t size = std::min(slots.size(), uuids.size() - begin);
+    search(nodes_.data(), nodes_.size(), uuids.data() + begin, size,
+           slots.data());
+    for (std::size_t i = 0; i < size; ++i) {
+      found[begin + i] = UuidAt(slots[i]) == uuids[begin + i];
+      count += found[begin + i];
+    }
+  }
+  return count;
+}
+
+} // namespace andyccs
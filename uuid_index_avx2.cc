@@ -0,0 +1,47 @@
+#include "uuid_index_kernels.h"
+
+#ifdef ANDYCCS_ARCH_X86
+
+#include <bit>
+#include <immintrin.h>
+
+namespace andyccs {
+namespace internal {
+namespace {
+
+// Returns the number of keys of `node` less than (high, low), comparing the 4
+// keys at once.
+ANDYCCS_TARGET_AVX2 inline int CountLess(const IndexNode &node,
+                                         std::int64_t high, std::int64_t low) {
+  const __m256i highs =
+      _mm256_load_si256(reinterpret_cast<const __m256i *>(node.highs));
+  const __m256i lows =
+      _mm256_load_si256(reinterpret_cast<const __m256i *>(node.lows));
+  const __m256i key_high = _mm256_set1_epi64x(high);
+  const __m256i key_low = _mm256_set1_epi64x(low);
+  const __m256i less = _mm256_or_si256(
+      _mm256_cmpgt_epi64(key_high, highs),
+      _mm256_and_si256(_mm256_cmpeq_epi64(key_high, highs),
+                       _mm256_cmpgt_epi64(key_low, lows)));
+  return std::popcount(static_cast<unsigned>(
+      _mm256_movemask_pd(_mm256_castsi256_pd(less))));
+}
+
+} // namespace
+
+ANDYCCS_TARGET_AVX2 void IndexSearchAvx2(const IndexNode *nodes,
+                                         std::size_t size,
+                                         const SimdUuid *uuids,
+                                         std::size_t count,
+                                         std::size_t *slots) {
+  SearchIndexAll(nodes, size, uuids, count, slots,
+                 [](const IndexNode &node, std::int64_t high,
+                    std::int64_t low) ANDYCCS_TARGET_AVX2 {
+                   return CountLess(node, high, low);
+                 });
+}
+
+} // namespace internal
+} // namespace andyccs
+
+#endif
@@ -0,0 +1,136 @@
+#include "uuid_index.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "uuid_benchmark_utils.h"
+#include "uuid_cpu.h"
+#include "uuid_flat_map.h"
+#include "uuid_index_kernels.h"
+
+namespace andyccs {
+
+// Sets from the L2 cache to far larger than the last level cache: 64K UUIDs
+// are 1 MB, 100M UUIDs 1.6 GB.
+static void IndexArguments(benchmark::internal::Benchmark *benchmark) {
+  for (int size : {1 << 16, 1 << 20, 10'000'000, 100'000'000}) {
+    benchmark->Arg(size);
+  }
+}
+
+// What UuidIndex replaces.
+static void BM_LowerBoundContains(benchmark::State &state) {
+  std::vector<SimdUuid> uuids = RandomUuids(state.range(0), 42);
+  const std::vector<SimdUuid> queries = MixedQueries(uuids);
+  std::sort(uuids.begin(), uuids.end());
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (const SimdUuid &query : queries) {
+      auto it = std::lower_bound(uuids.begin(), uuids.end(), query);
+      count += it != uuids.end() && *it == query;
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_LowerBoundContains)->Apply(IndexArguments);
+
+static void BM_UnorderedSetContains(benchmark::State &state) {
+  const std::vector<SimdUuid> uuids = RandomUuids(state.range(0), 42);
+  const std::vector<SimdUuid> queries = MixedQueries(uuids);
+  const std::unordered_set<SimdUuid> set(uuids.begin(), uuids.end());
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (const SimdUuid &query : queries) {
+      count += set.contains(query);
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_UnorderedSetContains)->Apply(IndexArguments);
+
+static void BM_UuidFlatSetContains(benchmark::State &state) {
+  const std::vector<SimdUuid> uuids = RandomUuids(state.range(0), 42);
+  const std::vector<SimdUuid> queries = MixedQueries(uuids);
+  UuidFlatSet<> set;
+  for (const SimdUuid &uuid : uuids) {
+    set.insert(uuid);
+  }
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (const SimdUuid &query : queries) {
+      count += set.contains(query);
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_UuidFlatSetContains)->Apply(IndexArguments);
+
+static void BM_UuidIndexContains(benchmark::State &state) {
+  const std::vector<SimdUuid> uuids = RandomUuids(state.range(0), 42);
+  const std::vector<SimdUuid> queries = MixedQueries(uuids);
+  const UuidIndex index(uuids);
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (const SimdUuid &query : queries) {
+      count += index.Contains(query);
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_UuidIndexContains)->Apply(IndexArguments);
+
+static void BM_UuidIndexContainsBatch(benchmark::State &state) {
+  const std::vector<SimdUuid> uuids = RandomUuids(state.range(0), 42);
+  const std::vector<SimdUuid> queries = MixedQueries(uuids);
+  const UuidIndex index(uuids);
+  std::unique_ptr<bool[]> found(new bool[queries.size()]);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        index.ContainsBatch(queries, {found.get(), queries.size()}));
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_UuidIndexContainsBatch)->Apply(IndexArguments);
+
+// Searches a tree larger than the cache with each kernel.
+static void BM_IndexSearchKernel(benchmark::State &state,
+                                 internal::IndexSearchKernel kernel,
+                                 CpuIsa isa) {
+  if (!CpuSupports(isa)) {
+    state.SkipWithError("Instruction set not supported by the CPU");
+    return;
+  }
+  const std::vector<SimdUuid> uuids = RandomUuids(1 << 20, 42);
+  const std::vector<SimdUuid> queries = MixedQueries(uuids);
+  // The nodes are not sorted, which does not change the work of the kernels:
+  // every lookup still goes down one path of the tree.
+  std::vector<internal::IndexNode> nodes(uuids.size() / 4);
+  for (std::size_t i = 0; i < uuids.size(); ++i) {
+    nodes[i / 4].highs[i % 4] = uuids[i].high();
+    nodes[i / 4].lows[i % 4] = uuids[i].low();
+  }
+  std::vector<std::size_t> slots(queries.size());
+  for (auto _ : state) {
+    kernel(nodes.data(), nodes.size(), queries.data(), queries.size(),
+           slots.data());
+    benchmark::DoNotOptimize(slots.data());
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK_CAPTURE(BM_IndexSearchKernel, scalar, &internal::IndexSearchScalar,
+                  CpuIsa::kScalar);
+#ifdef ANDYCCS_ARCH_X86
+BENCHMARK_CAPTURE(BM_IndexSearchKernel, avx2, &internal::IndexSearchAvx2,
+                  CpuIsa::kAvx2);
+#endif
+
+} // namespace andyccs
+
+BENCHMARK_MAIN();
@@ -0,0 +1,146 @@
+#ifndef ANDYCCS_UUID_INDEX_KERNELS_H
+#define ANDYCCS_UUID_INDEX_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "uuid_cpu.h"
+#include "uuid_simd.h"
+
+namespace andyccs {
+namespace internal {
+
+// A node of UuidIndex: 4 UUIDs in increasing order, split in halves.
+//
+// The halves have their top bit flipped, so that unsigned order is signed
+// order, which AVX2 compares. Padding is the largest UUID, 0x7FFF... once
+// flipped.
+struct alignas(64) IndexNode {
+  std::int64_t highs[4];
+  std::int64_t lows[4];
+};
+
+constexpr std::uint64_t kIndexSignBit = std::uint64_t{1} << 63;
+
+// Children of node k are at k * kIndexFanout + 1 to k * kIndexFanout +
+// kIndexFanout, the ones of the UUIDs between its keys.
+constexpr std::size_t kIndexFanout = 5;
+
+// Lookups that go down the tree together in the kernels.
+constexpr std::size_t kIndexBatchSize = 16;
+
+// For every `uuids[i]`, writes to `slots[i]` the slot, i.e. node * 4 + lane,
+// of the first key of the `size` nodes that is not less than it, or size * 4
+// if there is none.
+using IndexSearchKernel = void (*)(const IndexNode *nodes, std::size_t size,
+                                   const SimdUuid *uuids, std::size_t count,
+                                   std::size_t *slots);
+
+void IndexSearchScalar(const IndexNode *nodes, std::size_t size,
+                       const SimdUuid *uuids, std::size_t count,
+                       std::size_t *slots);
+
+#ifdef ANDYCCS_ARCH_X86
+void IndexSearchAvx2(const IndexNode *nodes, std::size_t size,
+                     const SimdUuid *uuids, std::size_t count,
+                     std::size_t *slots);
+#endif
+
+// Returns the number of levels of a tree of `size` nodes, i.e. of its leftmost
+// path, which is the longest.
+inline int IndexHeight(std::size_t size) {
+  int height = 0;
+  for (std::size_t node = 0; node < size; node = node * kIndexFanout + 1) {
+    ++height;
+  }
+  return height;
+}
+
+inline void PrefetchIndexNode(const IndexNode *node) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(node);
+#endif
+}
+
+// The searches below are always inlined in the kernels, so that `count_less`
+// is inlined too, which it cannot be in a function without their target.
+#if defined(__GNUC__) || defined(__clang__)
+#define ANDYCCS_INDEX_INLINE __attribute__((always_inline)) inline
+#else
+#define ANDYCCS_INDEX_INLINE inline
+#endif
+
+// Returns the slot of the first key of the `size` nodes that is not less than
+// `uuid`, see IndexSearchKernel. `count_less(node, high, low)` returns the
+// number of keys of the node less than the flipped halves of a UUID.
+template <class CountLess>
+ANDYCCS_INDEX_INLINE std::size_t SearchIndex(const IndexNode *nodes,
+                                             std::size_t size,
+                                             const SimdUuid &uuid,
+                                             const CountLess &count_less) {
+  const auto high = static_cast<std::int64_t>(uuid.high() ^ kIndexSignBit);
+  const auto low = static_cast<std::int64_t>(uuid.low() ^ kIndexSignBit);
+  std::size_t slot = size * 4;
+  for (std::size_t node = 0; node < size;) {
+    const int less = count_less(nodes[node], high, low);
+    slot = less < 4 ? node * 4 + less : slot;
+    node = node * kIndexFanout + less + 1;
+  }
+  return slot;
+}
+
+// Same as SearchIndex for kIndexBatchSize UUIDs, which go down the tree
+// together, level by level. The next node of every UUID is prefetched before
+// moving on to the next UUID, so that their cache misses overlap.
+template <class CountLess>
+ANDYCCS_INDEX_INLINE void SearchIndexBatch(const IndexNode *nodes,
+                                           std::size_t size,
+                                           const SimdUuid *uuids,
+                                           std::size_t *slots,
+                                           const CountLess &count_less) {
+  std::size_t node[kIndexBatchSize] = {};
+  std::int64_t high[kIndexBatchSize];
+  std::int64_t low[kIndexBatchSize];
+  for (std::size_t i = 0; i < kIndexBatchSize; ++i) {
+    high[i] = static_cast<std::int64_t>(uuids[i].high() ^ kIndexSignBit);
+    low[i] = static_cast<std::int64_t>(uuids[i].low() ^ kIndexSignBit);
+    slots[i] = size * 4;
+  }
+  const int height = IndexHeight(size);
+  for (int level = 0; level < height; ++level) {
+    for (std::size_t i = 0; i < kIndexBatchSize; ++i) {
+      // Only paths on the right end one level earlier.
+      if (node[i] >= size) {
+        continue;
+      }
+      const int less = count_less(nodes[node[i]], high[i], low[i]);
+      slots[i] = less < 4 ? node[i] * 4 + less : slots[i];
+      node[i] = node[i] * kIndexFanout + less + 1;
+      if (node[i] < size) {
+        PrefetchIndexNode(&nodes[node[i]]);
+      }
+    }
+  }
+}
+
+// Searches the `count` UUIDs in batches, and the last ones one by one, see
+// IndexSearchKernel.
+template <class CountLess>
+ANDYCCS_INDEX_INLINE void SearchIndexAll(const IndexNode *nodes,
+                                         std::size_t size,
+                                         const SimdUuid *uuids,
+                                         std::size_t count, std::size_t *slots,
+                                         const CountLess &count_less) {
+  std::size_t i = 0;
+  for (; i + kIndexBatchSize <= count; i += kIndexBatchSize) {
+    SearchIndexBatch(nodes, size, uuids + i, slots + i, count_less);
+  }
+  for (; i < count; ++i) {
+    slots[i] = SearchIndex(nodes, size, uuids[i], count_less);
+  }
+}
+
+} // namespace internal
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_INDEX_KERNELS_H
@@ -0,0 +1,115 @@
+#include "uuid_index.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace andyccs {
+namespace {
+
+constexpr std::uint64_t kMax = std::numeric_limits<std::uint64_t>::max();
+
+// Returns the UUIDs to look up in an index of `uuids`: the UUIDs, the ones just
+// before and after, random ones, and the smallest and largest UUIDs.
+std::vector<SimdUuid> Queries(const std::vector<SimdUuid> &uuids) {
+  std::mt19937_64 rng(7);
+  std::vector<SimdUuid> queries = {SimdUuid(0, 0), SimdUuid(kMax, kMax)};
+  for (const SimdUuid &uuid : uuids) {
+    queries.push_back(uuid);
+    queries.emplace_back(uuid.high(), uuid.low() - 1);
+    queries.emplace_back(uuid.high(), uuid.low() + 1);
+    queries.emplace_back(rng(), rng());
+  }
+  return queries;
+}
+
+// Checks the index of `uuids` against std::lower_bound.
+void ExpectSameAsLowerBound(std::vector<SimdUuid> uuids) {
+  const UuidIndex index(uuids);
+  std::sort(uuids.begin(), uuids.end());
+  uuids.erase(std::unique(uuids.begin(), uuids.end()), uuids.end());
+  EXPECT_EQ(index.size(), uuids.size());
+
+  const std::vector<SimdUuid> queries = Queries(uuids);
+  for (const SimdUuid &query : queries) {
+    auto it = std::lower_bound(uuids.begin(), uuids.end(), query);
+    std::optional<SimdUuid> expected;
+    if (it != uuids.end()) {
+      expected = *it;
+    }
+    EXPECT_EQ(index.LowerBound(query), expected)
+        << std::string(query) << " in " << uuids.size();
+    EXPECT_EQ(index.Contains(query), expected == query) << std::string(query);
+  }
+
+  std::unique_ptr<bool[]> found(new bool[queries.size()]);
+  std::size_t count = 0;
+  for (const SimdUuid &query : queries) {
+    count += index.Contains(query);
+  }
+  EXPECT_EQ(index.ContainsBatch(queries, {found.get(), queries.size()}),
+            count);
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    EXPECT_EQ(found[i], index.Contains(queries[i])) << i;
+  }
+}
+
+TEST(UuidIndex, Empty) {
+  const UuidIndex index;
+  EXPECT_TRUE(index.empty());
+  EXPECT_FALSE(index.Contains(SimdUuid()));
+  EXPECT_FALSE(index.LowerBound(SimdUuid()));
+  ExpectSameAsLowerBound({});
+}
+
+// Every size around full nodes and full levels of the tree.
+TEST(UuidIndex, Random) {
+  std::mt19937_64 rng(42);
+  for (std::size_t size : {1, 2, 3, 4, 5, 6, 23, 24, 25, 119, 120, 121, 1000,
+                           3124, 3125, 10000}) {
+    std::vector<SimdUuid> uuids;
+    for (std::size_t i = 0; i < size; ++i) {
+      uuids.emplace_back(rng(), rng());
+    }
+    ExpectSameAsLowerBound(uuids);
+  }
+}
+
+TEST(UuidIndex, Duplicates) {
+  const SimdUuid uuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E);
+  const UuidIndex index(std::vector{uuid, SimdUuid(), uuid, uuid});
+  EXPECT_EQ(index.size(), 2u);
+  EXPECT_TRUE(index.Contains(uuid));
+  ExpectSameAsLowerBound({uuid, SimdUuid(), uuid, uuid});
+}
+
+// UUIDs that only differ in their low half, or in their top bits.
+TEST(UuidIndex, SharedHighHalves) {
+  std::vector<SimdUuid> uuids;
+  for (std::uint64_t i = 0; i < 100; ++i) {
+    uuids.emplace_back(0x6BBBB416EDC3405F, i * 3);
+    uuids.emplace_back(kMax - i % 2, kMax - i);
+    uuids.emplace_back(i << 60, i << 62);
+  }
+  ExpectSameAsLowerBound(uuids);
+}
+
+// The largest UUID is also the padding of the tree.
+TEST(UuidIndex, LargestUuid) {
+  const SimdUuid largest(kMax, kMax);
+  const UuidIndex without_largest(std::vector{SimdUuid(1, 2)});
+  EXPECT_FALSE(without_largest.Contains(largest));
+  EXPECT_FALSE(without_largest.LowerBound(SimdUuid(1, 3)));
+
+  const UuidIndex with_largest(std::vector{SimdUuid(1, 2), largest});
+  EXPECT_TRUE(with_largest.Contains(largest));
+  EXPECT_EQ(with_largest.LowerBound(SimdUuid(1, 3)), largest);
+  ExpectSameAsLowerBound({SimdUuid(1, 2), largest});
+}
+
+} // namespace
+} // namespace andyccs
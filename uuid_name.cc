@@ -0,0 +1,253 @@
+#include "uuid_name.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "uuid_cpu.h"
+#include "uuid_name_kernels.h"
+
+namespace andyccs {
+namespace {
+
+using internal::BlockKernel;
+using internal::kNameHashLanes;
+using internal::LanesKernel;
+
+// What NameUuid needs to know about SHA-1 and MD5.
+struct Sha1 {
+  static constexpr int kVersion = 5;
+  static constexpr int kWords = 5;
+  static constexpr const std::uint32_t *kInit = internal::kSha1Init;
+  // Byte order of the message length and of the digest.
+  static constexpr bool kBigEndian = true;
+};
+
+struct Md5 {
+  static constexpr int kVersion = 3;
+  static constexpr int kWords = 4;
+  static constexpr const std::uint32_t *kInit = internal::kMd5Init;
+  static constexpr bool kBigEndian = false;
+};
+
+struct NameHashKernels {
+  BlockKernel sha1_block;
+  BlockKernel md5_block;
+  // nullptr when multi-buffer kernels are not available, or slower.
+  LanesKernel sha1_lanes;
+  LanesKernel md5_lanes;
+};
+
+NameHashKernels ActiveNameHashKernelsInternal() {
+  NameHashKernels kernels = {&internal::Sha1BlockScalar,
+                             &internal::Md5BlockScalar, nullptr, nullptr};
+#ifdef ANDYCCS_ARCH_X86
+  const CpuIsa isa = ActiveCpuIsa();
+  if (isa >= CpuIsa::kAvx2) {
+    kernels.sha1_lanes = &internal::Sha1LanesAvx2;
+    kernels.md5_lanes = &internal::Md5LanesAvx2;
+  }
+  if (isa >= CpuIsa::kSse42 && CpuSupportsSha()) {
+    kernels.sha1_block = &internal::Sha1BlockShaNi;
+  }
+#endif
+  return kernels;
+}
+
+const NameHashKernels &ActiveNameHashKernels() {
+  static const NameHashKernels kKernels = ActiveNameHashKernelsInternal();
+  return kKernels;
+}
+
+template <class Hash> BlockKernel BlockKernelFor(const NameHashKernels &k) {
+  return Hash::kVersion == 5 ? k.sha1_block : k.md5_block;
+}
+
+template <class Hash> LanesKernel LanesKernelFor(const NameHashKernels &k) {
+  return Hash::kVersion == 5 ? k.sha1_lanes : k.md5_lanes;
+}
+
+// The message is the 16 bytes of the namespace followed by the name, padded
+// with 0x80, zeros and the length in bits to a multiple of 64 bytes.
+class Message {
+public:
+  Message(const std::array<std::uint8_t, 16> &name_space,
+          std::string_view name)
+      : name_space_(name_space), name_(name) {}
+
+  std::size_t size() const { return 16 + name_.size(); }
+
+  std::size_t block_count() const { return (size() + 8) / 64 + 1; }
+
+  // Writes the 64 bytes of block `index` to `out`.
+  template <class Hash>
+  void CopyBlock(std::size_t index, std::uint8_t *out) const {
+    const std::size_t begin = index * 64;
+    const std::size_t end = begin + 64;
+    std::memset(out, 0, 64);
+    if (begin < 16) {
+      std::memcpy(out, name_space_.data(), 16);
+    }
+    // Part of the name in this block.
+    const std::size_t name_begin = std::max<std::size_t>(begin, 16);
+    const std::size_t name_end = std::min(end, size());
+    if (name_begin < name_end) {
+      std::memcpy(out + name_begin - begin, name_.data() + name_begin - 16,
+                  name_end - name_begin);
+    }
+    if (begin <= size() && size() < end) {
+      out[size() - begin] = 0x80;
+    }
+    if (index + 1 == block_count()) {
+      const std::uint64_t bits = std::uint64_t{size()} * 8;
+      for (int i = 0; i < 8; ++i) {
+        out[Hash::kBigEndian ? 63 - i : 56 + i] = bits >> (8 * i);
+      }
+    }
+  }
+
+private:
+  const std::array<std::uint8_t, 16> &name_space_;
+  std::string_view name_;
+};
+
+std::array<std::uint8_t, 16> Bytes(const SimdUuid &uuid) {
+  const std::uint64_t high = uuid.high();
+  const std::uint64_t low = uuid.low();
+  std::array<std::uint8_t, 16> bytes;
+  for (int i = 0; i < 8; ++i) {
+    bytes[i] = high >> (8 * (7 - i));
+    bytes[8 + i] = low >> (8 * (7 - i));
+  }
+  return bytes;
+}
+
+// Builds the UUID from the first 16 bytes of the digest, given by the first 4
+// words of the state, word w of which is at `state[w * stride]`.
+template <class Hash>
+SimdUuid MakeUuid(const std::uint32_t *state, std::size_t stride) {
+  std::array<std::uint8_t, 16> bytes;
+  for (int w = 0; w < 4; ++w) {
+    const std::uint32_t word = state[w * stride];
+    for (int i = 0; i < 4; ++i) {
+      bytes[4 * w + i] = word >> (Hash::kBigEndian ? 8 * (3 - i) : 8 * i);
+    }
+  }
+  bytes[6] = (bytes[6] & 0x0F) | (Hash::kVersion << 4);
+  bytes[8] = (bytes[8] & 0x3F) | 0x80;
+  return SimdUuid(bytes);
+}
+
+template <class Hash>
+SimdUuid NameUuid(BlockKernel kernel,
+                  const std::array<std::uint8_t, 16> &name_space,
+                  std::string_view name) {
+  std::uint32_t state[Hash::kWords];
+  std::copy(Hash::kInit, Hash::kInit + Hash::kWords, state);
+  const Message message(name_space, name);
+  alignas(16) std::uint8_t block[64];
+  for (std::size_t i = 0; i < message.block_count(); ++i) {
+    message.template CopyBlock<Hash>(i, block);
+    kernel(state, block);
+  }
+  return MakeUuid<Hash>(state, 1);
+}
+
+// Hashes the names kNameHashLanes at a time. Every lane hashes one name, block
+// after block, and takes the next name when it is done. Lanes without names,
+// at the end, hash garbage which is thrown away.
+template <class Hash>
+void NameUuidsLanes(LanesKernel kernel,
+                    const std::array<std::uint8_t, 16> &name_space,
+                    std::span<const std::string_view> names,
+                    std::span<SimdUuid> result) {
+  constexpr std::size_t kIdle = -1;
+  alignas(32) std::uint32_t state[Hash::kWords * kNameHashLanes];
+  alignas(32) std::uint8_t blocks[64 * kNameHashLanes] = {};
+  std::size_t name_index[kNameHashLanes];
+  std::size_t block_index[kNameHashLanes];
+
+  std::size_t next = 0;
+  std::size_t active = 0;
+  auto start = [&](std::size_t lane) {
+    if (next == names.size()) {
+      name_index[lane] = kIdle;
+      return;
+    }
+    name_index[lane] = next++;
+    block_index[lane] = 0;
+    for (int w = 0; w < Hash::kWords; ++w) {
+      state[w * kNameHashLanes + lane] = Hash::kInit[w];
+    }
+    ++active;
+  };
+  for (std::size_t lane = 0; lane < kNameHashLanes; ++lane) {
+    start(lane);
+  }
+
+  while (active > 0) {
+    for (std::size_t lane = 0; lane < kNameHashLanes; ++lane) {
+      if (name_index[lane] != kIdle) {
+        Message(name_space, names[name_index[lane]])
+            .template CopyBlock<Hash>(block_index[lane], blocks + 64 * lane);
+      }
+    }
+    kernel(state, blocks);
+    for (std::size_t lane = 0; lane < kNameHashLanes; ++lane) {
+      if (name_index[lane] == kIdle) {
+        continue;
+      }
+      const Message message(name_space, names[name_index[lane]]);
+      if (++block_index[lane] == message.block_count()) {
+        result[name_index[lane]] =
+            MakeUuid<Hash>(state + lane, kNameHashLanes);
+        --active;
+        start(lane);
+      }
+    }
+  }
+}
+
+template <class Hash>
+void NameUuids(const SimdUuid &name_space,
+               std::span<const std::string_view> names,
+               std::span<SimdUuid> result) {
+  const NameHashKernels &kernels = ActiveNameHashKernels();
+  const std::array<std::uint8_t, 16> bytes = Bytes(name_space);
+  names = names.first(std::min(names.size(), result.size()));
+  if (LanesKernel lanes = LanesKernelFor<Hash>(kernels);
+      lanes != nullptr && names.size() >= kNameHashLanes) {
+    NameUuidsLanes<Hash>(lanes, bytes, names, result);
+    return;
+  }
+  const BlockKernel block = BlockKernelFor<Hash>(kernels);
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    result[i] = NameUuid<Hash>(block, bytes, names[i]);
+  }
+}
+
+} // namespace
+
+SimdUuid NameUuidV5(const SimdUuid &name_space, std::string_view name) {
+  return NameUuid<Sha1>(ActiveNameHashKernels().sha1_block, Bytes(name_space),
+                        name);
+}
+
+SimdUuid NameUuidV3(const SimdUuid &name_space, std::string_view name) {
+  return NameUuid<Md5>(ActiveNameHashKernels().md5_block, Bytes(name_space),
+                       name);
+}
+
+void NameUuidsV5(const SimdUuid &name_space,
+                 std::span<const std::string_view> names,
+                 std::span<SimdUuid> result) {
+  NameUuids<Sha1>(name_space, names, result);
+}
+
+void NameUuidsV3(const SimdUuid &name_space,
+                 std::span<const std::string_view> names,
+                 std::span<SimdUuid> result) {
+  NameUuids<Md5>(name_space, names, result);
+}
+
+} // namespace andyccs
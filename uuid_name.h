@@ -0,0 +1,50 @@
+#ifndef ANDYCCS_UUID_NAME_H
+#define ANDYCCS_UUID_NAME_H
+
+#include <span>
+#include <string_view>
+
+#include "uuid_simd.h"
+
+namespace andyccs {
+
+// Namespaces of RFC 9562, Section 6.6, for fully qualified domain names, URLs,
+// ISO OIDs and X.500 distinguished names.
+inline constexpr SimdUuid kNamespaceDns =
+    SimdUuid::ParseConstant("6ba7b810-9dad-11d1-80b4-00c04fd430c8");
+inline constexpr SimdUuid kNamespaceUrl =
+    SimdUuid::ParseConstant("6ba7b811-9dad-11d1-80b4-00c04fd430c8");
+inline constexpr SimdUuid kNamespaceOid =
+    SimdUuid::ParseConstant("6ba7b812-9dad-11d1-80b4-00c04fd430c8");
+inline constexpr SimdUuid kNamespaceX500 =
+    SimdUuid::ParseConstant("6ba7b814-9dad-11d1-80b4-00c04fd430c8");
+
+// Returns the UUIDv5 of `name` in `name_space`, i.e. the first 16 bytes of the
+// SHA-1 of the namespace bytes followed by the name, with the version and
+// variant set. The same name in the same namespace always gives the same UUID.
+//
+// Uses SHA-NI when the CPU has it, see CpuSupportsSha.
+SimdUuid NameUuidV5(const SimdUuid &name_space, std::string_view name);
+
+// Same as NameUuidV5, with MD5. Prefer UUIDv5 unless UUIDv3 is needed for
+// compatibility.
+SimdUuid NameUuidV3(const SimdUuid &name_space, std::string_view name);
+
+// Writes NameUuidV5(name_space, names[i]) to result[i], for every i below the
+// size of both spans.
+//
+// With AVX2, 8 names are hashed at once, one per 32-bit lane. When a name is
+// done, the next name takes its lane, so names of different lengths keep all
+// the lanes busy.
+void NameUuidsV5(const SimdUuid &name_space,
+                 std::span<const std::string_view> names,
+                 std::span<SimdUuid> result);
+
+// Same as NameUuidsV5, with MD5.
+void NameUuidsV3(const SimdUuid &name_space,
+                 std::span<const std::string_view> names,
+                 std::span<SimdUuid> result);
+
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_NAME_H
@@ -0,0 +1,161 @@
+#include "uuid_name_kernels.h"
+
+#ifdef ANDYCCS_ARCH_X86
+
+#include <cstdint>
+#include <immintrin.h>
+
+namespace andyccs {
+namespace internal {
+namespace {
+
+static_assert(kNameHashLanes == 8, "One 32-bit lane per message");
+
+// Multi-buffer SHA-1 and MD5: every instruction works on 8 messages, one per
+// 32-bit lane, so the rounds run as in the scalar kernels, 8 at a time. The
+// rounds are unrolled, so that the message schedule indices and the rotations
+// are known at compile time.
+
+template <int K> ANDYCCS_TARGET_AVX2 inline __m256i RotateLeft(__m256i x) {
+  return _mm256_or_si256(_mm256_slli_epi32(x, K), _mm256_srli_epi32(x, 32 - K));
+}
+
+// Same as above, with the rotation as an argument.
+ANDYCCS_TARGET_AVX2 inline __m256i RotateLeft(__m256i x, int k) {
+  return _mm256_or_si256(_mm256_sll_epi32(x, _mm_cvtsi32_si128(k)),
+                         _mm256_srl_epi32(x, _mm_cvtsi32_si128(32 - k)));
+}
+
+// Loads word t of the 8 blocks, 64 bytes apart.
+ANDYCCS_TARGET_AVX2 inline __m256i LoadWord(const std::uint8_t *blocks,
+                                            int t) {
+  const __m256i kOffsets = _mm256_setr_epi32(0, 16, 32, 48, 64, 80, 96, 112);
+  return _mm256_i32gather_epi32(reinterpret_cast<const int *>(blocks) + t,
+                                kOffsets, 4);
+}
+
+ANDYCCS_TARGET_AVX2 inline __m256i Load(const std::uint32_t *state, int word) {
+  return _mm256_loadu_si256(
+      reinterpret_cast<const __m256i *>(state + word * kNameHashLanes));
+}
+
+ANDYCCS_TARGET_AVX2 inline void Store(std::uint32_t *state, int word,
+                                      __m256i value) {
+  _mm256_storeu_si256(
+      reinterpret_cast<__m256i *>(state + word * kNameHashLanes), value);
+}
+
+} // namespace
+
+ANDYCCS_TARGET_AVX2 void Sha1LanesAvx2(std::uint32_t *state,
+                                       const std::uint8_t *blocks) {
+  const __m256i kByteSwap = _mm256_setr_epi8(
+      3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5,
+      4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+  // The last 16 words of the message schedule.
+  __m256i w[16];
+  for (int t = 0; t < 16; ++t) {
+    w[t] = _mm256_shuffle_epi8(LoadWord(blocks, t), kByteSwap);
+  }
+
+  __m256i a = Load(state, 0);
+  __m256i b = Load(state, 1);
+  __m256i c = Load(state, 2);
+  __m256i d = Load(state, 3);
+  __m256i e = Load(state, 4);
+  auto round = [&](int t, __m256i f) ANDYCCS_TARGET_AVX2 {
+    if (t >= 16) {
+      w[t % 16] = RotateLeft<1>(_mm256_xor_si256(
+          _mm256_xor_si256(w[(t - 3) % 16], w[(t - 8) % 16]),
+          _mm256_xor_si256(w[(t - 14) % 16], w[t % 16])));
+    }
+    const __m256i temp = _mm256_add_epi32(
+        _mm256_add_epi32(RotateLeft<5>(a), f),
+        _mm256_add_epi32(
+            _mm256_add_epi32(e, _mm256_set1_epi32(kSha1K[t / 20])),
+            w[t % 16]));
+    e = d;
+    d = c;
+    c = RotateLeft<30>(b);
+    b = a;
+    a = temp;
+  };
+#pragma GCC unroll 20
+  for (int t = 0; t < 20; ++t) {
+    round(t, _mm256_xor_si256(
+                 d, _mm256_and_si256(b, _mm256_xor_si256(c, d))));
+  }
+#pragma GCC unroll 20
+  for (int t = 20; t < 40; ++t) {
+    round(t, _mm256_xor_si256(_mm256_xor_si256(b, c), d));
+  }
+#pragma GCC unroll 20
+  for (int t = 40; t < 60; ++t) {
+    round(t, _mm256_or_si256(_mm256_and_si256(b, c),
+                             _mm256_and_si256(d, _mm256_or_si256(b, c))));
+  }
+#pragma GCC unroll 20
+  for (int t = 60; t < 80; ++t) {
+    round(t, _mm256_xor_si256(_mm256_xor_si256(b, c), d));
+  }
+
+  Store(state, 0, _mm256_add_epi32(Load(state, 0), a));
+  Store(state, 1, _mm256_add_epi32(Load(state, 1), b));
+  Store(state, 2, _mm256_add_epi32(Load(state, 2), c));
+  Store(state, 3, _mm256_add_epi32(Load(state, 3), d));
+  Store(state, 4, _mm256_add_epi32(Load(state, 4), e));
+}
+
+ANDYCCS_TARGET_AVX2 void Md5LanesAvx2(std::uint32_t *state,
+                                      const std::uint8_t *blocks) {
+  __m256i m[16];
+  for (int t = 0; t < 16; ++t) {
+    m[t] = LoadWord(blocks, t);
+  }
+
+  __m256i a = Load(state, 0);
+  __m256i b = Load(state, 1);
+  __m256i c = Load(state, 2);
+  __m256i d = Load(state, 3);
+  auto round = [&](int i, __m256i f) ANDYCCS_TARGET_AVX2 {
+    const __m256i sum = _mm256_add_epi32(
+        _mm256_add_epi32(a, f),
+        _mm256_add_epi32(_mm256_set1_epi32(kMd5K[i]), m[Md5Word(i)]));
+    const __m256i temp = d;
+    d = c;
+    c = b;
+    b = _mm256_add_epi32(b, RotateLeft(sum, kMd5Shift[i]));
+    a = temp;
+  };
+  const __m256i kOnes = _mm256_set1_epi32(-1);
+#pragma GCC unroll 16
+  for (int i = 0; i < 16; ++i) {
+    round(i, _mm256_xor_si256(
+                 d, _mm256_and_si256(b, _mm256_xor_si256(c, d))));
+  }
+#pragma GCC unroll 16
+  for (int i = 16; i < 32; ++i) {
+    round(i, _mm256_xor_si256(
+                 c, _mm256_and_si256(d, _mm256_xor_si256(b, c))));
+  }
+#pragma GCC unroll 16
+  for (int i = 32; i < 48; ++i) {
+    round(i, _mm256_xor_si256(_mm256_xor_si256(b, c), d));
+  }
+#pragma GCC unroll 16
+  for (int i = 48; i < 64; ++i) {
+    round(i, _mm256_xor_si256(
+                 c, _mm256_or_si256(b, _mm256_xor_si256(d, kOnes))));
+  }
+
+  Store(state, 0, _mm256_add_epi32(Load(state, 0), a));
+  Store(state, 1, _mm256_add_epi32(Load(state, 1), b));
+  Store(state, 2, _mm256_add_epi32(Load(state, 2), c));
+  Store(state, 3, _mm256_add_epi32(Load(state, 3), d));
+}
+
+} // namespace internal
+} // namespace andyccs
+
+#endif
@@ -0,0 +1,53 @@
+#include "uuid_name.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+namespace andyccs {
+
+// Names of state.range(0) bytes, e.g. 16 for record ids and 200 for URLs.
+std::vector<std::string> MakeNames(std::size_t count, std::size_t size) {
+  std::vector<std::string> names;
+  for (std::size_t i = 0; i < count; ++i) {
+    std::string name = std::to_string(i);
+    name.resize(size, 'x');
+    names.push_back(name);
+  }
+  return names;
+}
+
+template <SimdUuid (*NameUuid)(const SimdUuid &, std::string_view)>
+static void BM_NameUuid(benchmark::State &state) {
+  const std::vector<std::string> names = MakeNames(1 << 10, state.range(0));
+  for (auto _ : state) {
+    for (const std::string &name : names) {
+      benchmark::DoNotOptimize(NameUuid(kNamespaceDns, name));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+  state.SetBytesProcessed(state.iterations() * names.size() * state.range(0));
+}
+BENCHMARK(BM_NameUuid<NameUuidV5>)->Arg(16)->Arg(200);
+BENCHMARK(BM_NameUuid<NameUuidV3>)->Arg(16)->Arg(200);
+
+template <void (*NameUuids)(const SimdUuid &, std::span<const std::string_view>,
+                            std::span<SimdUuid>)>
+static void BM_NameUuids(benchmark::State &state) {
+  const std::vector<std::string> names = MakeNames(1 << 10, state.range(0));
+  const std::vector<std::string_view> views(names.begin(), names.end());
+  std::vector<SimdUuid> result(names.size());
+  for (auto _ : state) {
+    NameUuids(kNamespaceDns, views, result);
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+  state.SetBytesProcessed(state.iterations() * names.size() * state.range(0));
+}
+BENCHMARK(BM_NameUuids<NameUuidsV5>)->Arg(16)->Arg(200);
+BENCHMARK(BM_NameUuids<NameUuidsV3>)->Arg(16)->Arg(200);
+
+} // namespace andyccs
+
+BENCHMARK_MAIN();
@@ -0,0 +1,79 @@
+#ifndef ANDYCCS_UUID_NAME_KERNELS_H
+#define ANDYCCS_UUID_NAME_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "uuid_cpu.h"
+
+namespace andyccs {
+namespace internal {
+
+// Compression functions of SHA-1 and MD5, behind NameUuidV5 and NameUuidV3.
+//
+// Single-buffer kernels hash one 64-byte block into `state`, i.e. 5 words for
+// SHA-1 and 4 words for MD5. Multi-buffer kernels hash one block for each of
+// kNameHashLanes messages: the block of lane i is at `blocks + 64 * i`, and
+// word w of its state is at `state[w * kNameHashLanes + i]`.
+inline constexpr std::size_t kNameHashLanes = 8;
+
+inline constexpr std::uint32_t kSha1Init[5] = {0x67452301, 0xEFCDAB89,
+                                               0x98BADCFE, 0x10325476,
+                                               0xC3D2E1F0};
+
+// Round constants of SHA-1, one per 20 rounds.
+inline constexpr std::uint32_t kSha1K[4] = {0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC,
+                                            0xCA62C1D6};
+
+inline constexpr std::uint32_t kMd5Init[4] = {0x67452301, 0xEFCDAB89,
+                                              0x98BADCFE, 0x10325476};
+
+// Round constants and rotations of MD5, one per round.
+inline constexpr std::uint32_t kMd5K[64] = {
+    0xD76AA478, 0xE8C7B756, 0x242070DB, 0xC1BDCEEE, 0xF57C0FAF, 0x4787C62A,
+    0xA8304613, 0xFD469501, 0x698098D8, 0x8B44F7AF, 0xFFFF5BB1, 0x895CD7BE,
+    0x6B901122, 0xFD987193, 0xA679438E, 0x49B40821, 0xF61E2562, 0xC040B340,
+    0x265E5A51, 0xE9B6C7AA, 0xD62F105D, 0x02441453, 0xD8A1E681, 0xE7D3FBC8,
+    0x21E1CDE6, 0xC33707D6, 0xF4D50D87, 0x455A14ED, 0xA9E3E905, 0xFCEFA3F8,
+    0x676F02D9, 0x8D2A4C8A, 0xFFFA3942, 0x8771F681, 0x6D9D6122, 0xFDE5380C,
+    0xA4BEEA44, 0x4BDECFA9, 0xF6BB4B60, 0xBEBFBC70, 0x289B7EC6, 0xEAA127FA,
+    0xD4EF3085, 0x04881D05, 0xD9D4D039, 0xE6DB99E5, 0x1FA27CF8, 0xC4AC5665,
+    0xF4292244, 0x432AFF97, 0xAB9423A7, 0xFC93A039, 0x655B59C3, 0x8F0CCC92,
+    0xFFEFF47D, 0x85845DD1, 0x6FA87E4F, 0xFE2CE6E0, 0xA3014314, 0x4E0811A1,
+    0xF7537E82, 0xBD3AF235, 0x2AD7D2BB, 0xEB86D391};
+inline constexpr int kMd5Shift[64] = {
+    7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+    5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20,
+    4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+    6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21};
+
+// Index of the message word used in MD5 round i.
+constexpr int Md5Word(int i) {
+  switch (i / 16) {
+  case 0:
+    return i;
+  case 1:
+    return (5 * i + 1) % 16;
+  case 2:
+    return (3 * i + 5) % 16;
+  default:
+    return (7 * i) % 16;
+  }
+}
+
+using BlockKernel = void (*)(std::uint32_t *state, const std::uint8_t *block);
+using LanesKernel = void (*)(std::uint32_t *state, const std::uint8_t *blocks);
+
+void Sha1BlockScalar(std::uint32_t *state, const std::uint8_t *block);
+void Md5BlockScalar(std::uint32_t *state, const std::uint8_t *block);
+
+#ifdef ANDYCCS_ARCH_X86
+void Sha1BlockShaNi(std::uint32_t *state, const std::uint8_t *block);
+void Sha1LanesAvx2(std::uint32_t *state, const std::uint8_t *blocks);
+void Md5LanesAvx2(std::uint32_t *state, const std::uint8_t *blocks);
+#endif
+
+} // namespace internal
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_NAME_KERNELS_H
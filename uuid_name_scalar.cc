@@ -0,0 +1,97 @@
+#include <bit>
+#include <cstdint>
+
+#include "uuid_name_kernels.h"
+
+namespace andyccs {
+namespace internal {
+
+// Portable kernels, used on CPUs without SHA-NI or AVX2 and on other
+// architectures.
+
+void Sha1BlockScalar(std::uint32_t *state, const std::uint8_t *block) {
+  // The last 16 words of the message schedule.
+  std::uint32_t w[16];
+  for (int t = 0; t < 16; ++t) {
+    w[t] = (std::uint32_t{block[4 * t]} << 24) |
+           (std::uint32_t{block[4 * t + 1]} << 16) |
+           (std::uint32_t{block[4 * t + 2]} << 8) | block[4 * t + 3];
+  }
+
+  std::uint32_t a = state[0];
+  std::uint32_t b = state[1];
+  std::uint32_t c = state[2];
+  std::uint32_t d = state[3];
+  std::uint32_t e = state[4];
+  auto round = [&](int t, std::uint32_t f) {
+    if (t >= 16) {
+      w[t % 16] = std::rotl(w[(t - 3) % 16] ^ w[(t - 8) % 16] ^
+                                w[(t - 14) % 16] ^ w[t % 16],
+                            1);
+    }
+    const std::uint32_t temp =
+        std::rotl(a, 5) + f + e + kSha1K[t / 20] + w[t % 16];
+    e = d;
+    d = c;
+    c = std::rotl(b, 30);
+    b = a;
+    a = temp;
+  };
+  for (int t = 0; t < 20; ++t) {
+    round(t, d ^ (b & (c ^ d)));
+  }
+  for (int t = 20; t < 40; ++t) {
+    round(t, b ^ c ^ d);
+  }
+  for (int t = 40; t < 60; ++t) {
+    round(t, (b & c) | (d & (b | c)));
+  }
+  for (int t = 60; t < 80; ++t) {
+    round(t, b ^ c ^ d);
+  }
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+}
+
+void Md5BlockScalar(std::uint32_t *state, const std::uint8_t *block) {
+  std::uint32_t m[16];
+  for (int t = 0; t < 16; ++t) {
+    m[t] = block[4 * t] | (std::uint32_t{block[4 * t + 1]} << 8) |
+           (std::uint32_t{block[4 * t + 2]} << 16) |
+           (std::uint32_t{block[4 * t + 3]} << 24);
+  }
+
+  std::uint32_t a = state[0];
+  std::uint32_t b = state[1];
+  std::uint32_t c = state[2];
+  std::uint32_t d = state[3];
+  auto round = [&](int i, std::uint32_t f) {
+    const std::uint32_t temp = d;
+    d = c;
+    c = b;
+    b += std::rotl(a + f + kMd5K[i] + m[Md5Word(i)], kMd5Shift[i]);
+    a = temp;
+  };
+  for (int i = 0; i < 16; ++i) {
+    round(i, d ^ (b & (c ^ d)));
+  }
+  for (int i = 16; i < 32; ++i) {
+    round(i, c ^ (d & (b ^ c)));
+  }
+  for (int i = 32; i < 48; ++i) {
+    round(i, b ^ c ^ d);
+  }
+  for (int i = 48; i < 64; ++i) {
+    round(i, c ^ (b | ~d));
+  }
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+}
+
+} // namespace internal
+} // namespace andyccs
@@ -0,0 +1,94 @@
+#include "uuid_name_kernels.h"
+
+#ifdef ANDYCCS_ARCH_X86
+
+#include <cstdint>
+#include <immintrin.h>
+
+namespace andyccs {
+namespace internal {
+namespace {
+
+// SHA-1 with the SHA extensions. sha1rnds4 runs 4 rounds on A, B, C and D,
+// which live in one register in reverse order, and sha1nexte derives E of the
+// next 4 rounds. The message schedule is computed 4 words at a time by
+// sha1msg1, a xor and sha1msg2, interleaved with the rounds that need them.
+//
+// Group G runs rounds 4 * G to 4 * G + 3. Message register G % 4 holds the
+// words of these rounds, and E alternates between e[0] and e[1].
+template <int G>
+ANDYCCS_TARGET_SHA inline __attribute__((always_inline)) void
+Sha1Group(__m128i &abcd, __m128i (&e)[2], __m128i (&msg)[4]) {
+  __m128i &current = e[G % 2];
+  __m128i &next = e[(G + 1) % 2];
+  current = _mm_sha1nexte_epu32(current, msg[G % 4]);
+  next = abcd;
+  if constexpr (G >= 3 && G <= 18) {
+    msg[(G + 1) % 4] = _mm_sha1msg2_epu32(msg[(G + 1) % 4], msg[G % 4]);
+  }
+  abcd = _mm_sha1rnds4_epu32(abcd, current, G / 5);
+  if constexpr (G >= 1 && G <= 16) {
+    msg[(G + 3) % 4] = _mm_sha1msg1_epu32(msg[(G + 3) % 4], msg[G % 4]);
+  }
+  if constexpr (G >= 2 && G <= 17) {
+    msg[(G + 2) % 4] = _mm_xor_si128(msg[(G + 2) % 4], msg[G % 4]);
+  }
+}
+
+} // namespace
+
+ANDYCCS_TARGET_SHA void Sha1BlockShaNi(std::uint32_t *state,
+                                       const std::uint8_t *block) {
+  // Loads the big-endian message words.
+  const __m128i kByteSwap =
+      _mm_set_epi64x(0x0001020304050607, 0x08090A0B0C0D0E0F);
+
+  const __m128i abcd_save = _mm_shuffle_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(state)), 0x1B);
+  const __m128i e_save = _mm_set_epi32(state[4], 0, 0, 0);
+
+  __m128i msg[4];
+  for (int i = 0; i < 4; ++i) {
+    msg[i] = _mm_shuffle_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(block) + i),
+        kByteSwap);
+  }
+
+  // Rounds 0 to 3 add E to the message words themselves.
+  __m128i abcd = abcd_save;
+  __m128i e[2];
+  e[0] = _mm_add_epi32(e_save, msg[0]);
+  e[1] = abcd;
+  abcd = _mm_sha1rnds4_epu32(abcd, e[0], 0);
+
+  Sha1Group<1>(abcd, e, msg);
+  Sha1Group<2>(abcd, e, msg);
+  Sha1Group<3>(abcd, e, msg);
+  Sha1Group<4>(abcd, e, msg);
+  Sha1Group<5>(abcd, e, msg);
+  Sha1Group<6>(abcd, e, msg);
+  Sha1Group<7>(abcd, e, msg);
+  Sha1Group<8>(abcd, e, msg);
+  Sha1Group<9>(abcd, e, msg);
+  Sha1Group<10>(abcd, e, msg);
+  Sha1Group<11>(abcd, e, msg);
+  Sha1Group<12>(abcd, e, msg);
+  Sha1Group<13>(abcd, e, msg);
+  Sha1Group<14>(abcd, e, msg);
+  Sha1Group<15>(abcd, e, msg);
+  Sha1Group<16>(abcd, e, msg);
+  Sha1Group<17>(abcd, e, msg);
+  Sha1Group<18>(abcd, e, msg);
+  Sha1Group<19>(abcd, e, msg);
+
+  e[0] = _mm_sha1nexte_epu32(e[0], e_save);
+  abcd = _mm_add_epi32(abcd, abcd_save);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(state),
+                   _mm_shuffle_epi32(abcd, 0x1B));
+  state[4] = _mm_extract_epi32(e[0], 3);
+}
+
+} // namespace internal
+} // namespace andyccs
+
+#endif
@@ -0,0 +1,131 @@
+#include "uuid_name.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace andyccs {
+
+// Expected UUIDs of "x" repeated `size` times, from Python's uuid module.
+// The sizes cover the block boundaries once the 16 bytes of the namespace and
+// the 9 bytes of padding are added.
+struct NameTestCase {
+  std::size_t size;
+  std::string_view v5_dns;
+  std::string_view v3_url;
+};
+
+constexpr NameTestCase kNameTestCases[] = {
+    {0, "4EBD0208-8328-5D69-8C44-EC50939C0967",
+     "14CDB9B4-DE01-3FAA-AFF5-65BC2F771745"},
+    {1, "05B16A01-46C6-56DD-BD6E-C6DFB4A1427A",
+     "60A7F89C-E446-309C-8B4F-460BFDFD0DEE"},
+    {39, "2F80C0D1-1C62-579F-8D68-E61AD5592C9B",
+     "E16D2328-75D6-3E79-BB28-B9CCC969AAB3"},
+    {40, "E56FD57A-7633-5E1D-8F80-70E05AC413E5",
+     "3AD4FE72-4126-38AF-BB25-E69264D2D7EA"},
+    {47, "A112377B-8258-5EF7-B5B0-D2540BC03ABB",
+     "99ED5079-0CB3-3A62-A6E4-181B7AD0A318"},
+    {48, "83993B6C-DEA9-55CA-BE5B-9989C85943FC",
+     "1F6DBC6B-3851-3055-94B9-8FF49F6CCAEB"},
+    {55, "4C506C2A-C3A2-508B-B2CE-25C3A06BF481",
+     "C99EBE9D-FD08-3F20-A6E8-B703B70E9B42"},
+    {56, "F1B9151E-183C-58B7-B276-8DAFD14A10B6",
+     "EDE5989B-3103-3473-A5CA-54BAA5BB5B32"},
+    {111, "1A48738A-DC98-5032-BF56-974C361D949D",
+     "D2CA334A-D212-3A13-B1FD-DC1E34F64168"},
+    {1000, "F6D12730-A238-51ED-BF69-3689855F9BBF",
+     "BA1E1CDF-2D61-3212-BAF9-16264E17408A"},
+};
+
+TEST(NameUuid, RfcExampleV5) {
+  EXPECT_EQ(std::string(NameUuidV5(kNamespaceDns, "www.example.com")),
+            "2ED6657D-E927-568B-95E1-2665A8AEA6A2");
+}
+
+TEST(NameUuid, RfcExampleV3) {
+  EXPECT_EQ(std::string(NameUuidV3(kNamespaceDns, "www.example.com")),
+            "5DF41881-3AED-3515-88A7-2F4A814CF09E");
+}
+
+TEST(NameUuid, VersionAndVariant) {
+  EXPECT_EQ(NameUuidV5(kNamespaceUrl, "https://example.com").version(), 5);
+  EXPECT_EQ(NameUuidV3(kNamespaceUrl, "https://example.com").version(), 3);
+  EXPECT_EQ(NameUuidV5(kNamespaceOid, "1.3.6.1").low() >> 62, 0b10u);
+  EXPECT_EQ(NameUuidV3(kNamespaceX500, "CN=example").low() >> 62, 0b10u);
+}
+
+TEST(NameUuid, Namespaces) {
+  EXPECT_EQ(std::string(kNamespaceDns), "6BA7B810-9DAD-11D1-80B4-00C04FD430C8");
+  EXPECT_EQ(std::string(kNamespaceUrl), "6BA7B811-9DAD-11D1-80B4-00C04FD430C8");
+  EXPECT_EQ(std::string(kNamespaceOid), "6BA7B812-9DAD-11D1-80B4-00C04FD430C8");
+  EXPECT_EQ(std::string(kNamespaceX500),
+            "6BA7B814-9DAD-11D1-80B4-00C04FD430C8");
+  EXPECT_NE(NameUuidV5(kNamespaceDns, "example"),
+            NameUuidV5(kNamespaceUrl, "example"));
+}
+
+TEST(NameUuid, BlockBoundaries) {
+  for (const NameTestCase &test_case : kNameTestCases) {
+    const std::string name(test_case.size, 'x');
+    EXPECT_EQ(std::string(NameUuidV5(kNamespaceDns, name)), test_case.v5_dns)
+        << test_case.size;
+    EXPECT_EQ(std::string(NameUuidV3(kNamespaceUrl, name)), test_case.v3_url)
+        << test_case.size;
+  }
+}
+
+TEST(NameUuid, Batch) {
+  // More names than lanes, of different lengths, so that lanes finish at
+  // different times.
+  std::vector<std::string> storage;
+  std::vector<std::string_view> expected_v5;
+  std::vector<std::string_view> expected_v3;
+  for (int repeat = 0; repeat < 3; ++repeat) {
+    for (const NameTestCase &test_case : kNameTestCases) {
+      storage.emplace_back(test_case.size, 'x');
+      expected_v5.push_back(test_case.v5_dns);
+      expected_v3.push_back(test_case.v3_url);
+    }
+  }
+  std::vector<std::string_view> names(storage.begin(), storage.end());
+
+  std::vector<SimdUuid> v5(names.size());
+  NameUuidsV5(kNamespaceDns, names, v5);
+  std::vector<SimdUuid> v3(names.size());
+  NameUuidsV3(kNamespaceUrl, names, v3);
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    EXPECT_EQ(std::string(v5[i]), expected_v5[i]) << i;
+    EXPECT_EQ(std::string(v3[i]), expected_v3[i]) << i;
+  }
+}
+
+TEST(NameUuid, BatchMatchesSingle) {
+  std::vector<std::string> storage;
+  for (int i = 0; i < 200; ++i) {
+    storage.push_back("record-" + std::to_string(i * i) +
+                      std::string(i % 70, 'a' + i % 26));
+  }
+  std::vector<std::string_view> names(storage.begin(), storage.end());
+
+  // Every batch size, including the ones smaller than the number of lanes.
+  for (std::size_t size : {0, 1, 7, 8, 9, 17, 200}) {
+    std::vector<SimdUuid> v5(size);
+    NameUuidsV5(kNamespaceOid, std::span(names).first(size), v5);
+    std::vector<SimdUuid> v3(size);
+    NameUuidsV3(kNamespaceOid, std::span(names).first(size), v3);
+    for (std::size_t i = 0; i < size; ++i) {
+      EXPECT_EQ(v5[i], NameUuidV5(kNamespaceOid, names[i])) << size << " " << i;
+      EXPECT_EQ(v3[i], NameUuidV3(kNamespaceOid, names[i])) << size << " " << i;
+    }
+  }
+}
+
+TEST(NameUuid, BatchShorterResult) {
+  std::vector<std::string_view> names = {"a", "b", "c"};
+  std::vector<SimdUuid> result(2);
+  NameUuidsV5(kNamespaceDns, names, result);
+  EXPECT_EQ(result[1], NameUuidV5(kNamespaceDns, "b"));
+}
+
+} // namespace andyccs
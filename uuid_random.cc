@@ -0,0 +1,259 @@
+#include "uuid_random.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <system_error>
+
+#include "uuid_cpu.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sys/random.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+#ifdef ANDYCCS_ARCH_X86
+#include <immintrin.h>
+#endif
+
+namespace andyccs {
+namespace {
+
+constexpr std::size_t kLanes = Xoshiro256StarStarX8::kLanes;
+
+using State = std::array<std::uint64_t, 4 * kLanes>;
+
+constexpr std::uint64_t RotateLeft(std::uint64_t x, int k) {
+  return (x << k) | (x >> (64 - k));
+}
+
+// Kernels write `steps` * kLanes words to `out`.
+using FillKernel = void (*)(State &state, std::size_t steps,
+                            std::uint64_t *out);
+
+void FillScalar(State &state, std::size_t steps, std::uint64_t *out) {
+  std::uint64_t *s0 = &state[0 * kLanes];
+  std::uint64_t *s1 = &state[1 * kLanes];
+  std::uint64_t *s2 = &state[2 * kLanes];
+  std::uint64_t *s3 = &state[3 * kLanes];
+  for (std::size_t step = 0; step < steps; ++step) {
+    for (std::size_t i = 0; i < kLanes; ++i) {
+      out[step * kLanes + i] = RotateLeft(s1[i] * 5, 7) * 9;
+      const std::uint64_t t = s1[i] << 17;
+      s2[i] ^= s0[i];
+      s3[i] ^= s1[i];
+      s1[i] ^= s2[i];
+      s0[i] ^= s3[i];
+      s2[i] ^= t;
+      s3[i] = RotateLeft(s3[i], 45);
+    }
+  }
+}
+
+#ifdef ANDYCCS_ARCH_X86
+
+// AVX2 has no 64-bit multiplication or rotation, but multiplying by 5 and 9 is
+// a shift and an add, and a rotation is two shifts.
+ANDYCCS_TARGET_AVX2 inline __m256i RotateLeft256(__m256i x, int k) {
+  return _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - k));
+}
+
+ANDYCCS_TARGET_AVX2 inline __m256i Next256(__m256i &s0, __m256i &s1,
+                                           __m256i &s2, __m256i &s3) {
+  __m256i times_5 = _mm256_add_epi64(s1, _mm256_slli_epi64(s1, 2));
+  __m256i rotated = RotateLeft256(times_5, 7);
+  __m256i result = _mm256_add_epi64(rotated, _mm256_slli_epi64(rotated, 3));
+
+  __m256i t = _mm256_slli_epi64(s1, 17);
+  s2 = _mm256_xor_si256(s2, s0);
+  s3 = _mm256_xor_si256(s3, s1);
+  s1 = _mm256_xor_si256(s1, s2);
+  s0 = _mm256_xor_si256(s0, s3);
+  s2 = _mm256_xor_si256(s2, t);
+  s3 = RotateLeft256(s3, 45);
+  return result;
+}
+
+ANDYCCS_TARGET_AVX2 void FillAvx2(State &state, std::size_t steps,
+                                  std::uint64_t *out) {
+  // Lanes 0..3 and 4..7 in two sets of registers.
+  __m256i *words = reinterpret_cast<__m256i *>(state.data());
+  __m256i a0 = _mm256_load_si256(words + 0);
+  __m256i b0 = _mm256_load_si256(words + 1);
+  __m256i a1 = _mm256_load_si256(words + 2);
+  __m256i b1 = _mm256_load_si256(words + 3);
+  __m256i a2 = _mm256_load_si256(words + 4);
+  __m256i b2 = _mm256_load_si256(words + 5);
+  __m256i a3 = _mm256_load_si256(words + 6);
+  __m256i b3 = _mm256_load_si256(words + 7);
+  for (std::size_t step = 0; step < steps; ++step) {
+    __m256i *result = reinterpret_cast<__m256i *>(out + step * kLanes);
+    _mm256_storeu_si256(result, Next256(a0, a1, a2, a3));
+    _mm256_storeu_si256(result + 1, Next256(b0, b1, b2, b3));
+  }
+  _mm256_store_si256(words + 0, a0);
+  _mm256_store_si256(words + 1, b0);
+  _mm256_store_si256(words + 2, a1);
+  _mm256_store_si256(words + 3, b1);
+  _mm256_store_si256(words + 4, a2);
+  _mm256_store_si256(words + 5, b2);
+  _mm256_store_si256(words + 6, a3);
+  _mm256_store_si256(words + 7, b3);
+}
+
+// GCC 12 warns about the undefined vectors inside AVX-512 shift intrinsics when
+// they are inlined into a function with a target attribute.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// AVX-512 has 64-bit rotations, and all 8 lanes fit in one register.
+ANDYCCS_TARGET_AVX512 void FillAvx512(State &state, std::size_t steps,
+                                      std::uint64_t *out) {
+  __m512i s0 = _mm512_load_si512(&state[0 * kLanes]);
+  __m512i s1 = _mm512_load_si512(&state[1 * kLanes]);
+  __m512i s2 = _mm512_load_si512(&state[2 * kLanes]);
+  __m512i s3 = _mm512_load_si512(&state[3 * kLanes]);
+  for (std::size_t step = 0; step < steps; ++step) {
+    __m512i times_5 = _mm512_add_epi64(s1, _mm512_slli_epi64(s1, 2));
+    __m512i rotated = _mm512_rol_epi64(times_5, 7);
+    __m512i result = _mm512_add_epi64(rotated, _mm512_slli_epi64(rotated, 3));
+    _mm512_storeu_si512(out + step * kLanes, result);
+
+    __m512i t = _mm512_slli_epi64(s1, 17);
+    s2 = _mm512_xor_si512(s2, s0);
+    s3 = _mm512_xor_si512(s3, s1);
+    s1 = _mm512_xor_si512(s1, s2);
+    s0 = _mm512_xor_si512(s0, s3);
+    s2 = _mm512_xor_si512(s2, t);
+    s3 = _mm512_rol_epi64(s3, 45);
+  }
+  _mm512_store_si512(&state[0 * kLanes], s0);
+  _mm512_store_si512(&state[1 * kLanes], s1);
+  _mm512_store_si512(&state[2 * kLanes], s2);
+  _mm512_store_si512(&state[3 * kLanes], s3);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
+
+FillKernel ActiveFillKernel() {
+  switch (ActiveCpuIsa()) {
+#ifdef ANDYCCS_ARCH_X86
+  case CpuIsa::kAvx512:
+    return &FillAvx512;
+  case CpuIsa::kAvx2:
+    return &FillAvx2;
+#endif
+  default:
+    return &FillScalar;
+  }
+}
+
+constexpr std::size_t kSecureRandomBufferSize = 32 * 1024;
+
+// Wipes and frees the buffer of SecureRandom when its thread exits.
+struct SecureRandomBufferOwner {
+  ~SecureRandomBufferOwner() {
+    internal::SecureRandomBuffer &buffer = internal::secure_random_buffer;
+    if (buffer.bytes != nullptr) {
+      std::memset(buffer.bytes, 0, kSecureRandomBufferSize);
+      delete[] buffer.bytes;
+      buffer = {};
+    }
+  }
+};
+
+thread_local SecureRandomBufferOwner secure_random_buffer_owner;
+
+void OnFork() {
+  internal::fork_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+namespace internal {
+
+thread_local SecureRandomBuffer secure_random_buffer;
+
+std::atomic<std::uint64_t> fork_generation{0};
+
+void RefillSecureRandomBuffer(SecureRandomBuffer &buffer) {
+#if defined(__unix__) || defined(__APPLE__)
+  static std::once_flag register_fork_handler;
+  std::call_once(register_fork_handler,
+                 [] { pthread_atfork(nullptr, nullptr, &OnFork); });
+#endif
+  if (buffer.bytes == nullptr) {
+    // Make sure the buffer is freed when the thread exits.
+    (void)&secure_random_buffer_owner;
+    buffer.bytes = new std::uint8_t[kSecureRandomBufferSize];
+  }
+  buffer.fork_generation = fork_generation.load(std::memory_order_relaxed);
+  // Bytes left over from before a fork may also be in use by the parent.
+  SecureRandom::Fill(std::span(buffer.bytes, kSecureRandomBufferSize));
+  buffer.remaining = kSecureRandomBufferSize;
+}
+
+} // namespace internal
+
+void SecureRandom::Fill(std::span<std::uint8_t> bytes) {
+#if defined(__linux__)
+  // getrandom returns at most 32 MB per call, and may be interrupted.
+  while (!bytes.empty()) {
+    ssize_t size = getrandom(bytes.data(), bytes.size(), 0);
+    if (size < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::system_error(errno, std::generic_category(), "getrandom");
+    }
+    bytes = bytes.subspan(size);
+  }
+#else
+  std::random_device random_device;
+  for (std::size_t i = 0; i < bytes.size(); i += 4) {
+    const std::uint32_t word = random_device();
+    std::memcpy(bytes.data() + i, &word, std::min<std::size_t>(4, bytes.size() - i));
+  }
+#endif
+}
+
+Xoshiro256StarStarX8::Xoshiro256StarStarX8(
+    std::span<const std::uint64_t, 4 * kLanes> state) {
+  std::copy(state.begin(), state.end(), state_.begin());
+  for (std::size_t i = 0; i < kLanes; ++i) {
+    if ((state_[i] | state_[kLanes + i] | state_[2 * kLanes + i] |
+         state_[3 * kLanes + i]) == 0) {
+      state_[i] = 0x9E3779B97F4A7C15 + i;
+    }
+  }
+}
+
+Xoshiro256StarStarX8::Xoshiro256StarStarX8(std::uint64_t seed) {
+  for (std::uint64_t &word : state_) {
+    word = internal::SplitMix64(seed);
+  }
+}
+
+void Xoshiro256StarStarX8::Fill(std::span<std::uint64_t> out) {
+  static const FillKernel kFill = ActiveFillKernel();
+  const std::size_t steps = out.size() / kLanes;
+  if (steps > 0) {
+    kFill(state_, steps, out.data());
+  }
+  if (const std::size_t rest = out.size() % kLanes; rest > 0) {
+    std::uint64_t last[kLanes];
+    kFill(state_, 1, last);
+    std::memcpy(out.data() + steps * kLanes, last, rest * sizeof(last[0]));
+  }
+}
+
+} // namespace andyccs
@@ -0,0 +1,388 @@
+#ifndef ANDYCCS_UUID_RANDOM_H
+#define ANDYCCS_UUID_RANDOM_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <span>
+#include <type_traits>
+
+#include "uuid_hash.h"
+
+namespace andyccs {
+
+// Small and fast random engines for UuidGenerator, BasicUuidGenerator and
+// SimdUuidGenerator. std::mt19937_64 has 2.5 KB of state, which makes a
+// generator per thread or per coroutine costly to create and to keep in cache.
+// These engines have 8 to 32 bytes of state and produce full 64-bit words, so
+// the generators use them without a distribution, e.g.
+//
+// UuidGenerator<Xoshiro256StarStar> generator;
+//
+// They pass BigCrush and PractRand, but they are not cryptographically secure:
+// their output is predictable after observing a few UUIDs.
+//
+// They satisfy std::uniform_random_bit_generator, and can be seeded with a
+// 64-bit value or with a seed sequence, like the std engines.
+
+namespace internal {
+
+inline std::uint64_t SplitMix64(std::uint64_t &state) {
+  std::uint64_t z = (state += 0x9E3779B97F4A7C15);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+  return z ^ (z >> 31);
+}
+
+// Fills `words` with the output of a seed sequence.
+template <class SeedSeq, std::size_t N>
+void GenerateSeed(SeedSeq &seed_seq, std::array<std::uint64_t, N> &words) {
+  std::array<std::uint32_t, N * 2> seed;
+  seed_seq.generate(seed.begin(), seed.end());
+  for (std::size_t i = 0; i < N; ++i) {
+    words[i] = (static_cast<std::uint64_t>(seed[i * 2]) << 32) | seed[i * 2 + 1];
+  }
+}
+
+// Seed sequences fill a range of 32-bit words, as std::seed_seq does. The
+// engines themselves do not, so copying one from a non-const lvalue still
+// calls its copy constructor.
+template <class T>
+concept SeedSequence =
+    !std::is_convertible_v<T, std::uint64_t> &&
+    requires(T &seed_seq, std::uint32_t *words) {
+      seed_seq.generate(words, words);
+    };
+
+} // namespace internal
+
+// xoshiro256** by David Blackman and Sebastiano Vigna. 32 bytes of state and a
+// period of 2^256 - 1.
+class Xoshiro256StarStar {
+public:
+  using result_type = std::uint64_t;
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  explicit Xoshiro256StarStar(std::uint64_t seed = 0) {
+    for (std::uint64_t &word : state_) {
+      word = internal::SplitMix64(seed);
+    }
+  }
+
+  template <internal::SeedSequence SeedSeq>
+  explicit Xoshiro256StarStar(SeedSeq &seed_seq) {
+    internal::GenerateSeed(seed_seq, state_);
+    if ((state_[0] | state_[1] | state_[2] | state_[3]) == 0) {
+      state_[0] = 1;
+    }
+  }
+
+  result_type operator()() {
+    const std::uint64_t result = std::rotl(state_[1] * 5, 7) * 9;
+    const std::uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = std::rotl(state_[3], 45);
+    return result;
+  }
+
+private:
+  std::array<std::uint64_t, 4> state_;
+};
+
+// wyrand by Wang Yi. 8 bytes of state, one multiplication per word, and a
+// period of 2^64.
+class WyRand {
+public:
+  using result_type = std::uint64_t;
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  explicit WyRand(std::uint64_t seed = 0) : state_(seed) {}
+
+  template <internal::SeedSequence SeedSeq>
+  explicit WyRand(SeedSeq &seed_seq) {
+    std::array<std::uint64_t, 1> seed;
+    internal::GenerateSeed(seed_seq, seed);
+    state_ = seed[0];
+  }
+
+  result_type operator()() {
+    // Constants of the final version of wyhash.
+    state_ += 0x2D358DCCAA6C78A5;
+    return internal::MultiplyFold(state_, state_ ^ 0x8BB84B93962EACC9);
+  }
+
+private:
+  std::uint64_t state_;
+};
+
+#if defined(__SIZEOF_INT128__)
+
+// PCG64, i.e. PCG XSL RR 128/64 by Melissa O'Neill, as in NumPy. 32 bytes of
+// state, a period of 2^128 and 2^127 independent streams.
+class Pcg64 {
+public:
+  using result_type = std::uint64_t;
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  explicit Pcg64(std::uint64_t seed = 0) {
+    std::uint64_t state = seed;
+    Seed(Make128(internal::SplitMix64(state), internal::SplitMix64(state)),
+         Make128(internal::SplitMix64(state), internal::SplitMix64(state)));
+  }
+
+  // Same as pcg64(state, stream) in the reference implementation.
+  Pcg64(__uint128_t state, __uint128_t stream) { Seed(state, stream); }
+
+  template <internal::SeedSequence SeedSeq> explicit Pcg64(SeedSeq &seed_seq) {
+    std::array<std::uint64_t, 4> seed;
+    internal::GenerateSeed(seed_seq, seed);
+    Seed(Make128(seed[0], seed[1]), Make128(seed[2], seed[3]));
+  }
+
+  result_type operator()() {
+    state_ = state_ * kMultiplier + increment_;
+    const std::uint64_t xored = static_cast<std::uint64_t>(state_ >> 64) ^
+                                static_cast<std::uint64_t>(state_);
+    return std::rotr(xored, static_cast<int>(state_ >> 122));
+  }
+
+private:
+  static constexpr __uint128_t Make128(std::uint64_t high, std::uint64_t low) {
+    return (static_cast<__uint128_t>(high) << 64) | low;
+  }
+
+  static constexpr __uint128_t kMultiplier =
+      (static_cast<__uint128_t>(0x2360ED051FC65DA4) << 64) |
+      0x4385DF649FCCF645;
+
+  // Same as pcg_setseq_128_srandom_r in the reference implementation.
+  void Seed(__uint128_t state, __uint128_t stream) {
+    state_ = 0;
+    increment_ = (stream << 1) | 1;
+    (*this)();
+    state_ += state;
+    (*this)();
+  }
+
+  __uint128_t state_;
+  __uint128_t increment_;
+};
+
+#endif
+
+namespace internal {
+
+// Per-thread buffer of SecureRandom. It is trivially constructible, so that
+// accessing it is a plain thread-local load. The bytes are allocated on the
+// first refill.
+struct SecureRandomBuffer {
+  std::uint8_t *bytes;
+  // Bytes not handed out yet, at the beginning of `bytes`.
+  std::size_t remaining;
+  // Value of fork_generation when the buffer was filled.
+  std::uint64_t fork_generation;
+};
+
+extern thread_local SecureRandomBuffer secure_random_buffer;
+
+// Incremented in child processes after fork.
+extern std::atomic<std::uint64_t> fork_generation;
+
+void RefillSecureRandomBuffer(SecureRandomBuffer &buffer);
+
+} // namespace internal
+
+// Cryptographically secure random engine for UUIDs that must not be guessed,
+// e.g. session ids or externally visible tokens:
+//
+// UuidGenerator<SecureRandom> generator;
+//
+// Random bytes come from the operating system (getrandom on Linux) into a
+// 32 KB buffer per thread, so one system call serves 2048 UUIDs. Bytes are
+// wiped from the buffer as they are handed out, and the buffer is dropped in
+// child processes after fork, so that parent and child never share UUIDs.
+//
+// All the SecureRandom objects of a thread share its buffer, so SecureRandom
+// is an empty object, and needs no seed.
+class SecureRandom {
+public:
+  using result_type = std::uint64_t;
+
+  // Generators use this engine as it is, even for bulk generation.
+  static constexpr bool kCryptographicallySecure = true;
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    internal::SecureRandomBuffer &buffer = internal::secure_random_buffer;
+    if (buffer.remaining < sizeof(result_type) ||
+        buffer.fork_generation !=
+            internal::fork_generation.load(std::memory_order_relaxed))
+        [[unlikely]] {
+      internal::RefillSecureRandomBuffer(buffer);
+    }
+    buffer.remaining -= sizeof(result_type);
+    result_type result;
+    std::memcpy(&result, buffer.bytes + buffer.remaining, sizeof(result));
+    std::memset(buffer.bytes + buffer.remaining, 0, sizeof(result));
+    return result;
+  }
+
+  // Fills `bytes` with random bytes from the operating system, without going
+  // through the buffer. Throws std::system_error if the operating system
+  // fails to provide them.
+  static void Fill(std::span<std::uint8_t> bytes);
+};
+
+namespace internal {
+
+// Seeds a random engine with random_device. Engines that take a seed sequence,
+// like the std ones, get their whole state seeded, so that engines seeded at
+// the same time, e.g. by many threads, do not end up with the same sequence.
+template <class RNG> RNG SeedRandomEngine() {
+  std::random_device random_device;
+  if constexpr (std::is_constructible_v<RNG, std::seed_seq &>) {
+    std::array<std::uint32_t, 8> seed;
+    for (std::uint32_t &word : seed) {
+      word = random_device();
+    }
+    std::seed_seq seed_seq(seed.begin(), seed.end());
+    return RNG(seed_seq);
+  } else if constexpr (std::is_constructible_v<RNG, std::uint32_t>) {
+    return RNG(random_device());
+  } else {
+    // Engines that seed themselves, like SecureRandom.
+    return RNG();
+  }
+}
+
+// Draws uniformly distributed 64-bit words from RNG, through
+// std::uniform_int_distribution.
+template <class RNG> class Uniform64 {
+public:
+  std::uint64_t operator()(RNG &generator) { return distribution_(generator); }
+
+private:
+  std::uniform_int_distribution<std::uint64_t> distribution_{
+      std::numeric_limits<std::uint64_t>::min(),
+      std::numeric_limits<std::uint64_t>::max()};
+};
+
+// Engines that already produce full 64-bit words, like std::mt19937_64 and the
+// engines above, are used as they are.
+template <class RNG>
+  requires(RNG::min() == 0 &&
+           RNG::max() == std::numeric_limits<std::uint64_t>::max())
+class Uniform64<RNG> {
+public:
+  std::uint64_t operator()(RNG &generator) { return generator(); }
+};
+
+} // namespace internal
+
+// Eight independent xoshiro256** generators, stepped together. Eight lanes of
+// 64 bits fill two AVX2 or one AVX-512 register, so one step produces 8 random
+// words with a handful of instructions. Fill picks the widest kernel supported
+// by the CPU at runtime; every kernel produces the same sequence.
+//
+// This is meant for bulk generation, e.g. GenerateUuids. It is not
+// cryptographically secure.
+class Xoshiro256StarStarX8 {
+public:
+  static constexpr std::size_t kLanes = 8;
+
+  // Seeds the generators with `state`, word j of lane i being
+  // state[j * kLanes + i]. Lanes whose state is all zeros, which xoshiro256**
+  // cannot leave, are set to a fixed non-zero state.
+  explicit Xoshiro256StarStarX8(
+      std::span<const std::uint64_t, 4 * kLanes> state);
+
+  // Seeds the generators with splitmix64(seed), as recommended by the authors
+  // of xoshiro256**.
+  explicit Xoshiro256StarStarX8(std::uint64_t seed);
+
+  // Fills `out` with random words. Each step of the generators produces
+  // kLanes words, so the last step may discard up to kLanes - 1 of them.
+  void Fill(std::span<std::uint64_t> out);
+
+private:
+  alignas(64) std::array<std::uint64_t, 4 * kLanes> state_;
+};
+
+namespace internal {
+
+// Fills `uuids` with random UUIDs. The words come from a
+// Xoshiro256StarStarX8 seeded with 32 draws of `distribution(generator)`, so
+// the output still depends on the whole state of `generator`.
+//
+// Seeding costs about as much as generating 16 UUIDs, so small spans are
+// generated one by one with `generator` instead. So are all the UUIDs of
+// cryptographically secure engines.
+template <class UuidT, class RNG, class Distribution>
+void GenerateUuids(std::span<UuidT> uuids, RNG &generator,
+                   Distribution &distribution) {
+  constexpr std::size_t kBulkThreshold = 64;
+  // Words of a Xoshiro256StarStarX8 can be predicted, even if its seed cannot.
+  constexpr bool kSecure = requires { requires RNG::kCryptographicallySecure; };
+  if (kSecure || uuids.size() < kBulkThreshold) {
+    for (UuidT &uuid : uuids) {
+      std::array<std::uint64_t, 2> words = {distribution(generator),
+                                            distribution(generator)};
+      std::array<std::uint8_t, 16> data;
+      std::memcpy(data.data(), words.data(), 16);
+      uuid = UuidT(data);
+    }
+    return;
+  }
+
+  std::array<std::uint64_t, 4 * Xoshiro256StarStarX8::kLanes> seed;
+  for (std::uint64_t &word : seed) {
+    word = distribution(generator);
+  }
+  Xoshiro256StarStarX8 bulk(seed);
+
+  // Generate in chunks that stay in the L1 cache.
+  constexpr std::size_t kChunk = 64;
+  std::array<std::uint64_t, kChunk * 2> words;
+  for (std::size_t begin = 0; begin < uuids.size(); begin += kChunk) {
+    const std::size_t count = std::min(kChunk, uuids.size() - begin);
+    bulk.Fill(std::span(words).first(count * 2));
+    for (std::size_t i = 0; i < count; ++i) {
+      std::array<std::uint8_t, 16> data;
+      std::memcpy(data.data(), &words[i * 2], 16);
+      uuids[begin + i] = UuidT(data);
+    }
+  }
+}
+
+} // namespace internal
+
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_RANDOM_H
@@ -0,0 +1,249 @@
+#include "uuid_random.h"
+
+#include <gtest/gtest.h>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace andyccs {
+
+// Reference implementation from https://prng.di.unimi.it/xoshiro256starstar.c
+class ReferenceXoshiro256StarStar {
+public:
+  explicit ReferenceXoshiro256StarStar(std::array<std::uint64_t, 4> state)
+      : s_(state) {}
+
+  std::uint64_t Next() {
+    const std::uint64_t result = RotateLeft(s_[1] * 5, 7) * 9;
+    const std::uint64_t t = s_[1] << 17;
+    s_[2] ^= s_[0];
+    s_[3] ^= s_[1];
+    s_[1] ^= s_[2];
+    s_[0] ^= s_[3];
+    s_[2] ^= t;
+    s_[3] = RotateLeft(s_[3], 45);
+    return result;
+  }
+
+private:
+  static std::uint64_t RotateLeft(std::uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  std::array<std::uint64_t, 4> s_;
+};
+
+std::array<std::uint64_t, 32> TestState() {
+  std::array<std::uint64_t, 32> state;
+  for (std::size_t i = 0; i < state.size(); ++i) {
+    state[i] = 0x0123456789ABCDEF * (i + 1);
+  }
+  return state;
+}
+
+// Returns the words that Xoshiro256StarStarX8(state) generates, computed lane
+// by lane with the reference implementation.
+std::vector<std::uint64_t> Expected(const std::array<std::uint64_t, 32> &state,
+                                    std::size_t steps) {
+  std::vector<std::uint64_t> expected(steps * 8);
+  for (std::size_t lane = 0; lane < 8; ++lane) {
+    ReferenceXoshiro256StarStar reference({state[lane], state[8 + lane],
+                                  state[16 + lane], state[24 + lane]});
+    for (std::size_t step = 0; step < steps; ++step) {
+      expected[step * 8 + lane] = reference.Next();
+    }
+  }
+  return expected;
+}
+
+TEST(Xoshiro256StarStarX8, SameAsReference) {
+  std::array<std::uint64_t, 32> state = TestState();
+  Xoshiro256StarStarX8 random(state);
+  std::vector<std::uint64_t> words(1000 * 8);
+  random.Fill(words);
+  EXPECT_EQ(words, Expected(state, 1000));
+}
+
+TEST(Xoshiro256StarStarX8, ManyFills) {
+  std::array<std::uint64_t, 32> state = TestState();
+  std::vector<std::uint64_t> expected = Expected(state, 3);
+
+  // The words that do not fit in `out` are discarded.
+  Xoshiro256StarStarX8 random(state);
+  std::vector<std::uint64_t> words(8);
+  random.Fill(std::span(words).first(3));
+  EXPECT_EQ(words[0], expected[0]);
+  EXPECT_EQ(words[2], expected[2]);
+  random.Fill(words);
+  EXPECT_EQ(words, std::vector(expected.begin() + 8, expected.begin() + 16));
+  random.Fill(std::span(words).first(0));
+  random.Fill(words);
+  EXPECT_EQ(words, std::vector(expected.begin() + 16, expected.begin() + 24));
+}
+
+TEST(Xoshiro256StarStarX8, ZeroState) {
+  std::array<std::uint64_t, 32> state = {};
+  Xoshiro256StarStarX8 random(state);
+  std::vector<std::uint64_t> words(64);
+  random.Fill(words);
+  for (std::uint64_t word : std::span(words).last(8)) {
+    EXPECT_NE(word, 0u);
+  }
+}
+
+TEST(Xoshiro256StarStarX8, Seed) {
+  Xoshiro256StarStarX8 random_1(42);
+  Xoshiro256StarStarX8 random_2(42);
+  Xoshiro256StarStarX8 random_3(43);
+  std::vector<std::uint64_t> words_1(16), words_2(16), words_3(16);
+  random_1.Fill(words_1);
+  random_2.Fill(words_2);
+  random_3.Fill(words_3);
+  EXPECT_EQ(words_1, words_2);
+  EXPECT_NE(words_1, words_3);
+}
+
+template <typename T> class RandomEngineTest : public testing::Test {};
+
+#if defined(__SIZEOF_INT128__)
+using RandomEngines = testing::Types<Xoshiro256StarStar, WyRand, Pcg64>;
+#else
+using RandomEngines = testing::Types<Xoshiro256StarStar, WyRand>;
+#endif
+TYPED_TEST_SUITE(RandomEngineTest, RandomEngines);
+
+TYPED_TEST(RandomEngineTest, UniformRandomBitGenerator) {
+  static_assert(std::uniform_random_bit_generator<TypeParam>);
+  static_assert(sizeof(TypeParam) <= 32);
+}
+
+TYPED_TEST(RandomEngineTest, Seed) {
+  TypeParam random_1(42);
+  TypeParam random_2(42);
+  TypeParam random_3(43);
+  std::uint64_t first_1 = random_1();
+  EXPECT_EQ(first_1, random_2());
+  EXPECT_NE(first_1, random_3());
+  EXPECT_NE(first_1, random_1());
+}
+
+TYPED_TEST(RandomEngineTest, SeedSequence) {
+  std::seed_seq seed_seq_1 = {1, 2, 3};
+  std::seed_seq seed_seq_2 = {1, 2, 3};
+  std::seed_seq seed_seq_3 = {1, 2, 4};
+  TypeParam random_1(seed_seq_1);
+  TypeParam random_2(seed_seq_2);
+  TypeParam random_3(seed_seq_3);
+  std::uint64_t first_1 = random_1();
+  EXPECT_EQ(first_1, random_2());
+  EXPECT_NE(first_1, random_3());
+}
+
+TYPED_TEST(RandomEngineTest, Copy) {
+  // Copied from a non-const lvalue, which is not a seed sequence.
+  static_assert(!internal::SeedSequence<TypeParam>);
+  TypeParam random(42);
+  random();
+  TypeParam copy(random);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(copy(), random()) << i;
+  }
+}
+
+TYPED_TEST(RandomEngineTest, BitsAreBalanced) {
+  // Every bit is set in about half of the words.
+  constexpr int kWords = 1 << 14;
+  TypeParam random(42);
+  std::array<int, 64> ones = {};
+  for (int i = 0; i < kWords; ++i) {
+    std::uint64_t word = random();
+    for (int bit = 0; bit < 64; ++bit) {
+      ones[bit] += (word >> bit) & 1;
+    }
+  }
+  for (int bit = 0; bit < 64; ++bit) {
+    EXPECT_NEAR(ones[bit], kWords / 2, kWords / 32) << "bit " << bit;
+  }
+}
+
+TEST(Xoshiro256StarStar, SameAsReference) {
+  // Seeded with splitmix64, as recommended by the authors.
+  std::uint64_t seed = 42;
+  std::array<std::uint64_t, 4> state;
+  for (std::uint64_t &word : state) {
+    seed += 0x9E3779B97F4A7C15;
+    std::uint64_t z = seed;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    word = z ^ (z >> 31);
+  }
+  ReferenceXoshiro256StarStar reference(state);
+  Xoshiro256StarStar random(42);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(random(), reference.Next());
+  }
+}
+
+#if defined(__SIZEOF_INT128__)
+TEST(Pcg64, SameAsReference) {
+  // From pcg64_random_demo in the reference implementation.
+  Pcg64 random(42, 54);
+  EXPECT_EQ(random(), 0x86B1DA1D72062B68);
+  EXPECT_EQ(random(), 0x1304AA46C9853D39);
+  EXPECT_EQ(random(), 0xA3670E9E0DD50358);
+}
+#endif
+
+TEST(SecureRandom, UniformRandomBitGenerator) {
+  static_assert(std::uniform_random_bit_generator<SecureRandom>);
+  static_assert(std::is_empty_v<SecureRandom>);
+}
+
+TEST(SecureRandom, NoRepeats) {
+  // Many times the size of the buffer.
+  SecureRandom random;
+  std::unordered_set<std::uint64_t> words;
+  for (int i = 0; i < 100000; ++i) {
+    words.insert(random());
+  }
+  EXPECT_EQ(words.size(), 100000u);
+}
+
+TEST(SecureRandom, Fill) {
+  std::vector<std::uint8_t> bytes_1(1000), bytes_2(1000);
+  SecureRandom::Fill(bytes_1);
+  SecureRandom::Fill(bytes_2);
+  EXPECT_NE(bytes_1, bytes_2);
+}
+
+#if defined(__linux__)
+TEST(SecureRandom, Fork) {
+  // The child must not hand out the bytes left in the buffer of the parent.
+  SecureRandom random;
+  random();
+
+  int pipe_fds[2];
+  ASSERT_EQ(pipe(pipe_fds), 0);
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    std::uint64_t word = random();
+    _exit(write(pipe_fds[1], &word, sizeof(word)) == sizeof(word) ? 0 : 1);
+  }
+  std::uint64_t parent_word = random();
+  std::uint64_t child_word = 0;
+  ASSERT_EQ(read(pipe_fds[0], &child_word, sizeof(child_word)),
+            static_cast<ssize_t>(sizeof(child_word)));
+  int status = 0;
+  waitpid(pid, &status, 0);
+  close(pipe_fds[0]);
+  close(pipe_fds[1]);
+  EXPECT_NE(parent_word, child_word);
+}
+#endif
+
+} // namespace andyccs
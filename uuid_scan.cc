@@ -0,0 +1,131 @@
+#include "uuid_scan.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+#include "uuid_cpu.h"
+#include "uuid_scan_kernels.h"
+#include "uuid_simd_kernels.h"
+
+namespace andyccs {
+namespace internal {
+
+const char *FindDashesScalar(const char *begin, const char *end) {
+  for (const char *p = begin; end - p >= 36; ++p) {
+    if (p[8] == '-' && p[13] == '-' && p[18] == '-' && p[23] == '-') {
+      return p;
+    }
+  }
+  return end;
+}
+
+} // namespace internal
+
+namespace {
+
+using internal::FindDashesKernel;
+
+FindDashesKernel ActiveFindDashesInternal() {
+#ifdef ANDYCCS_ARCH_X86
+  if (ActiveCpuIsa() >= CpuIsa::kAvx2) {
+    return &internal::FindDashesAvx2;
+  }
+#endif
+  return &internal::FindDashesScalar;
+}
+
+FindDashesKernel ActiveFindDashes() {
+  static const FindDashesKernel kKernel = ActiveFindDashesInternal();
+  return kKernel;
+}
+
+inline bool IsHexDigit(char c) {
+  return (c >= '0' && c <= '9') || ((c | 0x20) >= 'a' && (c | 0x20) <= 'f');
+}
+
+} // namespace
+
+std::optional<UuidMatch> FindUuid(std::string_view text, std::size_t from) {
+  if (from >= text.size()) {
+    return std::nullopt;
+  }
+  const FindDashesKernel find_dashes = ActiveFindDashes();
+  const auto from_chars = internal::ActiveKernels().from_chars;
+  const char *begin = text.data();
+  const char *end = begin + text.size();
+
+  // Candidates are rare in most texts, so they are checked one by one.
+  for (const char *p = find_dashes(begin + from, end); p != end;
+       p = find_dashes(p + 1, end)) {
+    if ((p != begin && IsHexDigit(p[-1])) ||
+        (end - p > 36 && IsHexDigit(p[36]))) {
+      continue;
+    }
+    std::array<std::uint8_t, 16> data;
+    if (from_chars(p, data.data())) {
+      return UuidMatch{static_cast<std::size_t>(p - begin), SimdUuid(data)};
+    }
+  }
+  return std::nullopt;
+}
+
+std::size_t ScanUuids(std::string_view text, std::vector<UuidMatch> &matches) {
+  std::size_t count = 0;
+  for (std::optional<UuidMatch> match = FindUuid(text); match.has_value();
+       match = FindUuid(text, match->offset + 36)) {
+    matches.push_back(*match);
+    ++count;
+  }
+  return count;
+}
+
+std::optional<MappedFile> MappedFile::Open(const std::string &path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return std::nullopt;
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0) {
+    close(fd);
+    return std::nullopt;
+  }
+  // mmap does not map empty files.
+  const std::size_t size = status.st_size;
+  if (size == 0) {
+    close(fd);
+    return MappedFile(nullptr, 0);
+  }
+  void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps the file open.
+  close(fd);
+  if (data == MAP_FAILED) {
+    return std::nullopt;
+  }
+  madvise(data, size, MADV_SEQUENTIAL);
+  return MappedFile(static_cast<const char *>(data), size);
+}
+
+MappedFile::MappedFile(MappedFile &&other)
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) {
+  // `other` unmaps the previous mapping of this file, if any.
+  std::swap(data_, other.data_);
+  std::swap(size_, other.size_);
+  return *this;
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char *>(data_), size_);
+  }
+}
+
+} // namespace andyccs
@@ -0,0 +1,71 @@
+#ifndef ANDYCCS_UUID_SCAN_H
+#define ANDYCCS_UUID_SCAN_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "uuid_simd.h"
+
+namespace andyccs {
+
+// A UUID found in a text, e.g. a log file.
+struct UuidMatch {
+  // Offset of the first character of the UUID in the text.
+  std::size_t offset = 0;
+  SimdUuid uuid;
+
+  bool operator==(const UuidMatch &other) const = default;
+};
+
+// Returns the first UUID of `text` that starts at or after `from`, or
+// std::nullopt if there is none.
+//
+// A UUID is 36 characters in the form of SimdUuid::FromString, with hex digits
+// in any case, that is neither preceded nor followed by a hex digit. Hex runs
+// longer than a UUID, e.g. "0" followed by a UUID, are not UUIDs.
+//
+// The text is scanned 64 bytes at a time with AVX2 for dashes at offsets 8, 13,
+// 18 and 23 of a candidate, and only candidates are parsed, with the SimdUuid
+// kernels. Text without dashes is skipped at the speed of memory.
+std::optional<UuidMatch> FindUuid(std::string_view text, std::size_t from = 0);
+
+// Appends every UUID of `text` to `matches`, in order, see FindUuid.
+//
+// Returns the number of UUIDs found.
+std::size_t ScanUuids(std::string_view text, std::vector<UuidMatch> &matches);
+
+// A read-only memory mapping of a whole file, to scan files larger than memory
+// without copying them, e.g.
+//
+//   std::optional<MappedFile> file = MappedFile::Open("app.log");
+//   ScanUuids(file->data(), matches);
+//
+// Pages are read by the kernel on demand, and hinted to be read sequentially.
+class MappedFile {
+public:
+  // Returns std::nullopt if the file cannot be opened or mapped.
+  static std::optional<MappedFile> Open(const std::string &path);
+
+  // Moveable only
+  MappedFile(MappedFile &&other);
+  MappedFile &operator=(MappedFile &&other);
+  MappedFile(const MappedFile &other) = delete;
+  MappedFile &operator=(const MappedFile &other) = delete;
+
+  ~MappedFile();
+
+  std::string_view data() const { return {data_, size_}; }
+
+private:
+  MappedFile(const char *data, std::size_t size) : data_(data), size_(size) {}
+
+  const char *data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_SCAN_H
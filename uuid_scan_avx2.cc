@@ -0,0 +1,48 @@
+#include "uuid_scan_kernels.h"
+
+#ifdef ANDYCCS_ARCH_X86
+
+#include <bit>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace andyccs {
+namespace internal {
+namespace {
+
+// Returns bit i set if p + i is a candidate, for i below 32.
+ANDYCCS_TARGET_AVX2 inline std::uint32_t Candidates(const char *p) {
+  const __m256i dash = _mm256_set1_epi8('-');
+  auto dashes_at = [&](int offset) ANDYCCS_TARGET_AVX2 {
+    return _mm256_cmpeq_epi8(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + offset)),
+        dash);
+  };
+  const __m256i candidates =
+      _mm256_and_si256(_mm256_and_si256(dashes_at(8), dashes_at(13)),
+                       _mm256_and_si256(dashes_at(18), dashes_at(23)));
+  return _mm256_movemask_epi8(candidates);
+}
+
+} // namespace
+
+ANDYCCS_TARGET_AVX2 const char *FindDashesAvx2(const char *begin,
+                                               const char *end) {
+  // Every iteration checks 64 candidates, which read up to p + 23 + 63, and
+  // may start a UUID up to p + 63 + 36.
+  const char *p = begin;
+  while (end - p >= 64 + 35) {
+    const std::uint64_t candidates =
+        Candidates(p) | std::uint64_t{Candidates(p + 32)} << 32;
+    if (candidates != 0) {
+      return p + std::countr_zero(candidates);
+    }
+    p += 64;
+  }
+  return FindDashesScalar(p, end);
+}
+
+} // namespace internal
+} // namespace andyccs
+
+#endif
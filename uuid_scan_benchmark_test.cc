@@ -0,0 +1,105 @@
+#include "uuid_scan.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "uuid_cpu.h"
+#include "uuid_scan_kernels.h"
+
+namespace andyccs {
+
+// Generates a log of 1 << 14 lines of about 100 bytes, with a UUID in one line
+// out of `lines_per_uuid`, or none if it is 0. Lines have dates and other
+// dashes, as real logs do.
+static std::string GenerateLog(int lines_per_uuid) {
+  std::mt19937_64 rng(42);
+  std::string log;
+  for (int i = 0; i < 1 << 14; ++i) {
+    log += "2024-12-29T20:59:03.123 INFO [worker-" + std::to_string(i % 16) +
+           "] ";
+    if (lines_per_uuid != 0 && i % lines_per_uuid == 0) {
+      log += "request " + std::string(SimdUuid(rng(), rng())) + " done in ";
+    } else {
+      log += "health check of host-" + std::to_string(rng() % 1000) +
+             " passed after ";
+    }
+    log += std::to_string(rng() % 1000) + " ms\n";
+  }
+  return log;
+}
+
+static void BM_ScanUuids(benchmark::State &state, int lines_per_uuid) {
+  const std::string log = GenerateLog(lines_per_uuid);
+  std::vector<UuidMatch> matches;
+  for (auto _ : state) {
+    matches.clear();
+    benchmark::DoNotOptimize(ScanUuids(log, matches));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * log.size());
+}
+BENCHMARK_CAPTURE(BM_ScanUuids, every_line, 1);
+BENCHMARK_CAPTURE(BM_ScanUuids, one_in_10_lines, 10);
+BENCHMARK_CAPTURE(BM_ScanUuids, one_in_100_lines, 100);
+BENCHMARK_CAPTURE(BM_ScanUuids, none, 0);
+
+// What ScanUuids replaces: splitting the log into words and parsing the words
+// of 36 characters.
+static void BM_ScanUuidsFromString(benchmark::State &state,
+                                   int lines_per_uuid) {
+  const std::string log = GenerateLog(lines_per_uuid);
+  std::vector<SimdUuid> uuids;
+  for (auto _ : state) {
+    uuids.clear();
+    std::size_t begin = 0;
+    while (begin < log.size()) {
+      std::size_t end = log.find_first_of(" \n", begin);
+      if (end == std::string::npos) {
+        end = log.size();
+      }
+      if (end - begin == 36) {
+        if (std::optional<SimdUuid> uuid =
+                SimdUuid::FromString(std::string_view(log).substr(begin, 36))) {
+          uuids.push_back(*uuid);
+        }
+      }
+      begin = end + 1;
+    }
+    benchmark::DoNotOptimize(uuids.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * log.size());
+}
+BENCHMARK_CAPTURE(BM_ScanUuidsFromString, every_line, 1);
+BENCHMARK_CAPTURE(BM_ScanUuidsFromString, one_in_100_lines, 100);
+
+// Finds the candidates of a log without UUIDs with each kernel.
+static void BM_FindDashesKernel(benchmark::State &state,
+                                internal::FindDashesKernel kernel,
+                                CpuIsa isa) {
+  if (!CpuSupports(isa)) {
+    state.SkipWithError("Instruction set not supported by the CPU");
+    return;
+  }
+  const std::string log = GenerateLog(0);
+  const char *end = log.data() + log.size();
+  for (auto _ : state) {
+    for (const char *p = kernel(log.data(), end); p != end;
+         p = kernel(p + 1, end)) {
+      benchmark::DoNotOptimize(p);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * log.size());
+}
+BENCHMARK_CAPTURE(BM_FindDashesKernel, scalar, &internal::FindDashesScalar,
+                  CpuIsa::kScalar);
+#ifdef ANDYCCS_ARCH_X86
+BENCHMARK_CAPTURE(BM_FindDashesKernel, avx2, &internal::FindDashesAvx2,
+                  CpuIsa::kAvx2);
+#endif
+
+} // namespace andyccs
+
+BENCHMARK_MAIN();
@@ -0,0 +1,23 @@
+#ifndef ANDYCCS_UUID_SCAN_KERNELS_H
+#define ANDYCCS_UUID_SCAN_KERNELS_H
+
+#include "uuid_cpu.h"
+
+namespace andyccs {
+namespace internal {
+
+// Returns the first `p` in [begin, end - 36] with dashes at p[8], p[13], p[18]
+// and p[23], i.e. where a UUID may start, or `end` if there is none. The
+// hex digits are not checked.
+using FindDashesKernel = const char *(*)(const char *begin, const char *end);
+
+const char *FindDashesScalar(const char *begin, const char *end);
+
+#ifdef ANDYCCS_ARCH_X86
+const char *FindDashesAvx2(const char *begin, const char *end);
+#endif
+
+} // namespace internal
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_SCAN_KERNELS_H
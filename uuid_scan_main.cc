@@ -0,0 +1,77 @@
+// Prints every UUID of the given files, one per line, with its byte offset:
+//
+//   $ uuid_scan app.log
+//   1024	6BBBB416-EDC3-405F-A86D-231D5800235E
+//
+// With more than one file, lines start with the file name. Exits with 1 if no
+// UUID is found, and 2 if a file cannot be read, like grep.
+
+#include <cstdio>
+#include <optional>
+#include <string>
+
+#include "uuid_scan.h"
+
+namespace {
+
+// Lines are written in blocks, so that dense files are not bound by stdio.
+class Output {
+public:
+  ~Output() { Flush(); }
+
+  void Append(std::string_view text) {
+    buffer_ += text;
+    if (buffer_.size() >= kBlockSize) {
+      Flush();
+    }
+  }
+
+  void Flush() {
+    std::fwrite(buffer_.data(), 1, buffer_.size(), stdout);
+    std::fflush(stdout);
+    buffer_.clear();
+  }
+
+private:
+  static constexpr std::size_t kBlockSize = 1 << 16;
+
+  std::string buffer_;
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    std::fprintf(stderr, "Usage: %s FILE...\n", argv[0]);
+    return 2;
+  }
+
+  Output output;
+  bool found = false;
+  bool failed = false;
+  for (int i = 1; i < argc; ++i) {
+    std::optional<andyccs::MappedFile> file = andyccs::MappedFile::Open(argv[i]);
+    if (!file.has_value()) {
+      output.Flush();
+      std::fprintf(stderr, "%s: cannot read %s\n", argv[0], argv[i]);
+      failed = true;
+      continue;
+    }
+
+    const std::string_view text = file->data();
+    const std::string prefix = argc > 2 ? std::string(argv[i]) + ":" : "";
+    for (std::optional<andyccs::UuidMatch> match = andyccs::FindUuid(text);
+         match.has_value();
+         match = andyccs::FindUuid(text, match->offset + 36)) {
+      char uuid[37];
+      match->uuid.ToChars(uuid);
+      output.Append(prefix);
+      output.Append(std::to_string(match->offset));
+      output.Append("\t");
+      output.Append(std::string_view(uuid, 36));
+      output.Append("\n");
+      found = true;
+    }
+  }
+  return failed ? 2 : found ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+#include "uuid_scan.h"
+
+#include <cctype>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace andyccs {
+namespace {
+
+const SimdUuid kUuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E);
+const SimdUuid kOtherUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF);
+
+std::vector<UuidMatch> Scan(std::string_view text) {
+  std::vector<UuidMatch> matches;
+  const std::size_t count = ScanUuids(text, matches);
+  EXPECT_EQ(count, matches.size());
+  return matches;
+}
+
+// Same as ScanUuids, trying every offset.
+std::vector<UuidMatch> ScanEveryOffset(std::string_view text) {
+  auto is_hex = [](char c) { return std::isxdigit(c) != 0; };
+  std::vector<UuidMatch> matches;
+  for (std::size_t i = 0; i + 36 <= text.size(); ++i) {
+    if ((i > 0 && is_hex(text[i - 1])) ||
+        (i + 36 < text.size() && is_hex(text[i + 36]))) {
+      continue;
+    }
+    if (std::optional<SimdUuid> uuid = SimdUuid::FromString(text.substr(i, 36))) {
+      matches.push_back({i, *uuid});
+      i += 35;
+    }
+  }
+  return matches;
+}
+
+TEST(ScanUuids, Log) {
+  const std::string text =
+      "2024-12-29T20:59:03 INFO request 6BBBB416-EDC3-405F-A86D-231D5800235E "
+      "started\n"
+      "2024-12-29T20:59:04 INFO user=fedcba98-7654-3210-8899-aabbccddeeff "
+      "request=6bbbb416-edc3-405f-a86d-231d5800235e done\n";
+  std::vector<UuidMatch> expected = {
+      {33, kUuid}, {108, kOtherUuid}, {153, kUuid}};
+  EXPECT_EQ(Scan(text), expected);
+}
+
+TEST(ScanUuids, Empty) {
+  EXPECT_TRUE(Scan("").empty());
+  EXPECT_TRUE(Scan("6BBBB416-EDC3-405F-A86D-231D5800235").empty());
+  EXPECT_FALSE(FindUuid("6BBBB416-EDC3-405F-A86D-231D5800235E", 1));
+  EXPECT_FALSE(FindUuid("6BBBB416-EDC3-405F-A86D-231D5800235E", 100));
+}
+
+TEST(ScanUuids, WholeText) {
+  std::vector<UuidMatch> expected = {{0, kUuid}};
+  EXPECT_EQ(Scan("6BBBB416-EDC3-405F-A86D-231D5800235E"), expected);
+}
+
+TEST(ScanUuids, Boundaries) {
+  // Longer hex runs are not UUIDs.
+  EXPECT_TRUE(Scan("06BBBB416-EDC3-405F-A86D-231D5800235E").empty());
+  EXPECT_TRUE(Scan("6BBBB416-EDC3-405F-A86D-231D5800235Ea").empty());
+  // Anything else is a separator.
+  std::vector<UuidMatch> expected = {{1, kUuid}};
+  EXPECT_EQ(Scan("x6BBBB416-EDC3-405F-A86D-231D5800235Eg"), expected);
+  EXPECT_EQ(Scan("{6BBBB416-EDC3-405F-A86D-231D5800235E}"), expected);
+  EXPECT_EQ(Scan("-6BBBB416-EDC3-405F-A86D-231D5800235E-"), expected);
+}
+
+TEST(ScanUuids, InvalidCandidates) {
+  // Dashes in the right places, but not hex digits.
+  EXPECT_TRUE(Scan("6BBBB416-EDC3-405F-A86D-231D5800235G").empty());
+  EXPECT_TRUE(Scan("--------------------------------------------").empty());
+  // A candidate one character before a UUID.
+  std::vector<UuidMatch> expected = {{2, kUuid}};
+  EXPECT_EQ(Scan("--6BBBB416-EDC3-405F-A86D-231D5800235E"), expected);
+}
+
+TEST(ScanUuids, FindFrom) {
+  const std::string text = "6BBBB416-EDC3-405F-A86D-231D5800235E "
+                           "FEDCBA98-7654-3210-8899-AABBCCDDEEFF";
+  EXPECT_EQ(FindUuid(text), (UuidMatch{0, kUuid}));
+  EXPECT_EQ(FindUuid(text, 1), (UuidMatch{37, kOtherUuid}));
+  EXPECT_EQ(FindUuid(text, 37), (UuidMatch{37, kOtherUuid}));
+  EXPECT_FALSE(FindUuid(text, 38));
+}
+
+// UUIDs at every offset of texts longer than the 64-byte blocks of the AVX2
+// kernel, with dashes and hex digits around.
+TEST(ScanUuids, MatchesEveryOffset) {
+  std::mt19937 rng(42);
+  const std::string alphabet = "0123456789abcdefABCDEF- \n";
+  for (std::size_t offset = 0; offset < 200; ++offset) {
+    std::string text(300, ' ');
+    for (char &c : text) {
+      c = alphabet[rng() % alphabet.size()];
+    }
+    text.replace(offset, 36, std::string(kOtherUuid));
+    text[offset + 36] = ' ';
+    EXPECT_EQ(Scan(text), ScanEveryOffset(text)) << text;
+  }
+}
+
+TEST(ScanUuids, MatchesEveryOffsetDense) {
+  std::mt19937 rng(42);
+  std::string text;
+  for (int i = 0; i < 1000; ++i) {
+    text += std::string(rng() % 4, "- x0"[rng() % 4]);
+    text += std::string(SimdUuid(rng(), rng()));
+  }
+  std::vector<UuidMatch> matches = Scan(text);
+  EXPECT_EQ(matches, ScanEveryOffset(text));
+  EXPECT_GT(matches.size(), 100u);
+}
+
+// Returns a path in the temporary directory, unique to this process: ctest runs
+// the tests of every instruction set at the same time.
+std::string TempPath(const std::string &name) {
+  return testing::TempDir() + std::to_string(::getpid()) + "_" + name;
+}
+
+TEST(MappedFile, Scan) {
+  const std::string path = TempPath("uuid_scan_test.log");
+  std::FILE *file = std::fopen(path.c_str(), "w");
+  ASSERT_NE(file, nullptr);
+  std::fputs("id=FEDCBA98-7654-3210-8899-AABBCCDDEEFF\n", file);
+  std::fclose(file);
+
+  std::optional<MappedFile> mapped = MappedFile::Open(path);
+  ASSERT_TRUE(mapped.has_value());
+  std::vector<UuidMatch> expected = {{3, kOtherUuid}};
+  EXPECT_EQ(Scan(mapped->data()), expected);
+
+  MappedFile moved = std::move(*mapped);
+  EXPECT_EQ(moved.data().size(), 40u);
+  EXPECT_TRUE(mapped->data().empty());
+  std::remove(path.c_str());
+}
+
+TEST(MappedFile, Empty) {
+  const std::string path = TempPath("uuid_scan_test_empty.log");
+  std::fclose(std::fopen(path.c_str(), "w"));
+  std::optional<MappedFile> mapped = MappedFile::Open(path);
+  ASSERT_TRUE(mapped.has_value());
+  EXPECT_TRUE(mapped->data().empty());
+  std::remove(path.c_str());
+}
+
+TEST(MappedFile, Missing) {
+  EXPECT_FALSE(MappedFile::Open(TempPath("uuid_scan_missing.log")));
+}
+
+} // namespace
+} // namespace andyccs
@@ -2,11 +2,20 @@
 #define ANDYCCS_UUID_SIMD_H
 
 #include <array>
+#include <compare>
 #include <cstdint>
 #include <cstdlib>
 #include <optional>
 #include <random>
+#include <span>
 #include <string>
+#include <type_traits>
+
+#include "uuid_encoding.h"
+#include "uuid_format.h"
+#include "uuid_hash.h"
+#include "uuid_random.h"
+#include "uuid_simd_kernels.h"
 
 namespace andyccs {
 
@@ -31,7 +40,7 @@ namespace andyccs {
 // instructions to significantly improve performance. Parsing a UUID from a
 // string is 9 times faster, and creating a UUID string is 3 times faster
 // compared to BasicUuid.
-class SimdUuid {
+class alignas(16) SimdUuid {
 public:
   // Default constructor for SimdUuid
   SimdUuid() = default;
@@ -55,24 +64,13 @@ public:
   // Same as above, but with std::array instead of C-style array
   constexpr SimdUuid(std::array<std::uint8_t, 16> data) : data_(data) {}
 
-  // Copy constructor and assignment operator
+  // Copy and move constructors and assignment operators. SimdUuid is trivially
+  // copyable: containers copy and relocate it with memcpy, and a moved-from
+  // SimdUuid keeps its value.
   SimdUuid(const SimdUuid &other) = default;
   SimdUuid &operator=(const SimdUuid &other) = default;
-
-  // Move constructor and assignment operator
-  SimdUuid(SimdUuid &&other) {
-    if (this != &other) {
-      data_ = std::move(other.data_);
-      other.data_ = {0};
-    }
-  }
-  SimdUuid &operator=(SimdUuid &&other) {
-    if (this != &other) {
-      data_ = std::move(other.data_);
-      other.data_ = {0};
-    }
-    return *this;
-  }
+  SimdUuid(SimdUuid &&other) = default;
+  SimdUuid &operator=(SimdUuid &&other) = default;
 
   // Convert SimdUuid to UUID V4 string.
   // This function is marked explicit to prevent accidental conversion to
@@ -87,28 +85,213 @@ public:
   // buffer.
   void ToChars(char (&buffer)[37]) const;
 
+  // Convert SimdUuid to UUID V4 string returned by value. The string is kept
+  // in the UuidString itself, so unlike operator std::string, this does not
+  // allocate, e.g. `log << uuid.ToString();`.
+  UuidString ToString() const;
+
+  // Same as the ToString and ToChars above, in the given format, e.g.
+  //
+  //   uuid.ToString<kUuidLowercase>(result);
+  //   UuidString urn = uuid.ToString<kUuidUrn>();
+  //   char buffer[kUuidUrn.size() + 1];
+  //   uuid.ToChars<kUuidUrn>(buffer);
+  //
+  // Every format has its own SIMD kernels, see UuidFormat.
+  template <UuidFormat Format> void ToString(std::string &result) const {
+    result.resize(Format.size());
+    internal::ActiveKernels().to_chars_formats[Format.index()](data_.data(),
+                                                               result.data());
+  }
+  template <UuidFormat Format> UuidString ToString() const {
+    UuidString result(Format.size());
+    internal::ActiveKernels().to_chars_formats[Format.index()](data_.data(),
+                                                               result.data_);
+    return result;
+  }
+  template <UuidFormat Format>
+  void ToChars(char (&buffer)[Format.size() + 1]) const {
+    internal::ActiveKernels().to_chars_formats[Format.index()](data_.data(),
+                                                               buffer);
+    buffer[Format.size()] = '\0';
+  }
+
+  // Convert many SimdUuids to UUID V4 strings written back to back into
+  // `buffer`, each one followed by `separator`, e.g. '\n' to write one UUID per
+  // line. Every UUID takes 37 characters, and as many UUIDs as fit in
+  // `buffer` are converted. No null terminator is written.
+  //
+  // Returns the number of characters written.
+  static std::size_t ToCharsBatch(std::span<const SimdUuid> uuids,
+                                  std::span<char> buffer,
+                                  char separator = '\n');
+
   // Create SimdUuid from a UUID V4 string.
-  // The UUID V4 string must be in uppercase.
+  // Hex digits may be in uppercase, lowercase or mixed case, at the same
+  // speed.
   static std::optional<SimdUuid> FromString(std::string_view from);
 
+  // Create SimdUuid from any of the common text forms of a UUID:
+  //
+  // 6BBBB416-EDC3-405F-A86D-231D5800235E
+  // 6BBBB416EDC3405FA86D231D5800235E
+  // {6BBBB416-EDC3-405F-A86D-231D5800235E}
+  // urn:uuid:6BBBB416-EDC3-405F-A86D-231D5800235E
+  //
+  // The form is told apart by its length, and the string is then read once by
+  // the kernel for that form. Hex digits and the "urn:uuid:" prefix may be in
+  // any case.
+  static std::optional<SimdUuid> Parse(std::string_view from);
+
+  // Create many SimdUuids from UUID V4 strings stored back to back in `from`.
+  // The i-th string starts at `from[i * stride]`, so use a stride of 36 for
+  // packed strings, or 37 when each string is followed by a separator.
+  //
+  // The i-th result is written to `result[i]`, and bit (i % 64) of
+  // `valid[i / 64]` tells whether the i-th string is a valid UUID. Invalid
+  // entries, including strings that do not fit in `from`, are written as
+  // SimdUuid(). At most `valid.size() * 64` strings are parsed.
+  //
+  // Returns the number of valid UUIDs.
+  static std::size_t FromStringBatch(std::string_view from, std::size_t stride,
+                                     std::span<SimdUuid> result,
+                                     std::span<std::uint64_t> valid);
+
+  // Same as above, but for strings scattered in memory.
+  static std::size_t FromStringBatch(std::span<const std::string_view> from,
+                                     std::span<SimdUuid> result,
+                                     std::span<std::uint64_t> valid);
+
+  // Convert SimdUuid to its 22-character base64url encoding, or to its
+  // 26-character Crockford base32 encoding, see uuid_encoding.h. Both are
+  // shorter than the 36 characters of ToChars.
+  void ToBase64Url(char (&buffer)[kBase64UrlSize + 1]) const;
+  void ToBase32(char (&buffer)[kBase32Size + 1]) const;
+
+  // Create SimdUuid from its base64url or base32 encoding. Every UUID has
+  // exactly one base64url encoding, but base32 is read in any case, with the
+  // 'I', 'L' and 'O' aliases of Crockford's alphabet.
+  static std::optional<SimdUuid> FromBase64Url(std::string_view from);
+  static std::optional<SimdUuid> FromBase32(std::string_view from);
+
+  // Same as ToCharsBatch and FromStringBatch, for base64url and base32. Every
+  // UUID takes 23 or 27 characters with its separator.
+  static std::size_t ToBase64UrlBatch(std::span<const SimdUuid> uuids,
+                                      std::span<char> buffer,
+                                      char separator = '\n');
+  static std::size_t ToBase32Batch(std::span<const SimdUuid> uuids,
+                                   std::span<char> buffer,
+                                   char separator = '\n');
+  static std::size_t FromBase64UrlBatch(std::string_view from,
+                                        std::size_t stride,
+                                        std::span<SimdUuid> result,
+                                        std::span<std::uint64_t> valid);
+  static std::size_t FromBase32Batch(std::string_view from, std::size_t stride,
+                                     std::span<SimdUuid> result,
+                                     std::span<std::uint64_t> valid);
+
+  // Create SimdUuid from a string constant at compile time, e.g.
+  //
+  //   constexpr SimdUuid kTenant =
+  //       SimdUuid::ParseConstant("6bbbb416-edc3-405f-a86d-231d5800235e");
+  //
+  // Takes the same forms as SimdUuid::Parse. Malformed strings do not compile.
+  // See also the _uuid literal below.
+  static consteval SimdUuid ParseConstant(std::string_view from) {
+    const std::optional<std::array<std::uint8_t, 16>> data =
+        internal::ParseUuidConstexpr(from);
+    if (!data.has_value()) {
+      throw "Malformed UUID constant";
+    }
+    return SimdUuid(*data);
+  }
+
   // Equality operators
-  bool operator==(const SimdUuid &other) const { return data_ == other.data_; }
+  constexpr bool operator==(const SimdUuid &other) const {
+    return data_ == other.data_;
+  }
+
+  constexpr bool operator!=(const SimdUuid &other) const {
+    return !(*this == other);
+  }
+
+  // Orders UUIDs as 128-bit big-endian numbers, i.e. as their strings. Two
+  // 64-bit comparisons instead of 16 byte comparisons.
+  constexpr std::strong_ordering operator<=>(const SimdUuid &other) const {
+    if (const std::strong_ordering order = high() <=> other.high();
+        order != 0) {
+      return order;
+    }
+    return low() <=> other.low();
+  }
+
+  // Returns the 64 most significant bits of the UUID, i.e. `high` in
+  // SimdUuid(high, low).
+  constexpr std::uint64_t high() const { return LoadBigEndian(0); }
+
+  // Returns the 64 least significant bits of the UUID, i.e. `low` in
+  // SimdUuid(high, low).
+  constexpr std::uint64_t low() const { return LoadBigEndian(8); }
 
-  bool operator!=(const SimdUuid &other) const { return !(*this == other); }
+  // Returns the version of the UUID, i.e. its 4 bits 48 to 51, as defined by
+  // RFC 9562: 4 for random UUIDs, 7 for time-ordered ones, etc. Note that
+  // SimdUuid(high, low) and SimdUuidGenerator do not set the version, so
+  // this only makes sense for UUIDs from RFC 9562 generators.
+  constexpr int version() const { return data_[6] >> 4; }
 
-  // Compute hash value for SimdUuid
-  size_t hash() const;
+  // Compute hash value for SimdUuid. The hash is computed from the 128-bit value
+  // directly, see HashUuid.
+  size_t hash() const { return HashUuid(data_); }
+
+  // Same as above, but seeded, see SeededUuidHash.
+  size_t hash(std::uint64_t seed) const { return HashUuid(data_, seed); }
 
 private:
+  // Implementation of the batch functions above, for strings of `size`
+  // characters.
+  static std::size_t ToCharsBatch(
+      std::span<const SimdUuid> uuids, std::span<char> buffer, char separator,
+      std::size_t size,
+      void (*kernel)(const std::uint8_t *, std::size_t, char, char *));
+  static std::size_t FromStridedBatch(
+      std::string_view from, std::size_t stride, std::span<SimdUuid> result,
+      std::span<std::uint64_t> valid, std::size_t size,
+      std::uint64_t (*kernel)(const char *, std::size_t, std::size_t,
+                              std::uint8_t *));
+
+  // Compilers turn this loop into a single load and byte swap.
+  constexpr std::uint64_t LoadBigEndian(std::size_t offset) const {
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < 8; ++i) {
+      value = (value << 8) | data_[offset + i];
+    }
+    return value;
+  }
+
   std::array<std::uint8_t, 16> data_ = {0};
 };
 
+// The kernels read a SimdUuid as one aligned __m128i, and a span of them as
+// packed 16-byte rows.
+static_assert(std::is_trivially_copyable_v<SimdUuid>);
+static_assert(sizeof(SimdUuid) == 16 && alignof(SimdUuid) == 16);
+
+namespace literals {
+
+// SimdUuid constant, e.g. "6bbbb416-edc3-405f-a86d-231d5800235e"_uuid, see
+// SimdUuid::ParseConstant. Use with
+//
+//   using namespace andyccs::literals;
+consteval SimdUuid operator""_uuid(const char *from, std::size_t size) {
+  return SimdUuid::ParseConstant(std::string_view(from, size));
+}
+
+} // namespace literals
+
 template <typename RNG> class SimdUuidGenerator {
 public:
   SimdUuidGenerator()
-      : generator_(RNG(std::random_device()())),
-        distribution_(std::numeric_limits<uint64_t>::min(),
-                      std::numeric_limits<uint64_t>::max()) {}
+      : generator_(internal::SeedRandomEngine<RNG>()) {}
 
   // Copyable
   SimdUuidGenerator(const SimdUuidGenerator &other) = default;
@@ -126,9 +309,14 @@ public:
     return SimdUuid(data);
   }
 
+  // Fill `uuids` with new SimdUuids, see Xoshiro256StarStarX8. Not thread safe.
+  void GenerateUuids(std::span<SimdUuid> uuids) {
+    internal::GenerateUuids(uuids, generator_, distribution_);
+  }
+
 private:
   RNG generator_;
-  std::uniform_int_distribution<uint64_t> distribution_;
+  [[no_unique_address]] internal::Uniform64<RNG> distribution_;
 };
 
 } // namespace andyccs
@@ -0,0 +1,438 @@
+#include "uuid_simd_kernels.h"
+
+#ifdef ANDYCCS_ARCH_X86
+
+#include <algorithm>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace andyccs {
+namespace internal {
+namespace {
+
+// Converts a 128-bits unsigned int to an UUIDv4 string representation.
+// Uses SIMD via Intel's AVX2 instruction set.
+template <bool kLowercase = false>
+ANDYCCS_TARGET_AVX2 inline void m256itos(__m256i input256, char *mem) {
+  // Real world input 0xFEDCBA98 76543210 8899AABB CCDDEEFF
+
+  // Shifts the 64-bit integers within a to the right by 4 bits. This
+  // effectively separates the upper and lower nibbles (4 bits) of each byte.
+  // Suppose
+  // i = 00000000 00000000 00000000 00000000 FFEEDDCC BBAA9988 10325476 98BADCFE
+  // Then
+  // s = 0FFEEDDC CBBAA998 01032547 698BADCF 0FFEEDDC CBBAA998 01032547 698BADCF
+  __m256i input256_shift_right = _mm256_srli_epi64(input256, 4);
+
+  // Suppose
+  // i = 00000000 00000000 00000000 00000000 FFEEDDCC BBAA9988 10325476 98BADCFE
+  // s = 0FFEEDDC CBBAA998 01032547 698BADCF 0FFEEDDC CBBAA998 01032547 698BADCF
+  // Then
+  // l = 10013203 54257647 9869BA8B DCADFECF 10013203 54257647 9869BA8B DCADFECF
+  // h = 00000000 00000000 00000000 00000000 FF0FEEFE DDEDCCDC BBCBAABA 99A98898
+  __m256i low = _mm256_unpacklo_epi8(input256_shift_right, input256);
+  __m128i high = _mm256_castsi256_si128(
+      _mm256_unpackhi_epi8(input256_shift_right, input256));
+
+  // c = FF0FEEFE DDEDCCDC BBCBAABA 99A98898 10013203 54257647 9869BA8B DCADFECF
+  __m256i combine = _mm256_inserti128_si256(low, high, 1);
+
+  // mask: bitmask to extract the lower 4 bits of each byte.
+  // 0F0F0F0F 0F0F0F0F 0F0F0F0F 0F0F0F0F 0F0F0F0F 0F0F0F0F 0F0F0F0F 0F0F0F0F
+  const __m256i mask = _mm256_set1_epi8(0x0F);
+
+  // c = FF0FEEFE DDEDCCDC BBCBAABA 99A98898 10013203 54257647 9869BA8B DCADFECF
+  //     0F0F0F0F 0F0F0F0F 0F0F0F0F 0F0F0F0F 0F0F0F0F 0F0F0F0F 0F0F0F0F 0F0F0F0F
+  // d = 0F0F0E0E 0D0D0C0C 0B0B0A0A 09090808 00010203 04050607 08090A0B 0C0D0E0F
+  // Notice that all data is in each bytes:
+  // FFEE DDCC BBAA 9988 0123 456 78AB CDEF
+  __m256i data = _mm256_and_si256(combine, mask);
+
+  // add: will be used to offset the ASCII values of digits
+  // 06060606 06060606 06060606 06060606
+  const __m256i add = _mm256_set1_epi8(0x06);
+
+  // alpha_mask: will be used to identify hex digits A-F
+  // 10101010 10101010 10101010 10101010
+  const __m256i alpha_mask = _mm256_set1_epi8(0x10);
+
+  // alpha_offset: will be used to offset the ASCII values of hex digits A-F.
+  // Note that 'A' - 0x0A == 0x37, and 'a' - 0x0A == 0x57
+  const __m256i alpha_offset = _mm256_set1_epi8(kLowercase ? 0x57 : 0x37);
+
+  // d = 0F0F0E0E 0D0D0C0C 0B0B0A0A 09090808 00010203 04050607 08090A0B 0C0D0E0F
+  // ADD 06060606 06060606 06060606 06060606 06060606 06060606 06060606 06060606
+  // AND 10101010 10101010 10101010 10101010 10101010 10101010 10101010 10101010
+  // SHIFT LEFT 3 bits every 64 bits, so that the most significant bit can tell
+  // whether a nibble is alpha (bit 1) or digit (bit 0).
+  //     80808080 80808080 80808080 00000000 00000000 00000000 00008080 80808080
+  __m256i alpha = _mm256_slli_epi64(
+      _mm256_and_si256(_mm256_add_epi8(data, add), alpha_mask), 3);
+
+  // Choose 0x30 (ASCII code for '0')
+  // or 0x57  (ASCII code for 'A' - 0x10)
+  //     37373737 37373737 37373737 30303030 30303030 30303030 30303737 37373737
+  __m256i offset =
+      _mm256_blendv_epi8(_mm256_slli_epi64(add, 3), alpha_offset, alpha);
+
+  // Now you get the ASCII index for each nibble.
+  // d = 0F0F0E0E 0D0D0C0C 0B0B0A0A 09090808 00010203 04050607 08090A0B 0C0D0E0F
+  //     37373737 37373737 37373737 30303030 30303030 30303030 30303737 37373737
+  // r = 46464545 44444343 42424141 39393838 30313233 34353637 38394142 43444546
+  // "FFEE DDCC BBAA 9988 0123 4567 89AB CDEF"
+  __m256i res = _mm256_add_epi8(data, offset);
+
+  // Add dashes between blocks so that the string is formatted as 8-4-4-4-12
+  // 44444343 42424141 00393938 38000000 32330034 35363700 38394142 43444546
+  const __m256i dash_shuffle =
+      _mm256_set_epi32(0x0b0a0908, 0x07060504, 0x80030201, 0x00808080,
+                       0x0d0c800b, 0x0a090880, 0x07060504, 0x03020100);
+  __m256i resd = _mm256_shuffle_epi8(res, dash_shuffle);
+
+  // 44444343 42424141 2D393938 382D0000 32332D34 3536372D 38394142 43444546
+  // ^                                                                     ^
+  // bit index 255                                               bit index 0
+  // "FFEE"   "DDCC"   "BBAA"   "9988"   "0123"   "4567"   "89AB"   "CDEF"
+  const __m256i dash =
+      _mm256_set_epi64x(0x0000000000000000ull, 0x2d000000002d0000ull,
+                        0x00002d000000002d, 0x0000000000000000ull);
+  resd = _mm256_or_si256(resd, dash);
+
+  // Reminder that the real world input is 0xFEDCBA98 76543210 8899AABB CCDDEEFF
+  // By copying from bit index 0 to index 255, we get the correct string.
+
+  _mm256_storeu_si256((__m256i *)mem, resd);
+  *(uint16_t *)(mem + 16) = _mm256_extract_epi16(res, 7);
+  *(uint32_t *)(mem + 32) = _mm256_extract_epi32(res, 7);
+
+  // Alternative implementation:
+  //   *(uint64_t *)(mem) = _mm256_extract_epi64(res, 0);
+  //   *(mem + 8) = '-';
+  //   *(uint32_t *)(mem + 9) = _mm256_extract_epi32(res, 2);
+  //   *(mem + 13) = '-';
+  //   *(uint32_t *)(mem + 14) = _mm256_extract_epi32(res, 3);
+  //   *(mem + 18) = '-';
+  //   *(uint32_t *)(mem + 19) = _mm256_extract_epi32(res, 4);
+  //   *(mem + 23) = '-';
+  //   *(uint32_t *)(mem + 24) = _mm256_extract_epi32(res, 5);
+  //   *(uint64_t *)(mem + 28) = _mm256_extract_epi64(res, 3);
+}
+
+// Converts two 128-bits unsigned ints to UUIDv4 string representations, each
+// followed by the separator, and writes the 74 characters to mem.
+// Uses SIMD via Intel's AVX2 instruction set, with one UUID per 128-bit lane.
+ANDYCCS_TARGET_AVX2 inline void m256itos2(__m256i input256, char separator, char *mem) {
+  // Split every byte into its high and low nibble, then interleave them so
+  // that each byte holds one hex digit, in string order. Per lane:
+  // first  = digits of bytes 0..7  = characters 0..15 without dashes
+  // second = digits of bytes 8..15 = characters 16..31 without dashes
+  const __m256i mask = _mm256_set1_epi8(0x0F);
+  __m256i high = _mm256_and_si256(_mm256_srli_epi16(input256, 4), mask);
+  __m256i low = _mm256_and_si256(input256, mask);
+  __m256i first = _mm256_unpacklo_epi8(high, low);
+  __m256i second = _mm256_unpackhi_epi8(high, low);
+
+  // Map every digit to its ASCII code with a table lookup.
+  const __m256i hex_map =
+      _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A',
+                       'B', 'C', 'D', 'E', 'F', '0', '1', '2', '3', '4', '5',
+                       '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+  first = _mm256_shuffle_epi8(hex_map, first);
+  second = _mm256_shuffle_epi8(hex_map, second);
+
+  // Characters 0..15 of the output: "XXXXXXXX-XXXX-XX"
+  const __m256i head_shuffle = _mm256_setr_epi8(
+      0, 1, 2, 3, 4, 5, 6, 7, -128, 8, 9, 10, 11, -128, 12, 13, //
+      0, 1, 2, 3, 4, 5, 6, 7, -128, 8, 9, 10, 11, -128, 12, 13);
+  const __m256i head_dash =
+      _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, '-', 0, 0, 0, 0, '-', 0, 0, //
+                       0, 0, 0, 0, 0, 0, 0, 0, '-', 0, 0, 0, 0, '-', 0, 0);
+  __m256i head = _mm256_or_si256(_mm256_shuffle_epi8(first, head_shuffle),
+                                 head_dash);
+
+  // Characters 16..31 of the output: "XX-XXXX-XXXXXXXX". The first two come
+  // from the end of `first`.
+  const __m256i body_shuffle = _mm256_setr_epi8(
+      0, 1, -128, 2, 3, 4, 5, -128, 6, 7, 8, 9, 10, 11, 12, 13, //
+      0, 1, -128, 2, 3, 4, 5, -128, 6, 7, 8, 9, 10, 11, 12, 13);
+  const __m256i body_dash =
+      _mm256_setr_epi8(0, 0, '-', 0, 0, 0, 0, '-', 0, 0, 0, 0, 0, 0, 0, 0, //
+                       0, 0, '-', 0, 0, 0, 0, '-', 0, 0, 0, 0, 0, 0, 0, 0);
+  __m256i body = _mm256_or_si256(
+      _mm256_shuffle_epi8(_mm256_alignr_epi8(second, first, 14), body_shuffle),
+      body_dash);
+
+  // Characters 32..35 of the output are the last 4 digits of `second`.
+  _mm_storeu_si128((__m128i *)mem, _mm256_castsi256_si128(head));
+  _mm_storeu_si128((__m128i *)(mem + 16), _mm256_castsi256_si128(body));
+  *(uint32_t *)(mem + 32) = _mm256_extract_epi32(second, 3);
+  mem[36] = separator;
+
+  _mm_storeu_si128((__m128i *)(mem + 37), _mm256_extracti128_si256(head, 1));
+  _mm_storeu_si128((__m128i *)(mem + 53), _mm256_extracti128_si256(body, 1));
+  *(uint32_t *)(mem + 69) = _mm256_extract_epi32(second, 7);
+  mem[73] = separator;
+}
+
+ANDYCCS_TARGET_AVX2 inline bool ValidateInput(__m256i pretty_input) {
+  const __m128i allowed_char_range =
+      _mm_setr_epi8('0', '9', 'A', 'F', 'a', 'f', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+  // For each of the character in the second argument
+  // If the character is in the range of the first argument
+  // Then the corresponding bit in the result is set to 0
+  // Return the smallest index of the first 1 bit.
+  int cmp_lower = _mm_cmpistri(
+      allowed_char_range, _mm256_extractf128_si256(pretty_input, 0),
+      _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_NEGATIVE_POLARITY |
+          _SIDD_LEAST_SIGNIFICANT);
+  int cmp_higher = _mm_cmpistri(
+      allowed_char_range, _mm256_extractf128_si256(pretty_input, 1),
+      _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_NEGATIVE_POLARITY |
+          _SIDD_LEAST_SIGNIFICANT);
+  return cmp_lower == 16 && cmp_higher == 16;
+}
+
+ANDYCCS_TARGET_AVX2 inline __m256i CreateInput(const char *mem) {
+  // Remove dashes and pack hex ascii bytes in a 256-bits int
+  const __m256i dash_shuffle =
+      _mm256_set_epi32(0x80808080, 0x0f0e0d0c, 0x0b0a0908, 0x06050403,
+                       0x80800f0e, 0x0c0b0a09, 0x07060504, 0x03020100);
+
+  // input: "FEDCBA98-7654-3210-8899-AABBCCDDEEFF"
+  // 46464545 44444343 42424141 39393838 30313233 34353637 38394142 43444546
+  __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(mem));
+  input = _mm256_shuffle_epi8(input, dash_shuffle);
+  input = _mm256_insert_epi16(input,
+                              *reinterpret_cast<const uint16_t *>(mem + 16), 7);
+  input = _mm256_insert_epi32(input,
+                              *reinterpret_cast<const uint32_t *>(mem + 32), 7);
+  return input;
+}
+
+// Converts an UUIDv4 string representation to a 128-bits unsigned int.
+// Uses SIMD via Intel's AVX2 instruction set.
+ANDYCCS_TARGET_AVX2 inline __m128i stom128i(__m256i pretty_input) {
+  // input: "FEDCBA98-7654-3210-8899-AABBCCDDEEFF"
+
+  // Setting bit 5 turns 'A'-'F' into 'a'-'f', and leaves digits as they are.
+  // 66666565 64646363 62626161 39393838 30313233 34353637 38396162 63646566
+  pretty_input = _mm256_or_si256(pretty_input, _mm256_set1_epi8(0x20));
+
+  // mask to determine whether it is a alpha
+  const __m256i mask = _mm256_set1_epi8('9');
+
+  // 'f' -> 0x66
+  // 0x66 - 0x57 = 0x0F
+  const __m256i alpha_offset = _mm256_set1_epi8(0x57);
+
+  // Digit offset
+  const __m256i digits_offset = _mm256_set1_epi8('0');
+
+  // alpha: Determine bytes are alpha
+  // 0xFF means alpha
+  // 0x00 means digit
+  //
+  // 66666565 64646363 62626161 39393838 30313233 34353637 38396162 63646566
+  // 39393939 39393939 39393939 39393939 39393939 39393939 39393939 39393939 cmp
+  // FFFFFFFF FFFFFFFF FFFFFFFF 00000000 00000000 00000000 0000FFFF FFFFFFFF
+  __m256i alpha = _mm256_cmpgt_epi8(pretty_input, mask);
+
+  // sub_mask: Subtraction mask. What should be subtracted from each byte.
+  // 57575757 57575757 57575757 30303030 30303030 30303030 30305757 57575757
+  __m256i sub_mask = _mm256_blendv_epi8(digits_offset, alpha_offset, alpha);
+
+  // spaced_result: Almost the result, but there is a 0x0 space in between
+  // 66666565 64646363 62626161 39393838 30313233 34353637 38396162 63646566
+  // 57575757 57575757 57575757 30303030 30303030 30303030 30305757 57575757
+  // 0F0F0E0E 0D0D0C0C 0B0B0A0A 09090808 00010203 04050607 08090A0B 0C0D0E0F
+  __m256i spaced_result = _mm256_sub_epi8(pretty_input, sub_mask);
+
+  // 0F0E0D0C 0B0A0908 0F0E0D0C 0B0A0908 00020406 080A0C0E 01030507 090B0D0F
+  //                 ^3                ^2                ^1                ^0
+  const __m256i odd_even_shuffle =
+      _mm256_set_epi8(15, 13, 11, 9, 7, 5, 3, 1, 14, 12, 10, 8, 6, 4, 2, 0, 15,
+                      13, 11, 9, 7, 5, 3, 1, 14, 12, 10, 8, 6, 4, 2, 0);
+  __m256i odd_even_shuffled_result =
+      _mm256_shuffle_epi8(spaced_result, odd_even_shuffle);
+
+  // odd:    0F0E0D0C 0B0A0908 01030507 090B0D0F
+  // even:   0F0E0D0C 0B0A0908 00020406 080A0C0E
+  __m128i low = _mm256_extracti128_si256(odd_even_shuffled_result, 0);
+  __m128i high = _mm256_extracti128_si256(odd_even_shuffled_result, 1);
+  __m128i odd = _mm_unpacklo_epi64(low, high);
+  __m128i even = _mm_unpackhi_epi64(low, high);
+
+  // F0E0D0C0 B0A09080 10305070 90B0D0F0
+  odd = _mm_slli_epi64(odd, 4);
+
+  //  FFEEDDCC BBAA9988 10325476 98BADCFE
+  return _mm_xor_si128(odd, even);
+}
+
+// Returns a bitmask with bit i set when mem[i] is a dash, for i in [0, 32).
+// A well-formed UUID string has exactly kDashMask set, because the last 4
+// characters are never dashes.
+constexpr uint32_t kDashMask = (1u << 8) | (1u << 13) | (1u << 18) | (1u << 23);
+
+ANDYCCS_TARGET_AVX2 inline uint32_t DashMask(const char *mem) {
+  __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(mem));
+  return _mm256_movemask_epi8(
+      _mm256_cmpeq_epi8(input, _mm256_set1_epi8('-')));
+}
+
+// Same as ValidateInput, but built from plain AVX2 compares instead of
+// _mm_cmpistri, so that the result does not depend on a branch and several
+// UUIDs can be in flight at once.
+ANDYCCS_TARGET_AVX2 inline bool ValidateInputBranchless(__m256i pretty_input) {
+  // Shift the range [lo, lo + n) to [-128, -128 + n) so that a single signed
+  // comparison checks both bounds.
+  const __m256i digit = _mm256_cmpgt_epi8(
+      _mm256_set1_epi8(-128 + 10),
+      _mm256_add_epi8(pretty_input, _mm256_set1_epi8(0x80 - '0')));
+  // Only 'A'-'F' and 'a'-'f' are 'a'-'f' once bit 5 is set.
+  const __m256i alpha = _mm256_cmpgt_epi8(
+      _mm256_set1_epi8(-128 + 6),
+      _mm256_add_epi8(_mm256_or_si256(pretty_input, _mm256_set1_epi8(0x20)),
+                      _mm256_set1_epi8(0x80 - 'a')));
+  return _mm256_movemask_epi8(_mm256_or_si256(digit, alpha)) == -1;
+}
+
+// Parses the 36 characters at mem into out, which is zeroed when the string
+// is not a valid UUID. mem must have at least 36 readable bytes.
+ANDYCCS_TARGET_AVX2 inline bool FromCharsBranchless(const char *mem, uint8_t *out) {
+  __m256i pretty_input = CreateInput(mem);
+  bool ok = (DashMask(mem) == kDashMask) & ValidateInputBranchless(pretty_input);
+  __m128i result = _mm_and_si128(stom128i(pretty_input),
+                                 _mm_set1_epi8(-static_cast<char>(ok)));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), result);
+  return ok;
+}
+
+ANDYCCS_TARGET_AVX2 void ToChars(const uint8_t *data, char *out) {
+  // Only the lower 128 bits are used. Load just those, so that nothing is
+  // read past the end of the UUID.
+  __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+  m256itos(_mm256_castsi128_si256(input), out);
+}
+
+template <UuidFormat Format>
+ANDYCCS_TARGET_AVX2 void ToCharsFormat(const uint8_t *data, char *out) {
+  __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+  WriteAffixes<Format>(out);
+  out += Format.prefix().size();
+  if constexpr (Format.dashes()) {
+    m256itos<Format.lowercase>(_mm256_castsi128_si256(input), out);
+  } else {
+    // Without dashes, the digits of bytes 0..7 and 8..15 are stored as they
+    // are, with one table lookup for both halves.
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    __m128i high = _mm_and_si128(_mm_srli_epi16(input, 4), mask);
+    __m128i low = _mm_and_si128(input, mask);
+    __m256i digits = _mm256_set_m128i(_mm_unpackhi_epi8(high, low),
+                                      _mm_unpacklo_epi8(high, low));
+    const char a = Format.lowercase ? 'a' : 'A';
+    const __m256i hex_map = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', a,
+                      a + 1, a + 2, a + 3, a + 4, a + 5));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out),
+                        _mm256_shuffle_epi8(hex_map, digits));
+  }
+}
+
+ANDYCCS_TARGET_AVX2 bool FromChars(const char *in, uint8_t *out) {
+  if (in[8] != '-' || in[13] != '-' || in[18] != '-' || in[23] != '-') {
+    return false;
+  }
+
+  __m256i pretty_input = CreateInput(in);
+  if (!ValidateInput(pretty_input)) {
+    return false;
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), stom128i(pretty_input));
+  return true;
+}
+
+ANDYCCS_TARGET_AVX2 bool FromCharsCompact(const char *in, uint8_t *out) {
+  // Without dashes, the digits are already where stom128i expects them.
+  __m256i pretty_input =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in));
+  if (!ValidateInput(pretty_input)) {
+    return false;
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), stom128i(pretty_input));
+  return true;
+}
+
+ANDYCCS_TARGET_AVX2 uint64_t FromCharsStrided(const char *in,
+                                              std::size_t stride,
+                                              std::size_t count,
+                                              uint8_t *out) {
+  uint64_t valid = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    bool ok = FromCharsBranchless(in + i * stride, out + i * 16);
+    valid |= uint64_t{ok} << i;
+  }
+  return valid;
+}
+
+ANDYCCS_TARGET_AVX2 uint64_t FromCharsViews(const std::string_view *in,
+                                            std::size_t count, uint8_t *out) {
+  uint64_t valid = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (in[i].size() == 36) {
+      bool ok = FromCharsBranchless(in[i].data(), out + i * 16);
+      valid |= uint64_t{ok} << i;
+    } else {
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i * 16),
+                       _mm_setzero_si128());
+    }
+  }
+  return valid;
+}
+
+ANDYCCS_TARGET_AVX2 void ToCharsBatch(const uint8_t *data, std::size_t count,
+                                      char separator, char *out) {
+  // Two UUIDs per iteration. They are adjacent in memory, so one 256-bit load
+  // fetches both.
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    __m256i input = _mm256_loadu_si256((__m256i *)(data + i * 16));
+    m256itos2(input, separator, out + i * 37);
+  }
+
+  // Odd one out. Go through a local buffer so that nothing is written past
+  // the end of the caller's buffer.
+  if (i < count) {
+    __m128i input = _mm_loadu_si128((__m128i *)(data + i * 16));
+    char chars[74];
+    m256itos2(_mm256_castsi128_si256(input), separator, chars);
+    std::copy(chars, chars + 37, out + i * 37);
+  }
+}
+
+} // namespace
+
+const SimdUuidKernels kAvx2Kernels = {
+    .to_chars = &ToChars,
+    .to_chars_formats = MakeFormatKernels(
+        []<UuidFormat Format>() { return &ToCharsFormat<Format>; }),
+    .from_chars = &FromChars,
+    .from_chars_compact = &FromCharsCompact,
+    .from_chars_strided = &FromCharsStrided,
+    .from_chars_views = &FromCharsViews,
+    .to_chars_batch = &ToCharsBatch,
+    .to_base64url = &ToBase64UrlSse42,
+    .from_base64url = &FromBase64UrlSse42,
+    .to_base32 = &ToBase32Sse42,
+    .from_base32 = &FromBase32Sse42,
+    .to_base64url_batch = &ToBase64UrlBatchSse42,
+    .from_base64url_strided = &FromBase64UrlStridedSse42,
+    .to_base32_batch = &ToBase32BatchSse42,
+    .from_base32_strided = &FromBase32StridedSse42,
+};
+
+} // namespace internal
+} // namespace andyccs
+
+#endif // ANDYCCS_ARCH_X86
@@ -0,0 +1,346 @@
+#include "uuid_simd_kernels.h"
+
+#ifdef ANDYCCS_ARCH_X86
+
+#include <array>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace andyccs {
+namespace internal {
+namespace {
+
+// Kernels for CPUs with AVX-512 VBMI. Masked loads and stores read and write
+// exactly the 36 characters of a UUID string, and vpermb/vpermt2b move all the
+// hex digits of one or two UUIDs in a single instruction, so there is no
+// extract, insert or _mm_cmpistri left.
+
+// Bits set at the position of the dashes in a UUID string.
+constexpr uint64_t kDashMask =
+    (uint64_t{1} << 8) | (uint64_t{1} << 13) | (uint64_t{1} << 18) |
+    (uint64_t{1} << 23);
+
+// Bits set for the 36 characters of a UUID string.
+constexpr uint64_t kStringMask = (uint64_t{1} << 36) - 1;
+
+// Returns the position of the j-th hex digit in a UUID string.
+constexpr int DigitPosition(int j) {
+  return j + (j >= 8) + (j >= 12) + (j >= 16) + (j >= 20);
+}
+
+// Returns which hex digit is at position p of a UUID string, or -1 for dashes
+// and positions past the end.
+constexpr int DigitAt(int p) {
+  for (int j = 0; j < 32; ++j) {
+    if (DigitPosition(j) == p) {
+      return j;
+    }
+  }
+  return -1;
+}
+
+// vpermt2b indices that gather the 32 hex digits of the string in the first
+// operand into bytes 0..31, and those of the string in the second operand into
+// bytes 32..63.
+constexpr std::array<uint8_t, 64> MakeParseIndex() {
+  std::array<uint8_t, 64> index = {};
+  for (int j = 0; j < 32; ++j) {
+    index[j] = DigitPosition(j);
+    index[32 + j] = 64 + DigitPosition(j);
+  }
+  return index;
+}
+
+// vpermt2b indices that spread the hex digits of a UUID to their position in
+// the string. Digits 0..15 are taken from the first operand, and digits 16..31
+// from the second one. Dashes are filled in afterwards.
+constexpr std::array<uint8_t, 64> MakeFormatIndex() {
+  std::array<uint8_t, 64> index = {};
+  for (int p = 0; p < 64; ++p) {
+    int j = DigitAt(p);
+    if (j >= 16) {
+      index[p] = 64 + j - 16;
+    } else if (j >= 0) {
+      index[p] = j;
+    }
+  }
+  return index;
+}
+
+alignas(64) constexpr std::array<uint8_t, 64> kParseIndex = MakeParseIndex();
+alignas(64) constexpr std::array<uint8_t, 64> kFormatIndex = MakeFormatIndex();
+
+// Loads the 36 characters at `in`, or zeros if `ok` is false. The masked load
+// never touches memory past the string.
+ANDYCCS_TARGET_AVX512 inline __m512i LoadString(const char *in, bool ok) {
+  return _mm512_maskz_loadu_epi8(ok ? kStringMask : 0, in);
+}
+
+// Returns true if the dashes of the loaded string are where they should be.
+// Bytes past the string are zeros, so they cannot be dashes.
+ANDYCCS_TARGET_AVX512 inline bool HasDashes(__m512i input) {
+  return _mm512_cmpeq_epi8_mask(input, _mm512_set1_epi8('-')) == kDashMask;
+}
+
+// Converts 64 hex digits to their values, one per byte, and returns a mask of
+// the bytes that were valid hex digits.
+ANDYCCS_TARGET_AVX512 inline __mmask64 HexToNibbles(__m512i digits,
+                                                    __m512i *nibbles) {
+  __m512i from_digit = _mm512_sub_epi8(digits, _mm512_set1_epi8('0'));
+  // Setting bit 5 turns 'A'-'F' into 'a'-'f', and nothing else into them.
+  __m512i from_alpha = _mm512_sub_epi8(
+      _mm512_or_si512(digits, _mm512_set1_epi8(0x20)), _mm512_set1_epi8('a'));
+  __mmask64 digit = _mm512_cmplt_epu8_mask(from_digit, _mm512_set1_epi8(10));
+  __mmask64 alpha = _mm512_cmplt_epu8_mask(from_alpha, _mm512_set1_epi8(6));
+  *nibbles = _mm512_mask_add_epi8(from_digit, alpha, from_alpha,
+                                  _mm512_set1_epi8(0xA));
+  return digit | alpha;
+}
+
+// Packs pairs of nibbles into bytes: 64 nibbles into 32 bytes.
+ANDYCCS_TARGET_AVX512 inline __m256i PackNibbles(__m512i nibbles) {
+  // Multiply the high nibble of each pair by 16 and add the low nibble.
+  return _mm512_cvtepi16_epi8(
+      _mm512_maddubs_epi16(nibbles, _mm512_set1_epi16(0x0110)));
+}
+
+// Converts the strings loaded in `a` and `b` to the UUIDs in the lower and
+// upper halves of the result. Invalid strings are converted to zeros, and
+// their bit is cleared in the returned 2-bit mask.
+ANDYCCS_TARGET_AVX512 inline uint32_t ParseTwo(__m512i a, __m512i b,
+                                               __m256i *result) {
+  uint32_t valid = HasDashes(a) | (HasDashes(b) << 1);
+
+  const __m512i index = _mm512_load_si512(kParseIndex.data());
+  __m512i nibbles;
+  __mmask64 hex =
+      HexToNibbles(_mm512_permutex2var_epi8(a, index, b), &nibbles);
+  valid &= (static_cast<uint32_t>(hex) == 0xFFFFFFFF) |
+           (((hex >> 32) == 0xFFFFFFFF) << 1);
+
+  // Expand every valid bit to the 16 bytes of its UUID.
+  __mmask32 keep = (valid & 1 ? 0x0000FFFF : 0) | (valid & 2 ? 0xFFFF0000 : 0);
+  *result = _mm256_maskz_mov_epi8(keep, PackNibbles(nibbles));
+  return valid;
+}
+
+// Converts one 128-bits unsigned int to its 32 hex digits, digits 0..15 in
+// `first` and digits 16..31 in `second`.
+template <bool kLowercase>
+ANDYCCS_TARGET_AVX512 inline void m128ihex(__m128i input, __m128i *first,
+                                           __m128i *second) {
+  const __m128i mask = _mm_set1_epi8(0x0F);
+  __m128i high = _mm_and_si128(_mm_srli_epi16(input, 4), mask);
+  __m128i low = _mm_and_si128(input, mask);
+
+  const char a = kLowercase ? 'a' : 'A';
+  const __m128i hex_map =
+      _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', a, a + 1,
+                    a + 2, a + 3, a + 4, a + 5);
+  *first = _mm_shuffle_epi8(hex_map, _mm_unpacklo_epi8(high, low));
+  *second = _mm_shuffle_epi8(hex_map, _mm_unpackhi_epi8(high, low));
+}
+
+// Converts one 128-bits unsigned int to the UUIDv4 string representation in
+// the lower 36 bytes of the result. `fill` provides the characters at the
+// position of the dashes and after the string.
+template <bool kLowercase = false>
+ANDYCCS_TARGET_AVX512 inline __m512i m128itos(__m128i input, __m512i fill) {
+  __m128i first;
+  __m128i second;
+  m128ihex<kLowercase>(input, &first, &second);
+
+  const __m512i index = _mm512_load_si512(kFormatIndex.data());
+  __m512i digits = _mm512_permutex2var_epi8(_mm512_castsi128_si512(first),
+                                            index,
+                                            _mm512_castsi128_si512(second));
+  return _mm512_mask_blend_epi8(~kStringMask | kDashMask, digits, fill);
+}
+
+ANDYCCS_TARGET_AVX512 void ToChars(const uint8_t *data, char *out) {
+  __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+  __m512i result = m128itos(input, _mm512_set1_epi8('-'));
+  _mm512_mask_storeu_epi8(out, kStringMask, result);
+}
+
+template <UuidFormat Format>
+ANDYCCS_TARGET_AVX512 void ToCharsFormat(const uint8_t *data, char *out) {
+  __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+  WriteAffixes<Format>(out);
+  out += Format.prefix().size();
+  if constexpr (Format.dashes()) {
+    _mm512_mask_storeu_epi8(
+        out, kStringMask,
+        m128itos<Format.lowercase>(input, _mm512_set1_epi8('-')));
+  } else {
+    __m128i first;
+    __m128i second;
+    m128ihex<Format.lowercase>(input, &first, &second);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out),
+                        _mm256_set_m128i(second, first));
+  }
+}
+
+ANDYCCS_TARGET_AVX512 bool FromChars(const char *in, uint8_t *out) {
+  __m512i input = LoadString(in, true);
+  if (!HasDashes(input)) {
+    return false;
+  }
+
+  const __m512i index = _mm512_load_si512(kParseIndex.data());
+  __m512i nibbles;
+  __mmask64 hex = HexToNibbles(_mm512_permutexvar_epi8(index, input), &nibbles);
+  if (static_cast<uint32_t>(hex) != 0xFFFFFFFF) {
+    return false;
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                   _mm256_castsi256_si128(PackNibbles(nibbles)));
+  return true;
+}
+
+ANDYCCS_TARGET_AVX512 bool FromCharsCompact(const char *in, uint8_t *out) {
+  // Without dashes, the digits are already in order.
+  __m512i digits = _mm512_zextsi256_si512(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in)));
+  __m512i nibbles;
+  __mmask64 hex = HexToNibbles(digits, &nibbles);
+  if (static_cast<uint32_t>(hex) != 0xFFFFFFFF) {
+    return false;
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                   _mm256_castsi256_si128(PackNibbles(nibbles)));
+  return true;
+}
+
+// Strings at a fixed stride.
+struct StridedStrings {
+  const char *in;
+  std::size_t stride;
+
+  const char *data(std::size_t i) const { return in + i * stride; }
+  bool loadable(std::size_t) const { return true; }
+};
+
+// Strings scattered in memory. Strings of the wrong size are not loaded at
+// all, so they fail the dash check without a branch.
+struct ViewStrings {
+  const std::string_view *in;
+
+  const char *data(std::size_t i) const { return in[i].data(); }
+  bool loadable(std::size_t i) const { return in[i].size() == 36; }
+};
+
+// Converts `count` strings, four at a time.
+template <typename Strings>
+ANDYCCS_TARGET_AVX512 inline uint64_t
+FromCharsBatch(Strings strings, std::size_t count, uint8_t *out) {
+  uint64_t valid = 0;
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i low;
+    __m256i high;
+    uint32_t low_valid =
+        ParseTwo(LoadString(strings.data(i), strings.loadable(i)),
+                 LoadString(strings.data(i + 1), strings.loadable(i + 1)),
+                 &low);
+    uint32_t high_valid =
+        ParseTwo(LoadString(strings.data(i + 2), strings.loadable(i + 2)),
+                 LoadString(strings.data(i + 3), strings.loadable(i + 3)),
+                 &high);
+    // Four UUIDs per zmm register.
+    _mm512_storeu_si512(
+        out + i * 16,
+        _mm512_inserti64x4(_mm512_castsi256_si512(low), high, 1));
+    valid |= static_cast<uint64_t>(low_valid | (high_valid << 2)) << i;
+  }
+  for (; i < count; ++i) {
+    __m256i result;
+    uint32_t ok = ParseTwo(LoadString(strings.data(i), strings.loadable(i)),
+                           _mm512_setzero_si512(), &result) &
+                  1;
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i * 16),
+                     _mm256_castsi256_si128(result));
+    valid |= static_cast<uint64_t>(ok) << i;
+  }
+  return valid;
+}
+
+ANDYCCS_TARGET_AVX512 uint64_t FromCharsStrided(const char *in,
+                                                std::size_t stride,
+                                                std::size_t count,
+                                                uint8_t *out) {
+  return FromCharsBatch(StridedStrings{in, stride}, count, out);
+}
+
+ANDYCCS_TARGET_AVX512 uint64_t FromCharsViews(const std::string_view *in,
+                                              std::size_t count,
+                                              uint8_t *out) {
+  return FromCharsBatch(ViewStrings{in}, count, out);
+}
+
+ANDYCCS_TARGET_AVX512 void ToCharsBatch(const uint8_t *data, std::size_t count,
+                                        char separator, char *out) {
+  // Dashes, then the separator right after the string.
+  const __m512i fill = _mm512_mask_blend_epi8(
+      uint64_t{1} << 36, _mm512_set1_epi8('-'), _mm512_set1_epi8(separator));
+  const __mmask64 store_mask = (uint64_t{1} << 37) - 1;
+
+  // Four UUIDs per iteration, one per 128-bit lane.
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m512i input = _mm512_loadu_si512(data + i * 16);
+    const __m512i mask = _mm512_set1_epi8(0x0F);
+    __m512i high = _mm512_and_si512(_mm512_srli_epi16(input, 4), mask);
+    __m512i low = _mm512_and_si512(input, mask);
+
+    // Per lane, `first` holds digits 0..15 and `second` digits 16..31.
+    const __m512i hex_map = _mm512_broadcast_i32x4(
+        _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A',
+                      'B', 'C', 'D', 'E', 'F'));
+    __m512i first = _mm512_shuffle_epi8(hex_map, _mm512_unpacklo_epi8(high, low));
+    __m512i second =
+        _mm512_shuffle_epi8(hex_map, _mm512_unpackhi_epi8(high, low));
+
+    // Moving on to the next lane means adding 16 to every index.
+    __m512i index = _mm512_load_si512(kFormatIndex.data());
+    for (int lane = 0; lane < 4; ++lane) {
+      __m512i digits = _mm512_permutex2var_epi8(first, index, second);
+      __m512i result =
+          _mm512_mask_blend_epi8(~kStringMask | kDashMask, digits, fill);
+      _mm512_mask_storeu_epi8(out + (i + lane) * 37, store_mask, result);
+      index = _mm512_add_epi8(index, _mm512_set1_epi8(16));
+    }
+  }
+
+  for (; i < count; ++i) {
+    __m128i input =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i * 16));
+    _mm512_mask_storeu_epi8(out + i * 37, store_mask, m128itos(input, fill));
+  }
+}
+
+} // namespace
+
+const SimdUuidKernels kAvx512Kernels = {
+    .to_chars = &ToChars,
+    .to_chars_formats = MakeFormatKernels(
+        []<UuidFormat Format>() { return &ToCharsFormat<Format>; }),
+    .from_chars = &FromChars,
+    .from_chars_compact = &FromCharsCompact,
+    .from_chars_strided = &FromCharsStrided,
+    .from_chars_views = &FromCharsViews,
+    .to_chars_batch = &ToCharsBatch,
+    .to_base64url = &ToBase64UrlSse42,
+    .from_base64url = &FromBase64UrlSse42,
+    .to_base32 = &ToBase32Sse42,
+    .from_base32 = &FromBase32Sse42,
+    .to_base64url_batch = &ToBase64UrlBatchSse42,
+    .from_base64url_strided = &FromBase64UrlStridedSse42,
+    .to_base32_batch = &ToBase32BatchSse42,
+    .from_base32_strided = &FromBase32StridedSse42,
+};
+
+} // namespace internal
+} // namespace andyccs
+
+#endif // ANDYCCS_ARCH_X86
@@ -1,18 +1,59 @@
 #include "uuid_simd.h"
 
+#include <algorithm>
+#include <array>
 #include <benchmark/benchmark.h>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <new>
 #include <random>
+#include <vector>
 
 #include "uuid_benchmark_utils.h"
+#include "uuid_cpu.h"
+#include "uuid_simd_kernels.h"
+
+// Calls to operator new in this benchmark, to report the allocations of the
+// benchmarks that format UUIDs.
+static std::size_t allocations = 0;
+
+// Not inlined, so that GCC does not see a new expression paired with free.
+__attribute__((noinline)) void *operator new(std::size_t size) {
+  ++allocations;
+  if (void *pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+__attribute__((noinline)) void operator delete(void *pointer) noexcept {
+  std::free(pointer);
+}
+__attribute__((noinline)) void operator delete(void *pointer,
+                                               std::size_t) noexcept {
+  std::free(pointer);
+}
 
 namespace andyccs {
 
-static void BM_SimdUuidFromString(benchmark::State &state) {
+// Reports the allocations per UUID of a benchmark that formats
+// `state.range(0)` UUIDs per iteration, given the allocations before the
+// benchmark loop.
+static void SetAllocationsPerUuid(benchmark::State &state,
+                                  std::size_t allocations_before) {
+  state.counters["allocs_per_uuid"] =
+      static_cast<double>(allocations - allocations_before) /
+      static_cast<double>(state.iterations() * state.range(0));
+}
+
+static void BM_SimdUuidFromString(benchmark::State &state,
+                                  LetterCase letter_case) {
   std::uint8_t data[16];
   GenerateRandomData(data);
   SimdUuid uuid(data);
 
   std::string from = std::string(uuid);
+  SetLetterCase(from, letter_case);
   for (auto _ : state) {
     for (int i = 0; i < state.range(0); ++i) {
       benchmark::DoNotOptimize(SimdUuid::FromString(from));
@@ -20,7 +61,147 @@ static void BM_SimdUuidFromString(benchmark::State &state) {
     }
   }
 }
-BENCHMARK(BM_SimdUuidFromString)->Range(1 << 8, 1 << 8);
+BENCHMARK_CAPTURE(BM_SimdUuidFromString, upper, LetterCase::kUpper)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_CAPTURE(BM_SimdUuidFromString, lower, LetterCase::kLower)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_CAPTURE(BM_SimdUuidFromString, mixed, LetterCase::kMixed)
+    ->Range(1 << 8, 1 << 8);
+
+static void BM_SimdUuidParse(benchmark::State &state, UuidForm form) {
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  SimdUuid uuid(data);
+
+  std::string from = SetUuidForm(std::string(uuid), form);
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(SimdUuid::Parse(from));
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK_CAPTURE(BM_SimdUuidParse, hyphenated, UuidForm::kHyphenated)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_CAPTURE(BM_SimdUuidParse, compact, UuidForm::kCompact)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_CAPTURE(BM_SimdUuidParse, braced, UuidForm::kBraced)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_CAPTURE(BM_SimdUuidParse, urn, UuidForm::kUrn)
+    ->Range(1 << 8, 1 << 8);
+
+// Compares a UUID with a well-known one, parsed on every use or at compile
+// time.
+static void BM_SimdUuidEqualsParsedString(benchmark::State &state) {
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  SimdUuid uuid(data);
+
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(
+          uuid == SimdUuid::FromString("6bbbb416-edc3-405f-a86d-231d5800235e"));
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK(BM_SimdUuidEqualsParsedString)->Range(1 << 8, 1 << 8);
+
+static void BM_SimdUuidEqualsLiteral(benchmark::State &state) {
+  using namespace andyccs::literals;
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  SimdUuid uuid(data);
+
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(uuid ==
+                               "6bbbb416-edc3-405f-a86d-231d5800235e"_uuid);
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK(BM_SimdUuidEqualsLiteral)->Range(1 << 8, 1 << 8);
+
+// Generates `count` random UUID strings, each followed by a new line.
+static std::string
+GenerateUuidLines(std::size_t count,
+                  LetterCase letter_case = LetterCase::kUpper) {
+  std::string lines;
+  lines.reserve(count * 37);
+  for (std::size_t i = 0; i < count; ++i) {
+    std::uint8_t data[16];
+    GenerateRandomData(data);
+    lines += std::string(SimdUuid(data));
+    lines += '\n';
+  }
+  SetLetterCase(lines, letter_case);
+  return lines;
+}
+
+static void BM_SimdUuidFromStringLoop(benchmark::State &state) {
+  const std::size_t count = state.range(0);
+  std::string from = GenerateUuidLines(count);
+  std::vector<SimdUuid> result(count);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < count; ++i) {
+      std::optional<SimdUuid> uuid =
+          SimdUuid::FromString(std::string_view(from).substr(i * 37, 36));
+      if (uuid.has_value()) {
+        result[i] = *uuid;
+      }
+    }
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_SimdUuidFromStringLoop)->RangeMultiplier(4)->Range(1, 1 << 12);
+
+static void BM_SimdUuidFromStringBatch(benchmark::State &state,
+                                       LetterCase letter_case) {
+  const std::size_t count = state.range(0);
+  std::string from = GenerateUuidLines(count, letter_case);
+  std::vector<SimdUuid> result(count);
+  std::vector<std::uint64_t> valid((count + 63) / 64);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        SimdUuid::FromStringBatch(from, 37, result, valid));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_CAPTURE(BM_SimdUuidFromStringBatch, upper, LetterCase::kUpper)
+    ->RangeMultiplier(4)
+    ->Range(1, 1 << 12);
+BENCHMARK_CAPTURE(BM_SimdUuidFromStringBatch, lower, LetterCase::kLower)
+    ->RangeMultiplier(4)
+    ->Range(1, 1 << 12);
+BENCHMARK_CAPTURE(BM_SimdUuidFromStringBatch, mixed, LetterCase::kMixed)
+    ->RangeMultiplier(4)
+    ->Range(1, 1 << 12);
+
+static void BM_SimdUuidFromStringBatchStringView(benchmark::State &state) {
+  const std::size_t count = state.range(0);
+  std::string lines = GenerateUuidLines(count);
+  std::vector<std::string_view> from;
+  for (std::size_t i = 0; i < count; ++i) {
+    from.push_back(std::string_view(lines).substr(i * 37, 36));
+  }
+  std::vector<SimdUuid> result(count);
+  std::vector<std::uint64_t> valid((count + 63) / 64);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SimdUuid::FromStringBatch(from, result, valid));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_SimdUuidFromStringBatchStringView)
+    ->RangeMultiplier(4)
+    ->Range(1, 1 << 12);
 
 static void BM_SimdUuidFromArrayData(benchmark::State &state) {
   std::uint8_t data[16];
@@ -53,15 +234,43 @@ static void BM_SimdUuidToString(benchmark::State &state) {
   GenerateRandomData(data);
   SimdUuid uuid(data);
 
+  const std::size_t allocations_before = allocations;
   for (auto _ : state) {
     for (int i = 0; i < state.range(0); ++i) {
       benchmark::DoNotOptimize(std::string(uuid));
       benchmark::ClobberMemory();
     }
   }
+  SetAllocationsPerUuid(state, allocations_before);
 }
 BENCHMARK(BM_SimdUuidToString)->Range(1 << 8, 1 << 8);
 
+// Same as above, returning a UuidString, which does not allocate.
+template <UuidFormat Format>
+static void BM_SimdUuidToUuidString(benchmark::State &state) {
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  SimdUuid uuid(data);
+
+  const std::size_t allocations_before = allocations;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(uuid.ToString<Format>());
+      benchmark::ClobberMemory();
+    }
+  }
+  SetAllocationsPerUuid(state, allocations_before);
+}
+BENCHMARK_TEMPLATE(BM_SimdUuidToUuidString, kUuidUppercase)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_TEMPLATE(BM_SimdUuidToUuidString, kUuidLowercase)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_TEMPLATE(BM_SimdUuidToUuidString, kUuidCompact)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_TEMPLATE(BM_SimdUuidToUuidString, kUuidBraced)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_TEMPLATE(BM_SimdUuidToUuidString, kUuidUrn)->Range(1 << 8, 1 << 8);
+
 static void BM_SimdUuidToStringPrealloc(benchmark::State &state) {
   std::uint8_t data[16];
   GenerateRandomData(data);
@@ -95,6 +304,406 @@ static void BM_SimdUuidToChars(benchmark::State &state) {
 }
 BENCHMARK(BM_SimdUuidToChars)->Range(1 << 8, 1 << 8);
 
+template <UuidFormat Format>
+static void BM_SimdUuidToCharsFormat(benchmark::State &state) {
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  SimdUuid uuid(data);
+
+  char result[Format.size() + 1];
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      uuid.ToChars<Format>(result);
+      benchmark::DoNotOptimize(result);
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK_TEMPLATE(BM_SimdUuidToCharsFormat, kUuidUppercase)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_TEMPLATE(BM_SimdUuidToCharsFormat, kUuidLowercase)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_TEMPLATE(BM_SimdUuidToCharsFormat, kUuidCompact)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_TEMPLATE(BM_SimdUuidToCharsFormat, kUuidBraced)
+    ->Range(1 << 8, 1 << 8);
+BENCHMARK_TEMPLATE(BM_SimdUuidToCharsFormat, kUuidUrn)
+    ->Range(1 << 8, 1 << 8);
+
+// Compare with BM_SimdUuidToChars and BM_SimdUuidFromString for the hex form.
+static void BM_SimdUuidToBase64Url(benchmark::State &state) {
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  SimdUuid uuid(data);
+
+  char result[kBase64UrlSize + 1];
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      uuid.ToBase64Url(result);
+      benchmark::DoNotOptimize(result);
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK(BM_SimdUuidToBase64Url)->Range(1 << 8, 1 << 8);
+
+static void BM_SimdUuidToBase32(benchmark::State &state) {
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  SimdUuid uuid(data);
+
+  char result[kBase32Size + 1];
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      uuid.ToBase32(result);
+      benchmark::DoNotOptimize(result);
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK(BM_SimdUuidToBase32)->Range(1 << 8, 1 << 8);
+
+static void BM_SimdUuidFromBase64Url(benchmark::State &state) {
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  char from[kBase64UrlSize + 1];
+  SimdUuid(data).ToBase64Url(from);
+
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(SimdUuid::FromBase64Url(from));
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK(BM_SimdUuidFromBase64Url)->Range(1 << 8, 1 << 8);
+
+static void BM_SimdUuidFromBase32(benchmark::State &state) {
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  char from[kBase32Size + 1];
+  SimdUuid(data).ToBase32(from);
+
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(SimdUuid::FromBase32(from));
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK(BM_SimdUuidFromBase32)->Range(1 << 8, 1 << 8);
+
+// Generates `count` random UUIDs.
+static std::vector<SimdUuid> GenerateUuids(std::size_t count) {
+  std::vector<SimdUuid> uuids;
+  uuids.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    std::uint8_t data[16];
+    GenerateRandomData(data);
+    uuids.push_back(SimdUuid(data));
+  }
+  return uuids;
+}
+
+static void BM_SimdUuidToCharsLoop(benchmark::State &state) {
+  const std::size_t count = state.range(0);
+  std::vector<SimdUuid> uuids = GenerateUuids(count);
+  std::vector<char> buffer(count * 37);
+
+  char result[37];
+  for (auto _ : state) {
+    char *out = buffer.data();
+    for (const SimdUuid &uuid : uuids) {
+      uuid.ToChars(result);
+      result[36] = '\n';
+      std::copy(result, result + 37, out);
+      out += 37;
+    }
+    benchmark::DoNotOptimize(buffer.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_SimdUuidToCharsLoop)->RangeMultiplier(4)->Range(1, 1 << 12);
+
+static void BM_SimdUuidToCharsBatch(benchmark::State &state) {
+  const std::size_t count = state.range(0);
+  std::vector<SimdUuid> uuids = GenerateUuids(count);
+  std::vector<char> buffer(count * 37);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SimdUuid::ToCharsBatch(uuids, buffer));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_SimdUuidToCharsBatch)->RangeMultiplier(4)->Range(1, 1 << 12);
+
+static void BM_SimdUuidToBase64UrlBatch(benchmark::State &state) {
+  const std::size_t count = state.range(0);
+  std::vector<SimdUuid> uuids = GenerateUuids(count);
+  std::vector<char> buffer(count * (kBase64UrlSize + 1));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SimdUuid::ToBase64UrlBatch(uuids, buffer));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_SimdUuidToBase64UrlBatch)->RangeMultiplier(4)->Range(1, 1 << 12);
+
+static void BM_SimdUuidToBase32Batch(benchmark::State &state) {
+  const std::size_t count = state.range(0);
+  std::vector<SimdUuid> uuids = GenerateUuids(count);
+  std::vector<char> buffer(count * (kBase32Size + 1));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SimdUuid::ToBase32Batch(uuids, buffer));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_SimdUuidToBase32Batch)->RangeMultiplier(4)->Range(1, 1 << 12);
+
+static void BM_SimdUuidFromBase64UrlBatch(benchmark::State &state) {
+  const std::size_t count = state.range(0);
+  std::vector<SimdUuid> uuids = GenerateUuids(count);
+  std::string from(count * (kBase64UrlSize + 1), '\n');
+  SimdUuid::ToBase64UrlBatch(uuids, from);
+  std::vector<SimdUuid> result(count);
+  std::vector<std::uint64_t> valid((count + 63) / 64);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SimdUuid::FromBase64UrlBatch(
+        from, kBase64UrlSize + 1, result, valid));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_SimdUuidFromBase64UrlBatch)
+    ->RangeMultiplier(4)
+    ->Range(1, 1 << 12);
+
+static void BM_SimdUuidFromBase32Batch(benchmark::State &state) {
+  const std::size_t count = state.range(0);
+  std::vector<SimdUuid> uuids = GenerateUuids(count);
+  std::string from(count * (kBase32Size + 1), '\n');
+  SimdUuid::ToBase32Batch(uuids, from);
+  std::vector<SimdUuid> result(count);
+  std::vector<std::uint64_t> valid((count + 63) / 64);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        SimdUuid::FromBase32Batch(from, kBase32Size + 1, result, valid));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_SimdUuidFromBase32Batch)->RangeMultiplier(4)->Range(1, 1 << 12);
+
+// SimdUuid as it was before it was trivially copyable: byte-aligned, with
+// moves that zero the source. The baseline of the container benchmarks below.
+class ZeroingMoveUuid {
+public:
+  ZeroingMoveUuid() = default;
+  explicit ZeroingMoveUuid(const SimdUuid &uuid) {
+    const std::uint64_t halves[] = {std::byteswap(uuid.high()),
+                                    std::byteswap(uuid.low())};
+    std::memcpy(data_.data(), halves, sizeof(halves));
+  }
+  ZeroingMoveUuid(const ZeroingMoveUuid &other) = default;
+  ZeroingMoveUuid &operator=(const ZeroingMoveUuid &other) = default;
+  ZeroingMoveUuid(ZeroingMoveUuid &&other) {
+    data_ = other.data_;
+    other.data_ = {0};
+  }
+  ZeroingMoveUuid &operator=(ZeroingMoveUuid &&other) {
+    if (this != &other) {
+      data_ = other.data_;
+      other.data_ = {0};
+    }
+    return *this;
+  }
+
+  // Same order as SimdUuid, from the same 64-bit loads.
+  bool operator<(const ZeroingMoveUuid &other) const {
+    const std::uint64_t high = LoadBigEndian(0);
+    const std::uint64_t other_high = other.LoadBigEndian(0);
+    return high != other_high ? high < other_high
+                              : LoadBigEndian(8) < other.LoadBigEndian(8);
+  }
+
+private:
+  std::uint64_t LoadBigEndian(std::size_t offset) const {
+    std::uint64_t value;
+    std::memcpy(&value, data_.data() + offset, sizeof(value));
+    return std::byteswap(value);
+  }
+
+  std::array<std::uint8_t, 16> data_ = {0};
+};
+
+template <class Uuid> static std::vector<Uuid> GenerateUuidsOf(int count) {
+  std::vector<Uuid> uuids;
+  for (const SimdUuid &uuid : GenerateUuids(count)) {
+    uuids.push_back(Uuid(uuid));
+  }
+  return uuids;
+}
+
+// Appends UUIDs to a vector without reserving it, so that it reallocates and
+// relocates its UUIDs 17 times.
+template <class Uuid> static void BM_UuidVectorGrowth(benchmark::State &state) {
+  const std::vector<Uuid> uuids = GenerateUuidsOf<Uuid>(state.range(0));
+  for (auto _ : state) {
+    std::vector<Uuid> result;
+    for (const Uuid &uuid : uuids) {
+      result.push_back(uuid);
+    }
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations() * uuids.size());
+}
+BENCHMARK_TEMPLATE(BM_UuidVectorGrowth, SimdUuid)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_UuidVectorGrowth, ZeroingMoveUuid)->Arg(1 << 16);
+
+template <class Uuid> static void BM_UuidVectorCopy(benchmark::State &state) {
+  const std::vector<Uuid> uuids = GenerateUuidsOf<Uuid>(state.range(0));
+  std::vector<Uuid> result(uuids.size());
+  for (auto _ : state) {
+    std::copy(uuids.begin(), uuids.end(), result.begin());
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * uuids.size());
+}
+BENCHMARK_TEMPLATE(BM_UuidVectorCopy, SimdUuid)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_UuidVectorCopy, ZeroingMoveUuid)->Arg(1 << 16);
+
+template <class Uuid> static void BM_UuidSort(benchmark::State &state) {
+  const std::vector<Uuid> uuids = GenerateUuidsOf<Uuid>(state.range(0));
+  std::vector<Uuid> result(uuids.size());
+  for (auto _ : state) {
+    std::copy(uuids.begin(), uuids.end(), result.begin());
+    std::sort(result.begin(), result.end());
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations() * uuids.size());
+}
+BENCHMARK_TEMPLATE(BM_UuidSort, SimdUuid)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_UuidSort, ZeroingMoveUuid)->Arg(1 << 16);
+
+// The following benchmarks call the kernels of every instruction set directly,
+// so that they can be compared on a single machine. The argument is a CpuIsa.
+static const internal::SimdUuidKernels *
+KernelsForBenchmark(benchmark::State &state) {
+  CpuIsa isa = static_cast<CpuIsa>(state.range(0));
+  state.SetLabel(std::string(CpuIsaName(isa)));
+  if (!CpuSupports(isa)) {
+    state.SkipWithError("Instruction set not supported by the CPU");
+    return nullptr;
+  }
+  return &internal::KernelsFor(isa);
+}
+
+static void BM_SimdUuidKernelFromChars(benchmark::State &state) {
+  const internal::SimdUuidKernels *kernels = KernelsForBenchmark(state);
+  if (kernels == nullptr) {
+    return;
+  }
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+  std::string from = std::string(SimdUuid(data));
+
+  std::uint8_t result[16];
+  for (auto _ : state) {
+    for (int i = 0; i < 256; ++i) {
+      benchmark::DoNotOptimize(kernels->from_chars(from.data(), result));
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK(BM_SimdUuidKernelFromChars)->DenseRange(0, 3);
+
+static void BM_SimdUuidKernelToChars(benchmark::State &state) {
+  const internal::SimdUuidKernels *kernels = KernelsForBenchmark(state);
+  if (kernels == nullptr) {
+    return;
+  }
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+
+  char result[36];
+  for (auto _ : state) {
+    for (int i = 0; i < 256; ++i) {
+      kernels->to_chars(data, result);
+      benchmark::DoNotOptimize(result);
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK(BM_SimdUuidKernelToChars)->DenseRange(0, 3);
+
+static void BM_SimdUuidKernelFromCharsStrided(benchmark::State &state) {
+  const internal::SimdUuidKernels *kernels = KernelsForBenchmark(state);
+  if (kernels == nullptr) {
+    return;
+  }
+  std::string from = GenerateUuidLines(64);
+  std::vector<std::uint8_t> result(64 * 16);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        kernels->from_chars_strided(from.data(), 37, 64, result.data()));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(BM_SimdUuidKernelFromCharsStrided)->DenseRange(0, 3);
+
+static void BM_SimdUuidKernelToCharsBatch(benchmark::State &state) {
+  const internal::SimdUuidKernels *kernels = KernelsForBenchmark(state);
+  if (kernels == nullptr) {
+    return;
+  }
+  std::vector<SimdUuid> uuids = GenerateUuids(64);
+  std::vector<char> buffer(64 * 37);
+  for (auto _ : state) {
+    kernels->to_chars_batch(reinterpret_cast<std::uint8_t *>(uuids.data()),
+                            64, '\n', buffer.data());
+    benchmark::DoNotOptimize(buffer.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(BM_SimdUuidKernelToCharsBatch)->DenseRange(0, 3);
+
+// Encodes and decodes base64url or base32 with the kernels of every
+// instruction set.
+static void BM_SimdUuidKernelEncoding(benchmark::State &state,
+                                      bool base32) {
+  const internal::SimdUuidKernels *kernels = KernelsForBenchmark(state);
+  if (kernels == nullptr) {
+    return;
+  }
+  auto encode = base32 ? kernels->to_base32 : kernels->to_base64url;
+  auto decode = base32 ? kernels->from_base32 : kernels->from_base64url;
+  std::uint8_t data[16];
+  GenerateRandomData(data);
+
+  char chars[kBase32Size];
+  for (auto _ : state) {
+    for (int i = 0; i < 256; ++i) {
+      encode(data, chars);
+      benchmark::DoNotOptimize(chars);
+      benchmark::DoNotOptimize(decode(chars, data));
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK_CAPTURE(BM_SimdUuidKernelEncoding, base64url, false)
+    ->DenseRange(0, 3);
+BENCHMARK_CAPTURE(BM_SimdUuidKernelEncoding, base32, true)->DenseRange(0, 3);
+
 static void BM_SimdUuidGeneratorMt19937(benchmark::State &state) {
   SimdUuidGenerator<std::mt19937> generator;
   for (auto _ : state) {
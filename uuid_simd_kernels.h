@@ -0,0 +1,129 @@
+#ifndef ANDYCCS_UUID_SIMD_KERNELS_H
+#define ANDYCCS_UUID_SIMD_KERNELS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+#include "uuid_cpu.h"
+#include "uuid_encoding.h"
+#include "uuid_format.h"
+
+namespace andyccs {
+namespace internal {
+
+using ToCharsKernel = void (*)(const std::uint8_t *data, char *out);
+
+// Kernels behind SimdUuid, one table per instruction set. SimdUuid picks the
+// table for ActiveCpuIsa() once, so a single binary runs on any x86 CPU and
+// still uses the widest registers available.
+//
+// Kernels only see raw bytes. The 16 bytes of a UUID are in string order,
+// i.e. big-endian, and arrays of UUIDs are packed with a stride of 16 bytes.
+struct SimdUuidKernels {
+  // Converts the UUID at `data` to the 36 characters at `out`.
+  ToCharsKernel to_chars;
+
+  // Converts the UUID at `data` to the UuidFormatAt(i).size() characters at
+  // `out`, in format UuidFormatAt(i) for entry i. Every entry is its own
+  // instance of a kernel template, see MakeFormatKernels.
+  std::array<ToCharsKernel, kUuidFormatCount> to_chars_formats;
+
+  // Converts the 36 characters at `in` to the UUID at `out`. Returns false if
+  // the characters are not a valid UUID string, in which case the content of
+  // `out` is unspecified.
+  bool (*from_chars)(const char *in, std::uint8_t *out);
+
+  // Same as above, for the 32 hex digits at `in`, without dashes.
+  bool (*from_chars_compact)(const char *in, std::uint8_t *out);
+
+  // Converts `count` (at most 64) UUID strings, the i-th one starting at
+  // `in + i * stride`, to the UUIDs at `out`. Invalid strings are converted
+  // to zeros. Returns a bitmask where bit i tells whether string i is valid.
+  std::uint64_t (*from_chars_strided)(const char *in, std::size_t stride,
+                                      std::size_t count, std::uint8_t *out);
+
+  // Same as above, for strings scattered in memory. Strings that are not
+  // 36 characters long are invalid.
+  std::uint64_t (*from_chars_views)(const std::string_view *in,
+                                    std::size_t count, std::uint8_t *out);
+
+  // Converts `count` UUIDs at `data` to strings written back to back at
+  // `out`, each followed by `separator`, i.e. 37 characters per UUID.
+  void (*to_chars_batch)(const std::uint8_t *data, std::size_t count,
+                         char separator, char *out);
+
+  // Converts the UUID at `data` to the kBase64UrlSize characters of its
+  // base64url encoding at `out`, see uuid_encoding.h.
+  void (*to_base64url)(const std::uint8_t *data, char *out);
+
+  // Converts the kBase64UrlSize characters at `in` to the UUID at `out`.
+  // Returns false if the characters are not the base64url encoding of a
+  // UUID, in which case the content of `out` is unspecified.
+  bool (*from_base64url)(const char *in, std::uint8_t *out);
+
+  // Same as the two above, for the kBase32Size characters of base32.
+  void (*to_base32)(const std::uint8_t *data, char *out);
+  bool (*from_base32)(const char *in, std::uint8_t *out);
+
+  // Same as to_chars_batch and from_chars_strided, for base64url and base32.
+  // Every UUID takes kBase64UrlSize + 1 or kBase32Size + 1 characters.
+  void (*to_base64url_batch)(const std::uint8_t *data, std::size_t count,
+                             char separator, char *out);
+  std::uint64_t (*from_base64url_strided)(const char *in, std::size_t stride,
+                                          std::size_t count,
+                                          std::uint8_t *out);
+  void (*to_base32_batch)(const std::uint8_t *data, std::size_t count,
+                          char separator, char *out);
+  std::uint64_t (*from_base32_strided)(const char *in, std::size_t stride,
+                                       std::size_t count, std::uint8_t *out);
+};
+
+// Returns the to_chars_formats of a kernel table, given a template lambda
+// such that `make.template operator()<Format>()` returns the kernel for
+// `Format`.
+template <class Make>
+constexpr std::array<ToCharsKernel, kUuidFormatCount>
+MakeFormatKernels(Make make) {
+  return [&]<std::size_t... I>(std::index_sequence<I...>) {
+    return std::array<ToCharsKernel, kUuidFormatCount>{
+        make.template operator()<UuidFormatAt(I)>()...};
+  }(std::make_index_sequence<kUuidFormatCount>());
+}
+
+extern const SimdUuidKernels kScalarKernels;
+#ifdef ANDYCCS_ARCH_X86
+extern const SimdUuidKernels kSse42Kernels;
+extern const SimdUuidKernels kAvx2Kernels;
+extern const SimdUuidKernels kAvx512Kernels;
+
+// The base64url and base32 kernels of kSse42Kernels. A UUID fits in one
+// 128-bit register, so kAvx2Kernels and kAvx512Kernels use them too.
+void ToBase64UrlSse42(const std::uint8_t *data, char *out);
+bool FromBase64UrlSse42(const char *in, std::uint8_t *out);
+void ToBase32Sse42(const std::uint8_t *data, char *out);
+bool FromBase32Sse42(const char *in, std::uint8_t *out);
+void ToBase64UrlBatchSse42(const std::uint8_t *data, std::size_t count,
+                           char separator, char *out);
+std::uint64_t FromBase64UrlStridedSse42(const char *in, std::size_t stride,
+                                        std::size_t count, std::uint8_t *out);
+void ToBase32BatchSse42(const std::uint8_t *data, std::size_t count,
+                        char separator, char *out);
+std::uint64_t FromBase32StridedSse42(const char *in, std::size_t stride,
+                                     std::size_t count, std::uint8_t *out);
+#endif
+
+// Returns the kernels for `isa`, or for the fastest instruction set below it
+// when this build has no kernels for `isa`. The caller must make sure that the
+// CPU supports `isa`.
+const SimdUuidKernels &KernelsFor(CpuIsa isa);
+
+// Returns KernelsFor(ActiveCpuIsa()).
+const SimdUuidKernels &ActiveKernels();
+
+} // namespace internal
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_SIMD_KERNELS_H
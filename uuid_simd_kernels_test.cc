@@ -0,0 +1,371 @@
+#include "uuid_simd_kernels.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace andyccs {
+namespace internal {
+namespace {
+
+// Every kernel is compared against the portable kernels, on every instruction
+// set that the CPU supports.
+class SimdUuidKernelsTest : public testing::TestWithParam<CpuIsa> {
+protected:
+  void SetUp() override {
+    if (!CpuSupports(GetParam())) {
+      GTEST_SKIP() << "CPU does not support " << CpuIsaName(GetParam());
+    }
+  }
+
+  const SimdUuidKernels &kernels() const { return KernelsFor(GetParam()); }
+
+  // Returns `count` random UUIDs, packed in an array.
+  std::vector<uint8_t> RandomUuids(std::size_t count) {
+    std::vector<uint8_t> data(count * 16);
+    for (uint8_t &byte : data) {
+      byte = rng_();
+    }
+    return data;
+  }
+
+  std::mt19937 rng_{42};
+};
+
+TEST_P(SimdUuidKernelsTest, ToChars) {
+  std::vector<uint8_t> data = RandomUuids(100);
+  for (std::size_t i = 0; i < 100; ++i) {
+    char expected[36];
+    char actual[36];
+    kScalarKernels.to_chars(&data[i * 16], expected);
+    kernels().to_chars(&data[i * 16], actual);
+    EXPECT_EQ(std::string(actual, 36), std::string(expected, 36));
+  }
+}
+
+TEST_P(SimdUuidKernelsTest, ToCharsKnownValue) {
+  const uint8_t data[16] = {0xFE, 0xDC, 0xBA, 0x98, 0x76, 0x54, 0x32, 0x10,
+                            0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+  char actual[36];
+  kernels().to_chars(data, actual);
+  EXPECT_EQ(std::string(actual, 36), "FEDCBA98-7654-3210-8899-AABBCCDDEEFF");
+}
+
+TEST_P(SimdUuidKernelsTest, ToCharsFormats) {
+  std::vector<uint8_t> data = RandomUuids(100);
+  for (std::size_t f = 0; f < kUuidFormatCount; ++f) {
+    const std::size_t size = UuidFormatAt(f).size();
+    for (std::size_t i = 0; i < 100; ++i) {
+      char expected[45];
+      char actual[45];
+      kScalarKernels.to_chars_formats[f](&data[i * 16], expected);
+      kernels().to_chars_formats[f](&data[i * 16], actual);
+      EXPECT_EQ(std::string(actual, size), std::string(expected, size))
+          << "format " << f;
+    }
+  }
+}
+
+TEST_P(SimdUuidKernelsTest, ToCharsFormatsWriteOnlyTheString) {
+  const uint8_t data[16] = {0xFE, 0xDC, 0xBA, 0x98, 0x76, 0x54, 0x32, 0x10,
+                            0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+  for (std::size_t f = 0; f < kUuidFormatCount; ++f) {
+    const std::size_t size = UuidFormatAt(f).size();
+    std::string actual(64, '*');
+    kernels().to_chars_formats[f](data, actual.data());
+    EXPECT_EQ(actual.substr(size), std::string(64 - size, '*'))
+        << "format " << f;
+  }
+}
+
+TEST(UuidFormat, Index) {
+  for (std::size_t f = 0; f < kUuidFormatCount; ++f) {
+    EXPECT_EQ(UuidFormatAt(f).index(), f);
+  }
+  EXPECT_EQ(kScalarKernels.to_chars_formats[kUuidUppercase.index()],
+            &FormatUuid<kUuidUppercase>);
+}
+
+TEST_P(SimdUuidKernelsTest, FromChars) {
+  std::vector<uint8_t> data = RandomUuids(100);
+  for (std::size_t i = 0; i < 100; ++i) {
+    char chars[36];
+    kScalarKernels.to_chars(&data[i * 16], chars);
+    uint8_t actual[16];
+    ASSERT_TRUE(kernels().from_chars(chars, actual));
+    EXPECT_TRUE(std::equal(actual, actual + 16, &data[i * 16]));
+  }
+}
+
+TEST_P(SimdUuidKernelsTest, FromCharsInvalid) {
+  const std::string from = "6BBBB416-EDC3-405F-A86D-231D5800235E";
+  uint8_t out[16];
+  for (int i = 0; i < 36; ++i) {
+    for (char c : {'\0', '\x10', '\x19', '-', '/', ':', '@', 'G', 'R', '`',
+                   'g', '\xC1', '\xFF'}) {
+      std::string invalid = from;
+      invalid[i] = c;
+      if (invalid == from) {
+        continue;
+      }
+      EXPECT_FALSE(kernels().from_chars(invalid.data(), out)) << invalid;
+    }
+  }
+}
+
+TEST_P(SimdUuidKernelsTest, FromCharsCompact) {
+  std::vector<uint8_t> data = RandomUuids(100);
+  for (std::size_t i = 0; i < 100; ++i) {
+    char chars[36];
+    kScalarKernels.to_chars(&data[i * 16], chars);
+    std::string compact(chars, 36);
+    std::erase(compact, '-');
+    uint8_t actual[16];
+    ASSERT_TRUE(kernels().from_chars_compact(compact.data(), actual));
+    EXPECT_TRUE(std::equal(actual, actual + 16, &data[i * 16]));
+  }
+}
+
+TEST_P(SimdUuidKernelsTest, FromCharsCompactInvalid) {
+  const std::string from = "6bbbb416EDC3405FA86D231D5800235E";
+  uint8_t out[16];
+  for (int i = 0; i < 32; ++i) {
+    for (char c : {'\0', '\x10', '\x19', '-', '/', ':', '@', 'G', '`', 'g',
+                   '\xC1', '\xFF'}) {
+      std::string invalid = from;
+      invalid[i] = c;
+      EXPECT_FALSE(kernels().from_chars_compact(invalid.data(), out))
+          << invalid;
+    }
+  }
+}
+
+TEST_P(SimdUuidKernelsTest, FromCharsMixedCase) {
+  std::vector<uint8_t> data = RandomUuids(100);
+  std::string from;
+  for (std::size_t i = 0; i < 100; ++i) {
+    char chars[36];
+    kScalarKernels.to_chars(&data[i * 16], chars);
+    // Lowercase for even UUIDs, random case for odd ones.
+    for (char &c : chars) {
+      if (c >= 'A' && c <= 'F' && (i % 2 == 0 || rng_() % 2 == 0)) {
+        c += 'a' - 'A';
+      }
+    }
+    uint8_t actual[16];
+    ASSERT_TRUE(kernels().from_chars(chars, actual)) << std::string(chars, 36);
+    EXPECT_TRUE(std::equal(actual, actual + 16, &data[i * 16]));
+    from.append(chars, 36);
+    from += '\n';
+  }
+
+  std::vector<uint8_t> out(64 * 16);
+  EXPECT_EQ(kernels().from_chars_strided(from.data(), 37, 64, out.data()),
+            ~uint64_t{0});
+  EXPECT_TRUE(std::equal(out.begin(), out.end(), data.begin()));
+
+  std::vector<std::string_view> views;
+  for (std::size_t i = 0; i < 64; ++i) {
+    views.push_back(std::string_view(from).substr(i * 37, 36));
+  }
+  EXPECT_EQ(kernels().from_chars_views(views.data(), 64, out.data()),
+            ~uint64_t{0});
+  EXPECT_TRUE(std::equal(out.begin(), out.end(), data.begin()));
+}
+
+TEST_P(SimdUuidKernelsTest, FromCharsStrided) {
+  std::vector<uint8_t> data = RandomUuids(64);
+  std::string from;
+  for (std::size_t i = 0; i < 64; ++i) {
+    char chars[36];
+    kScalarKernels.to_chars(&data[i * 16], chars);
+    // Make every fifth string invalid.
+    if (i % 5 == 0) {
+      chars[i % 36] = 'G';
+    }
+    from.append(chars, 36);
+    from += ',';
+  }
+
+  for (std::size_t count : {0, 1, 2, 3, 17, 64}) {
+    std::vector<uint8_t> out(count * 16, 0xAA);
+    uint64_t valid = kernels().from_chars_strided(from.data(), 37, count,
+                                                  out.data());
+    for (std::size_t i = 0; i < count; ++i) {
+      bool expected_valid = i % 5 != 0;
+      EXPECT_EQ((valid >> i) & 1, expected_valid) << i;
+      std::vector<uint8_t> expected(16, 0);
+      if (expected_valid) {
+        expected.assign(&data[i * 16], &data[i * 16] + 16);
+      }
+      EXPECT_TRUE(std::equal(expected.begin(), expected.end(), &out[i * 16]));
+    }
+    if (count < 64) {
+      EXPECT_EQ(valid >> count, 0u);
+    }
+  }
+}
+
+TEST_P(SimdUuidKernelsTest, FromCharsViews) {
+  std::vector<uint8_t> data = RandomUuids(20);
+  std::vector<std::string> strings;
+  for (std::size_t i = 0; i < 20; ++i) {
+    char chars[36];
+    kScalarKernels.to_chars(&data[i * 16], chars);
+    strings.emplace_back(chars, 36);
+  }
+  strings[3].pop_back();
+  strings[7] += "0";
+  strings[11][35] = 'G';
+  std::vector<std::string_view> from(strings.begin(), strings.end());
+
+  std::vector<uint8_t> out(20 * 16, 0xAA);
+  uint64_t valid = kernels().from_chars_views(from.data(), 20, out.data());
+  EXPECT_EQ(valid, ((uint64_t{1} << 20) - 1) & ~uint64_t{(1 << 3) | (1 << 7) |
+                                                         (1 << 11)});
+  for (std::size_t i : {3, 7, 11}) {
+    EXPECT_TRUE(std::all_of(&out[i * 16], &out[i * 16] + 16,
+                            [](uint8_t byte) { return byte == 0; }));
+  }
+  EXPECT_TRUE(std::equal(&out[0], &out[16], &data[0]));
+  EXPECT_TRUE(std::equal(&out[19 * 16], &out[20 * 16], &data[19 * 16]));
+}
+
+TEST_P(SimdUuidKernelsTest, ToCharsBatch) {
+  std::vector<uint8_t> data = RandomUuids(9);
+  for (std::size_t count = 0; count <= 9; ++count) {
+    std::string expected(count * 37 + 1, '*');
+    std::string actual(count * 37 + 1, '*');
+    kScalarKernels.to_chars_batch(data.data(), count, ',', expected.data());
+    kernels().to_chars_batch(data.data(), count, ',', actual.data());
+    EXPECT_EQ(actual, expected);
+  }
+}
+
+TEST_P(SimdUuidKernelsTest, Base64Url) {
+  std::vector<uint8_t> data = RandomUuids(100);
+  for (std::size_t i = 0; i < 100; ++i) {
+    char expected[kBase64UrlSize];
+    char actual[kBase64UrlSize];
+    kScalarKernels.to_base64url(&data[i * 16], expected);
+    kernels().to_base64url(&data[i * 16], actual);
+    ASSERT_EQ(std::string(actual, kBase64UrlSize),
+              std::string(expected, kBase64UrlSize));
+    uint8_t out[16];
+    ASSERT_TRUE(kernels().from_base64url(actual, out));
+    EXPECT_TRUE(std::equal(out, out + 16, &data[i * 16]));
+  }
+}
+
+TEST_P(SimdUuidKernelsTest, Base32) {
+  std::vector<uint8_t> data = RandomUuids(100);
+  for (std::size_t i = 0; i < 100; ++i) {
+    char expected[kBase32Size];
+    char actual[kBase32Size];
+    kScalarKernels.to_base32(&data[i * 16], expected);
+    kernels().to_base32(&data[i * 16], actual);
+    ASSERT_EQ(std::string(actual, kBase32Size),
+              std::string(expected, kBase32Size));
+    uint8_t out[16];
+    ASSERT_TRUE(kernels().from_base32(actual, out));
+    EXPECT_TRUE(std::equal(out, out + 16, &data[i * 16]));
+  }
+}
+
+// Every character of every position is accepted or rejected as the portable
+// kernels do, and decoded to the same UUID.
+TEST_P(SimdUuidKernelsTest, FromBase64UrlAnyChar) {
+  const std::string from = "a7u0Fu3DQF-obSMdWAAjXg";
+  for (std::size_t i = 0; i < kBase64UrlSize; ++i) {
+    for (int c = 0; c < 256; ++c) {
+      std::string in = from;
+      in[i] = c;
+      uint8_t expected[16];
+      uint8_t actual[16];
+      const bool valid = kScalarKernels.from_base64url(in.data(), expected);
+      ASSERT_EQ(kernels().from_base64url(in.data(), actual), valid) << in;
+      if (valid) {
+        EXPECT_TRUE(std::equal(actual, actual + 16, expected)) << in;
+      }
+    }
+  }
+}
+
+TEST_P(SimdUuidKernelsTest, FromBase32AnyChar) {
+  const std::string from = "3BQET1DVE381FTGV933NC008TY";
+  for (std::size_t i = 0; i < kBase32Size; ++i) {
+    for (int c = 0; c < 256; ++c) {
+      std::string in = from;
+      in[i] = c;
+      uint8_t expected[16];
+      uint8_t actual[16];
+      const bool valid = kScalarKernels.from_base32(in.data(), expected);
+      ASSERT_EQ(kernels().from_base32(in.data(), actual), valid) << in;
+      if (valid) {
+        EXPECT_TRUE(std::equal(actual, actual + 16, expected)) << in;
+      }
+    }
+  }
+}
+
+TEST_P(SimdUuidKernelsTest, Base64UrlBatch) {
+  std::vector<uint8_t> data = RandomUuids(64);
+  std::string chars(64 * (kBase64UrlSize + 1), '*');
+  kernels().to_base64url_batch(data.data(), 64, ',', chars.data());
+  // Make every fifth string invalid.
+  for (std::size_t i = 0; i < 64; i += 5) {
+    chars[i * (kBase64UrlSize + 1) + i % kBase64UrlSize] = '.';
+  }
+
+  std::vector<uint8_t> out(64 * 16, 0xAA);
+  uint64_t valid = kernels().from_base64url_strided(
+      chars.data(), kBase64UrlSize + 1, 64, out.data());
+  for (std::size_t i = 0; i < 64; ++i) {
+    EXPECT_EQ(chars[i * (kBase64UrlSize + 1) + kBase64UrlSize], ',');
+    bool expected_valid = i % 5 != 0;
+    EXPECT_EQ((valid >> i) & 1, expected_valid) << i;
+    std::vector<uint8_t> expected(16, 0);
+    if (expected_valid) {
+      expected.assign(&data[i * 16], &data[i * 16] + 16);
+    }
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), &out[i * 16]));
+  }
+}
+
+TEST_P(SimdUuidKernelsTest, Base32Batch) {
+  std::vector<uint8_t> data = RandomUuids(64);
+  std::string chars(64 * (kBase32Size + 1), '*');
+  kernels().to_base32_batch(data.data(), 64, ',', chars.data());
+  for (std::size_t i = 0; i < 64; i += 5) {
+    chars[i * (kBase32Size + 1) + i % kBase32Size] = 'U';
+  }
+
+  std::vector<uint8_t> out(64 * 16, 0xAA);
+  uint64_t valid = kernels().from_base32_strided(chars.data(), kBase32Size + 1,
+                                                 64, out.data());
+  for (std::size_t i = 0; i < 64; ++i) {
+    EXPECT_EQ(chars[i * (kBase32Size + 1) + kBase32Size], ',');
+    bool expected_valid = i % 5 != 0;
+    EXPECT_EQ((valid >> i) & 1, expected_valid) << i;
+    std::vector<uint8_t> expected(16, 0);
+    if (expected_valid) {
+      expected.assign(&data[i * 16], &data[i * 16] + 16);
+    }
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), &out[i * 16]));
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AllIsas, SimdUuidKernelsTest,
+    testing::Values(CpuIsa::kScalar, CpuIsa::kSse42, CpuIsa::kAvx2,
+                    CpuIsa::kAvx512),
+    [](const testing::TestParamInfo<CpuIsa> &param_info) {
+      std::string name(CpuIsaName(param_info.param));
+      std::erase(name, '.');
+      return name;
+    });
+
+} // namespace
+} // namespace internal
+} // namespace andyccs
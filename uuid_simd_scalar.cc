@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "uuid_simd_kernels.h"
+
+namespace andyccs {
+namespace internal {
+namespace {
+
+// Portable kernels, used on CPUs without SSE4.2 and on other architectures.
+
+// Maps an ASCII character to its hex value, or to 0xFF if the character is
+// not a hex digit.
+struct HexTable {
+  uint8_t value[256];
+
+  constexpr HexTable() : value{} {
+    for (int i = 0; i < 256; ++i) {
+      value[i] = 0xFF;
+    }
+    for (int i = 0; i < 10; ++i) {
+      value['0' + i] = i;
+    }
+    for (int i = 0; i < 6; ++i) {
+      value['A' + i] = 0xA + i;
+      value['a' + i] = 0xA + i;
+    }
+  }
+};
+
+constexpr HexTable kHexTable;
+
+// Offsets of the first hex digit of each byte in a UUID string.
+constexpr uint8_t kByteOffsets[16] = {0,  2,  4,  6,  9,  11, 14, 16,
+                                      19, 21, 24, 26, 28, 30, 32, 34};
+
+void ToChars(const uint8_t *data, char *out) {
+  constexpr char kHexMap[] = "0123456789ABCDEF";
+  for (int i = 0; i < 16; ++i) {
+    out[kByteOffsets[i]] = kHexMap[data[i] >> 4];
+    out[kByteOffsets[i] + 1] = kHexMap[data[i] & 0x0F];
+  }
+  out[8] = out[13] = out[18] = out[23] = '-';
+}
+
+bool FromChars(const char *in, uint8_t *out) {
+  if (in[8] != '-' || in[13] != '-' || in[18] != '-' || in[23] != '-') {
+    return false;
+  }
+  // Accumulate the table values so that a single branch at the end tells
+  // whether any character was invalid.
+  uint8_t invalid = 0;
+  for (int i = 0; i < 16; ++i) {
+    uint8_t high = kHexTable.value[static_cast<uint8_t>(in[kByteOffsets[i]])];
+    uint8_t low =
+        kHexTable.value[static_cast<uint8_t>(in[kByteOffsets[i] + 1])];
+    invalid |= high | low;
+    out[i] = (high << 4) | (low & 0x0F);
+  }
+  return (invalid & 0xF0) == 0;
+}
+
+bool FromCharsCompact(const char *in, uint8_t *out) {
+  uint8_t invalid = 0;
+  for (int i = 0; i < 16; ++i) {
+    uint8_t high = kHexTable.value[static_cast<uint8_t>(in[2 * i])];
+    uint8_t low = kHexTable.value[static_cast<uint8_t>(in[2 * i + 1])];
+    invalid |= high | low;
+    out[i] = (high << 4) | (low & 0x0F);
+  }
+  return (invalid & 0xF0) == 0;
+}
+
+uint64_t FromCharsStrided(const char *in, std::size_t stride,
+                          std::size_t count, uint8_t *out) {
+  uint64_t valid = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    uint8_t *result = out + i * 16;
+    if (FromChars(in + i * stride, result)) {
+      valid |= uint64_t{1} << i;
+    } else {
+      std::fill(result, result + 16, 0);
+    }
+  }
+  return valid;
+}
+
+uint64_t FromCharsViews(const std::string_view *in, std::size_t count,
+                        uint8_t *out) {
+  uint64_t valid = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    uint8_t *result = out + i * 16;
+    if (in[i].size() == 36 && FromChars(in[i].data(), result)) {
+      valid |= uint64_t{1} << i;
+    } else {
+      std::fill(result, result + 16, 0);
+    }
+  }
+  return valid;
+}
+
+void ToCharsBatch(const uint8_t *data, std::size_t count, char separator,
+                  char *out) {
+  for (std::size_t i = 0; i < count; ++i) {
+    ToChars(data + i * 16, out + i * 37);
+    out[i * 37 + 36] = separator;
+  }
+}
+
+template <void (*Encode)(const uint8_t *, char *), std::size_t kSize>
+void EncodeBatch(const uint8_t *data, std::size_t count, char separator,
+                 char *out) {
+  for (std::size_t i = 0; i < count; ++i) {
+    Encode(data + i * 16, out + i * (kSize + 1));
+    out[i * (kSize + 1) + kSize] = separator;
+  }
+}
+
+template <bool (*Decode)(const char *, uint8_t *)>
+uint64_t DecodeStrided(const char *in, std::size_t stride, std::size_t count,
+                       uint8_t *out) {
+  uint64_t valid = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (Decode(in + i * stride, out + i * 16)) {
+      valid |= uint64_t{1} << i;
+    } else {
+      std::fill(out + i * 16, out + i * 16 + 16, 0);
+    }
+  }
+  return valid;
+}
+
+} // namespace
+
+const SimdUuidKernels kScalarKernels = {
+    .to_chars = &ToChars,
+    .to_chars_formats = MakeFormatKernels(
+        []<UuidFormat Format>() { return &FormatUuid<Format>; }),
+    .from_chars = &FromChars,
+    .from_chars_compact = &FromCharsCompact,
+    .from_chars_strided = &FromCharsStrided,
+    .from_chars_views = &FromCharsViews,
+    .to_chars_batch = &ToCharsBatch,
+    .to_base64url = &EncodeBase64Url,
+    .from_base64url = &DecodeBase64Url,
+    .to_base32 = &EncodeBase32,
+    .from_base32 = &DecodeBase32,
+    .to_base64url_batch = &EncodeBatch<&EncodeBase64Url, kBase64UrlSize>,
+    .from_base64url_strided = &DecodeStrided<&DecodeBase64Url>,
+    .to_base32_batch = &EncodeBatch<&EncodeBase32, kBase32Size>,
+    .from_base32_strided = &DecodeStrided<&DecodeBase32>,
+};
+
+} // namespace internal
+} // namespace andyccs
@@ -0,0 +1,515 @@
+#include "uuid_simd_kernels.h"
+
+#ifdef ANDYCCS_ARCH_X86
+
+#include <algorithm>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace andyccs {
+namespace internal {
+namespace {
+
+// Kernels for CPUs with SSE4.2 but without AVX2. They work on one 128-bit
+// register at a time.
+
+// Converts a 128-bits unsigned int to its 32 hex digits, in string order:
+// first  = digits of bytes 0..7  = characters 0..15 without dashes
+// second = digits of bytes 8..15 = characters 16..31 without dashes
+template <bool kLowercase>
+ANDYCCS_TARGET_SSE42 inline void m128ihex(__m128i input, __m128i *first,
+                                          __m128i *second) {
+  // Split every byte into its high and low nibble, then interleave them so
+  // that each byte holds one hex digit.
+  const __m128i mask = _mm_set1_epi8(0x0F);
+  __m128i high = _mm_and_si128(_mm_srli_epi16(input, 4), mask);
+  __m128i low = _mm_and_si128(input, mask);
+
+  // Map every digit to its ASCII code with a table lookup.
+  const char a = kLowercase ? 'a' : 'A';
+  const __m128i hex_map =
+      _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', a, a + 1,
+                    a + 2, a + 3, a + 4, a + 5);
+  *first = _mm_shuffle_epi8(hex_map, _mm_unpacklo_epi8(high, low));
+  *second = _mm_shuffle_epi8(hex_map, _mm_unpackhi_epi8(high, low));
+}
+
+// Converts a 128-bits unsigned int to an UUIDv4 string representation.
+template <bool kLowercase = false>
+ANDYCCS_TARGET_SSE42 inline void m128itos(__m128i input, char *mem) {
+  __m128i first;
+  __m128i second;
+  m128ihex<kLowercase>(input, &first, &second);
+
+  // Characters 0..15 of the output: "XXXXXXXX-XXXX-XX"
+  const __m128i head_shuffle = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, -128, 8,
+                                             9, 10, 11, -128, 12, 13);
+  const __m128i head_dash =
+      _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, '-', 0, 0, 0, 0, '-', 0, 0);
+  __m128i head =
+      _mm_or_si128(_mm_shuffle_epi8(first, head_shuffle), head_dash);
+
+  // Characters 16..31 of the output: "XX-XXXX-XXXXXXXX". The first two come
+  // from the end of `first`.
+  const __m128i body_shuffle = _mm_setr_epi8(0, 1, -128, 2, 3, 4, 5, -128, 6,
+                                             7, 8, 9, 10, 11, 12, 13);
+  const __m128i body_dash =
+      _mm_setr_epi8(0, 0, '-', 0, 0, 0, 0, '-', 0, 0, 0, 0, 0, 0, 0, 0);
+  __m128i body = _mm_or_si128(
+      _mm_shuffle_epi8(_mm_alignr_epi8(second, first, 14), body_shuffle),
+      body_dash);
+
+  // Characters 32..35 of the output are the last 4 digits of `second`.
+  _mm_storeu_si128((__m128i *)mem, head);
+  _mm_storeu_si128((__m128i *)(mem + 16), body);
+  *(uint32_t *)(mem + 32) = _mm_extract_epi32(second, 3);
+}
+
+ANDYCCS_TARGET_SSE42 inline bool ValidateInput(__m128i pretty_input) {
+  const __m128i allowed_char_range =
+      _mm_setr_epi8('0', '9', 'A', 'F', 'a', 'f', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  return _mm_cmpistri(allowed_char_range, pretty_input,
+                      _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES |
+                          _SIDD_NEGATIVE_POLARITY | _SIDD_LEAST_SIGNIFICANT) ==
+         16;
+}
+
+// Converts 16 hex digits to their values, one per byte.
+ANDYCCS_TARGET_SSE42 inline __m128i HexToNibbles(__m128i pretty_input) {
+  // Setting bit 5 turns 'A'-'F' into 'a'-'f', and leaves digits as they are.
+  __m128i folded = _mm_or_si128(pretty_input, _mm_set1_epi8(0x20));
+  // Subtract '0' from digits and 'a' - 0xA from alphas.
+  __m128i alpha = _mm_cmpgt_epi8(folded, _mm_set1_epi8('9'));
+  __m128i offset =
+      _mm_blendv_epi8(_mm_set1_epi8('0'), _mm_set1_epi8(0x57), alpha);
+  return _mm_sub_epi8(folded, offset);
+}
+
+// Converts the 32 hex digits in `first` and `second` to 16 bytes. Returns
+// false if any of them is not a hex digit.
+ANDYCCS_TARGET_SSE42 inline bool DigitsToBytes(__m128i first, __m128i second,
+                                               __m128i *result) {
+  if (!ValidateInput(first) || !ValidateInput(second)) {
+    return false;
+  }
+
+  // Multiply the high nibble of each pair by 16 and add the low nibble.
+  const __m128i weights = _mm_set1_epi16(0x0110);
+  __m128i first_bytes = _mm_maddubs_epi16(HexToNibbles(first), weights);
+  __m128i second_bytes = _mm_maddubs_epi16(HexToNibbles(second), weights);
+  *result = _mm_packus_epi16(first_bytes, second_bytes);
+  return true;
+}
+
+// Converts an UUIDv4 string representation to a 128-bits unsigned int.
+ANDYCCS_TARGET_SSE42 inline bool stom128i(const char *mem, __m128i *result) {
+  if (mem[8] != '-' || mem[13] != '-' || mem[18] != '-' || mem[23] != '-') {
+    return false;
+  }
+
+  // Characters 0..15, 16..31 and 20..35 of the string.
+  __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(mem));
+  __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(mem + 16));
+  __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(mem + 20));
+
+  // Gather the 32 hex digits without dashes.
+  // first  = a[0..7] a[9..12] a[14..15] b[0..1]
+  // second = b[3..6] c[4..15]
+  __m128i first = _mm_or_si128(
+      _mm_shuffle_epi8(a, _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12,
+                                        14, 15, -128, -128)),
+      _mm_shuffle_epi8(b, _mm_setr_epi8(-128, -128, -128, -128, -128, -128,
+                                        -128, -128, -128, -128, -128, -128,
+                                        -128, -128, 0, 1)));
+  __m128i second = _mm_or_si128(
+      _mm_shuffle_epi8(b, _mm_setr_epi8(3, 4, 5, 6, -128, -128, -128, -128,
+                                        -128, -128, -128, -128, -128, -128,
+                                        -128, -128)),
+      _mm_shuffle_epi8(c, _mm_setr_epi8(-128, -128, -128, -128, 4, 5, 6, 7, 8,
+                                        9, 10, 11, 12, 13, 14, 15)));
+  return DigitsToBytes(first, second, result);
+}
+
+ANDYCCS_TARGET_SSE42 void ToChars(const uint8_t *data, char *out) {
+  m128itos(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data)), out);
+}
+
+template <UuidFormat Format>
+ANDYCCS_TARGET_SSE42 void ToCharsFormat(const uint8_t *data, char *out) {
+  __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+  WriteAffixes<Format>(out);
+  out += Format.prefix().size();
+  if constexpr (Format.dashes()) {
+    m128itos<Format.lowercase>(input, out);
+  } else {
+    __m128i first;
+    __m128i second;
+    m128ihex<Format.lowercase>(input, &first, &second);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), first);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16), second);
+  }
+}
+
+ANDYCCS_TARGET_SSE42 bool FromChars(const char *in, uint8_t *out) {
+  __m128i result;
+  if (!stom128i(in, &result)) {
+    return false;
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), result);
+  return true;
+}
+
+ANDYCCS_TARGET_SSE42 bool FromCharsCompact(const char *in, uint8_t *out) {
+  const __m128i *digits = reinterpret_cast<const __m128i *>(in);
+  __m128i result;
+  if (!DigitsToBytes(_mm_loadu_si128(digits), _mm_loadu_si128(digits + 1),
+                     &result)) {
+    return false;
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), result);
+  return true;
+}
+
+ANDYCCS_TARGET_SSE42 uint64_t FromCharsStrided(const char *in,
+                                               std::size_t stride,
+                                               std::size_t count,
+                                               uint8_t *out) {
+  uint64_t valid = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    __m128i result = _mm_setzero_si128();
+    bool ok = stom128i(in + i * stride, &result);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i * 16), result);
+    valid |= uint64_t{ok} << i;
+  }
+  return valid;
+}
+
+ANDYCCS_TARGET_SSE42 uint64_t FromCharsViews(const std::string_view *in,
+                                             std::size_t count, uint8_t *out) {
+  uint64_t valid = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    __m128i result = _mm_setzero_si128();
+    bool ok = in[i].size() == 36 && stom128i(in[i].data(), &result);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i * 16), result);
+    valid |= uint64_t{ok} << i;
+  }
+  return valid;
+}
+
+ANDYCCS_TARGET_SSE42 void ToCharsBatch(const uint8_t *data, std::size_t count,
+                                       char separator, char *out) {
+  for (std::size_t i = 0; i < count; ++i) {
+    m128itos(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i * 16)),
+             out + i * 37);
+    out[i * 37 + 36] = separator;
+  }
+}
+
+// Base64url and base32 encode a UUID kBits at a time, after kLeadingZeros
+// zero bits, see uuid_encoding.h. The bits of character k are within the
+// 16-bit big-endian word at `byte`, and the character is that word shifted
+// right by `shift`, masked to kBits bits.
+struct BitField {
+  int byte;
+  int shift;
+};
+
+constexpr BitField FieldOf(int k, int bits, int leading_zeros) {
+  const int offset = bits * k - leading_zeros;
+  const int byte = offset >= 0 ? offset / 8 : -1;
+  return {byte, 16 - bits - (offset - 8 * byte)};
+}
+
+// pshufb indices that load the word of every character, 8 characters per
+// register, and multipliers that shift them right with pmulhuw.
+template <int kBits, int kLeadingZeros, int kRegisters> struct FieldTables {
+  alignas(16) int8_t shuffle[kRegisters][16];
+  alignas(16) uint16_t multiplier[kRegisters][8];
+
+  constexpr FieldTables() : shuffle{}, multiplier{} {
+    auto index = [](int byte) -> int8_t {
+      return byte >= 0 && byte < 16 ? byte : -128;
+    };
+    for (int r = 0; r < kRegisters; ++r) {
+      for (int w = 0; w < 8; ++w) {
+        const BitField field = FieldOf(8 * r + w, kBits, kLeadingZeros);
+        shuffle[r][2 * w] = index(field.byte + 1);
+        shuffle[r][2 * w + 1] = index(field.byte);
+        multiplier[r][w] = 1 << (16 - field.shift);
+      }
+    }
+  }
+};
+
+// Splits the UUID in `input` into 32 values of kBits bits, 16 per register.
+// Values past the end of the encoding are garbage.
+template <int kBits, int kLeadingZeros>
+ANDYCCS_TARGET_SSE42 inline void ExtractFields(__m128i input,
+                                               __m128i *fields) {
+  static constexpr FieldTables<kBits, kLeadingZeros, 4> kTables;
+  const __m128i mask = _mm_set1_epi16((1 << kBits) - 1);
+  __m128i words[4];
+  for (int r = 0; r < 4; ++r) {
+    __m128i word = _mm_shuffle_epi8(
+        input,
+        _mm_load_si128(reinterpret_cast<const __m128i *>(kTables.shuffle[r])));
+    word = _mm_mulhi_epu16(word, _mm_load_si128(reinterpret_cast<const __m128i *>(
+                                     kTables.multiplier[r])));
+    words[r] = _mm_and_si128(word, mask);
+  }
+  fields[0] = _mm_packus_epi16(words[0], words[1]);
+  fields[1] = _mm_packus_epi16(words[2], words[3]);
+}
+
+// Maps values in [0, 64) to base64url characters.
+ANDYCCS_TARGET_SSE42 inline __m128i Base64UrlChars(__m128i values) {
+  // Index of the offset to add: 0 for 'A'-'Z', 1 for 'a'-'z', 2..11 for
+  // '0'-'9', 12 for '-' and 13 for '_'.
+  __m128i index = _mm_subs_epu8(values, _mm_set1_epi8(51));
+  index = _mm_sub_epi8(index, _mm_cmpgt_epi8(values, _mm_set1_epi8(25)));
+  const __m128i offsets = _mm_setr_epi8(
+      'A', 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 0, 0);
+  return _mm_add_epi8(values, _mm_shuffle_epi8(offsets, index));
+}
+
+// Maps values in [0, 32) to base32 characters.
+ANDYCCS_TARGET_SSE42 inline __m128i Base32Chars(__m128i values) {
+  const __m128i *alphabet = reinterpret_cast<const __m128i *>(kBase32Alphabet);
+  return _mm_blendv_epi8(_mm_shuffle_epi8(_mm_loadu_si128(alphabet), values),
+                         _mm_shuffle_epi8(_mm_loadu_si128(alphabet + 1), values),
+                         _mm_cmpgt_epi8(values, _mm_set1_epi8(15)));
+}
+
+// Returns 0xFF for the bytes of `chars` in [first, first + count), and 0 for
+// the others.
+ANDYCCS_TARGET_SSE42 inline __m128i InRange(__m128i chars, char first,
+                                            char count) {
+  __m128i offset = _mm_sub_epi8(chars, _mm_set1_epi8(first));
+  return _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(count - 1)),
+                        offset);
+}
+
+// Maps base64url characters to their values. Bit 7 is set for bytes that are
+// not base64url characters.
+//
+// The high nibble of a character picks the offset to add, which is right for
+// every character of the alphabet but '_', which shares its nibble with 'P' to
+// 'Z'. Mapping the values back to characters then tells valid characters
+// apart, as every value has only one character.
+ANDYCCS_TARGET_SSE42 inline __m128i Base64UrlValues(__m128i chars) {
+  const __m128i high = _mm_and_si128(_mm_srli_epi16(chars, 4),
+                                     _mm_set1_epi8(0x0F));
+  const __m128i offsets = _mm_setr_epi8(0, 0, 62 - '-', 52 - '0', -'A', -'A',
+                                        26 - 'a', 26 - 'a', 0, 0, 0, 0, 0, 0,
+                                        0, 0);
+  const __m128i underscore = _mm_cmpeq_epi8(chars, _mm_set1_epi8('_'));
+  __m128i values = _mm_add_epi8(chars, _mm_shuffle_epi8(offsets, high));
+  values = _mm_blendv_epi8(values, _mm_set1_epi8(63), underscore);
+  values = _mm_and_si128(values, _mm_set1_epi8(0x3F));
+  const __m128i valid = _mm_cmpeq_epi8(Base64UrlChars(values), chars);
+  return _mm_or_si128(values, _mm_andnot_si128(valid, _mm_set1_epi8(-128)));
+}
+
+// Maps base32 characters to their values. Bit 7 is set for bytes that are not
+// base32 characters.
+ANDYCCS_TARGET_SSE42 inline __m128i Base32Values(__m128i chars) {
+  const __m128i digit = InRange(chars, '0', 10);
+  // Setting bit 5 lowercases letters. Only letters become letters, see
+  // HexToNibbles.
+  const __m128i folded = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+  const __m128i letter = InRange(folded, 'a', 26);
+  // Letters go through kBase32Table, which has the aliases and marks 'u' as
+  // invalid.
+  const __m128i index = _mm_sub_epi8(folded, _mm_set1_epi8('a'));
+  const __m128i *table =
+      reinterpret_cast<const __m128i *>(kBase32Table.value + 'a');
+  const __m128i letter_values = _mm_blendv_epi8(
+      _mm_shuffle_epi8(_mm_loadu_si128(table), index),
+      _mm_shuffle_epi8(_mm_loadu_si128(table + 1), index),
+      _mm_cmpgt_epi8(index, _mm_set1_epi8(15)));
+  const __m128i digit_values = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+  return _mm_or_si128(
+      _mm_or_si128(_mm_and_si128(digit, digit_values),
+                   _mm_and_si128(letter, letter_values)),
+      _mm_andnot_si128(_mm_or_si128(digit, letter), _mm_set1_epi8(-128)));
+}
+
+// Packs every 4 values of 6 bits into the low 24 bits of their 32-bit lane,
+// most significant value first.
+ANDYCCS_TARGET_SSE42 inline __m128i PackBase64(__m128i values) {
+  __m128i words = _mm_maddubs_epi16(values, _mm_set1_epi16(0x0140));
+  return _mm_madd_epi16(words, _mm_set1_epi32(0x00011000));
+}
+
+// Packs every 8 values of 5 bits into the low 40 bits of their 64-bit lane,
+// most significant value first.
+ANDYCCS_TARGET_SSE42 inline __m128i PackBase32(__m128i values) {
+  __m128i words = _mm_maddubs_epi16(values, _mm_set1_epi16(0x0120));
+  __m128i dwords = _mm_madd_epi16(words, _mm_set1_epi32(0x00010400));
+  return _mm_or_si128(_mm_srli_epi64(_mm_slli_epi64(dwords, 32), 12),
+                      _mm_srli_epi64(dwords, 32));
+}
+
+} // namespace
+
+ANDYCCS_TARGET_SSE42 void ToBase64UrlSse42(const uint8_t *data, char *out) {
+  __m128i fields[2];
+  ExtractFields<6, 0>(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(data)), fields);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                   Base64UrlChars(fields[0]));
+  // Characters 16..21.
+  __m128i tail = Base64UrlChars(fields[1]);
+  *(uint32_t *)(out + 16) = _mm_cvtsi128_si32(tail);
+  *(uint16_t *)(out + 20) = _mm_extract_epi16(tail, 2);
+}
+
+ANDYCCS_TARGET_SSE42 bool FromBase64UrlSse42(const char *in, uint8_t *out) {
+  // Characters 0..15, and characters 16..21 followed by 'A's, i.e. zeros.
+  __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+  __m128i tail = _mm_shuffle_epi8(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 6)),
+      _mm_setr_epi8(10, 11, 12, 13, 14, 15, -128, -128, -128, -128, -128, -128,
+                    -128, -128, -128, -128));
+  tail = _mm_or_si128(tail, _mm_setr_epi8(0, 0, 0, 0, 0, 0, 'A', 'A', 'A', 'A',
+                                          'A', 'A', 'A', 'A', 'A', 'A'));
+  head = Base64UrlValues(head);
+  tail = Base64UrlValues(tail);
+  if (_mm_movemask_epi8(_mm_or_si128(head, tail)) != 0) {
+    return false;
+  }
+
+  head = PackBase64(head);
+  tail = PackBase64(tail);
+  // Characters 20 and 21 give byte 15, and 4 bits that must be zeros.
+  if (!_mm_testz_si128(tail, _mm_setr_epi32(0, 0xFFFF, 0, 0))) {
+    return false;
+  }
+  __m128i bytes = _mm_or_si128(
+      _mm_shuffle_epi8(head, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13,
+                                           12, -128, -128, -128, -128)),
+      _mm_shuffle_epi8(tail, _mm_setr_epi8(-128, -128, -128, -128, -128, -128,
+                                           -128, -128, -128, -128, -128, -128,
+                                           2, 1, 0, 6)));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), bytes);
+  return true;
+}
+
+ANDYCCS_TARGET_SSE42 void ToBase32Sse42(const uint8_t *data, char *out) {
+  __m128i fields[2];
+  ExtractFields<5, 2>(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(data)), fields);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), Base32Chars(fields[0]));
+  // Characters 16..25.
+  __m128i tail = Base32Chars(fields[1]);
+  _mm_storel_epi64(reinterpret_cast<__m128i *>(out + 16), tail);
+  *(uint16_t *)(out + 24) = _mm_extract_epi16(tail, 4);
+}
+
+ANDYCCS_TARGET_SSE42 bool FromBase32Sse42(const char *in, uint8_t *out) {
+  // Every 8 characters give 5 bytes. Characters 0 and 1, preceded by '0's,
+  // i.e. zeros, give byte 0, and characters 2..9, 10..17 and 18..25 give the
+  // other 15 bytes.
+  __m128i head = _mm_shuffle_epi8(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(in)),
+      _mm_setr_epi8(-128, -128, -128, -128, -128, -128, 0, 1, 2, 3, 4, 5, 6, 7,
+                    8, 9));
+  head = _mm_or_si128(head, _mm_setr_epi8('0', '0', '0', '0', '0', '0', 0, 0, 0,
+                                          0, 0, 0, 0, 0, 0, 0));
+  __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 10));
+  head = Base32Values(head);
+  tail = Base32Values(tail);
+  if (_mm_movemask_epi8(_mm_or_si128(head, tail)) != 0) {
+    return false;
+  }
+
+  head = PackBase32(head);
+  tail = PackBase32(tail);
+  // The first character only carries 3 bits, so byte 0 must be all there is.
+  if (!_mm_testz_si128(head, _mm_set_epi64x(0, 0xFFFFFFFF00))) {
+    return false;
+  }
+  __m128i bytes = _mm_or_si128(
+      _mm_shuffle_epi8(head, _mm_setr_epi8(0, 12, 11, 10, 9, 8, -128, -128,
+                                           -128, -128, -128, -128, -128, -128,
+                                           -128, -128)),
+      _mm_shuffle_epi8(tail, _mm_setr_epi8(-128, -128, -128, -128, -128, -128,
+                                           4, 3, 2, 1, 0, 12, 11, 10, 9, 8)));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), bytes);
+  return true;
+}
+
+ANDYCCS_TARGET_SSE42 void ToBase64UrlBatchSse42(const uint8_t *data,
+                                                std::size_t count,
+                                                char separator, char *out) {
+  for (std::size_t i = 0; i < count; ++i) {
+    ToBase64UrlSse42(data + i * 16, out + i * (kBase64UrlSize + 1));
+    out[i * (kBase64UrlSize + 1) + kBase64UrlSize] = separator;
+  }
+}
+
+ANDYCCS_TARGET_SSE42 uint64_t FromBase64UrlStridedSse42(const char *in,
+                                                        std::size_t stride,
+                                                        std::size_t count,
+                                                        uint8_t *out) {
+  uint64_t valid = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (FromBase64UrlSse42(in + i * stride, out + i * 16)) {
+      valid |= uint64_t{1} << i;
+    } else {
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i * 16),
+                       _mm_setzero_si128());
+    }
+  }
+  return valid;
+}
+
+ANDYCCS_TARGET_SSE42 void ToBase32BatchSse42(const uint8_t *data,
+                                             std::size_t count, char separator,
+                                             char *out) {
+  for (std::size_t i = 0; i < count; ++i) {
+    ToBase32Sse42(data + i * 16, out + i * (kBase32Size + 1));
+    out[i * (kBase32Size + 1) + kBase32Size] = separator;
+  }
+}
+
+ANDYCCS_TARGET_SSE42 uint64_t FromBase32StridedSse42(const char *in,
+                                                     std::size_t stride,
+                                                     std::size_t count,
+                                                     uint8_t *out) {
+  uint64_t valid = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (FromBase32Sse42(in + i * stride, out + i * 16)) {
+      valid |= uint64_t{1} << i;
+    } else {
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i * 16),
+                       _mm_setzero_si128());
+    }
+  }
+  return valid;
+}
+
+const SimdUuidKernels kSse42Kernels = {
+    .to_chars = &ToChars,
+    .to_chars_formats = MakeFormatKernels(
+        []<UuidFormat Format>() { return &ToCharsFormat<Format>; }),
+    .from_chars = &FromChars,
+    .from_chars_compact = &FromCharsCompact,
+    .from_chars_strided = &FromCharsStrided,
+    .from_chars_views = &FromCharsViews,
+    .to_chars_batch = &ToCharsBatch,
+    .to_base64url = &ToBase64UrlSse42,
+    .from_base64url = &FromBase64UrlSse42,
+    .to_base32 = &ToBase32Sse42,
+    .from_base32 = &FromBase32Sse42,
+    .to_base64url_batch = &ToBase64UrlBatchSse42,
+    .from_base64url_strided = &FromBase64UrlStridedSse42,
+    .to_base32_batch = &ToBase32BatchSse42,
+    .from_base32_strided = &FromBase32StridedSse42,
+};
+
+} // namespace internal
+} // namespace andyccs
+
+#endif // ANDYCCS_ARCH_X86
@@ -1,7 +1,13 @@
 #include "uuid_simd.h"
 
+#include <cstdint>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <random>
+#include <sstream>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
 
 namespace andyccs {
 
@@ -47,16 +53,29 @@ TEST(SimdUuid, Move) {
                            0xA8, 0x6D, 0x23, 0x1D, 0x58, 0x0,  0x23, 0x5E};
   SimdUuid uuid_1(data);
   SimdUuid uuid_2(std::move(uuid_1));
-  EXPECT_EQ(uuid_1, SimdUuid());
   EXPECT_EQ(uuid_2, SimdUuid(data));
 
   SimdUuid uuid_3(data);
-  SimdUuid uuid_4(data);
+  SimdUuid uuid_4;
   uuid_4 = std::move(uuid_3);
-  EXPECT_EQ(uuid_3, SimdUuid());
   EXPECT_EQ(uuid_4, SimdUuid(data));
 }
 
+TEST(SimdUuid, TriviallyCopyable) {
+  static_assert(std::is_trivially_copyable_v<SimdUuid>);
+  static_assert(std::is_nothrow_move_constructible_v<SimdUuid>);
+  static_assert(alignof(SimdUuid) == 16);
+
+  std::vector<SimdUuid> uuids(3, SimdUuid(1, 2));
+  for (const SimdUuid &uuid : uuids) {
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&uuid) % 16, 0u);
+  }
+  // Moving copies the value, as for integers.
+  SimdUuid uuid_1(1, 2);
+  SimdUuid uuid_2(std::move(uuid_1));
+  EXPECT_EQ(uuid_1, uuid_2);
+}
+
 TEST(SimdUuid, StringOperator) {
   std::uint8_t data[16] = {0x6B, 0xBB, 0xB4, 0x16, 0xED, 0xC3, 0x40, 0x5F,
                            0xA8, 0x6D, 0x23, 0x1D, 0x58, 0x0,  0x23, 0x5E};
@@ -74,6 +93,68 @@ TEST(SimdUuid, ToString) {
   EXPECT_EQ(result, "6BBBB416-EDC3-405F-A86D-231D5800235E");
 }
 
+TEST(SimdUuid, ToUuidString) {
+  SimdUuid uuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E);
+  const UuidString result = uuid.ToString();
+  EXPECT_EQ(result, "6BBBB416-EDC3-405F-A86D-231D5800235E");
+  EXPECT_EQ(result.size(), 36u);
+  EXPECT_EQ(std::strlen(result.c_str()), 36u);
+  EXPECT_EQ(std::string(result), std::string(uuid));
+
+  EXPECT_EQ(uuid.ToString<kUuidLowercase>(),
+            "6bbbb416-edc3-405f-a86d-231d5800235e");
+  EXPECT_EQ(uuid.ToString<kUuidCompact>(), "6BBBB416EDC3405FA86D231D5800235E");
+  EXPECT_EQ(uuid.ToString<kUuidBraced>(),
+            "{6BBBB416-EDC3-405F-A86D-231D5800235E}");
+  const UuidString urn = uuid.ToString<kUuidUrn>();
+  EXPECT_EQ(std::string_view(urn),
+            "urn:uuid:6bbbb416-edc3-405f-a86d-231d5800235e");
+  EXPECT_EQ(urn.size(), UuidString::kCapacity);
+  EXPECT_EQ(urn.c_str()[urn.size()], '\0');
+
+  EXPECT_TRUE(UuidString().empty());
+  EXPECT_EQ(UuidString(), "");
+
+  std::ostringstream out;
+  out << uuid.ToString() << ' ' << urn;
+  EXPECT_EQ(out.str(), "6BBBB416-EDC3-405F-A86D-231D5800235E "
+                       "urn:uuid:6bbbb416-edc3-405f-a86d-231d5800235e");
+}
+
+TEST(SimdUuid, ToStringFormat) {
+  SimdUuid uuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E);
+  std::string result;
+  uuid.ToString<kUuidUppercase>(result);
+  EXPECT_EQ(result, "6BBBB416-EDC3-405F-A86D-231D5800235E");
+  uuid.ToString<kUuidLowercase>(result);
+  EXPECT_EQ(result, "6bbbb416-edc3-405f-a86d-231d5800235e");
+  uuid.ToString<kUuidCompact>(result);
+  EXPECT_EQ(result, "6BBBB416EDC3405FA86D231D5800235E");
+  uuid.ToString<kUuidBraced>(result);
+  EXPECT_EQ(result, "{6BBBB416-EDC3-405F-A86D-231D5800235E}");
+  uuid.ToString<kUuidUrn>(result);
+  EXPECT_EQ(result, "urn:uuid:6bbbb416-edc3-405f-a86d-231d5800235e");
+  uuid.ToString<UuidFormat{UuidLayout::kCompact, true}>(result);
+  EXPECT_EQ(result, "6bbbb416edc3405fa86d231d5800235e");
+  uuid.ToString<UuidFormat{UuidLayout::kBraced, true}>(result);
+  EXPECT_EQ(result, "{6bbbb416-edc3-405f-a86d-231d5800235e}");
+  uuid.ToString<UuidFormat{UuidLayout::kUrn, false}>(result);
+  EXPECT_EQ(result, "urn:uuid:6BBBB416-EDC3-405F-A86D-231D5800235E");
+}
+
+TEST(SimdUuid, ToCharsFormat) {
+  SimdUuid uuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF);
+  char braced[kUuidBraced.size() + 1];
+  uuid.ToChars<kUuidBraced>(braced);
+  EXPECT_EQ(std::string(braced), "{FEDCBA98-7654-3210-8899-AABBCCDDEEFF}");
+  char compact[kUuidCompact.size() + 1];
+  uuid.ToChars<kUuidCompact>(compact);
+  EXPECT_EQ(std::string(compact), "FEDCBA98765432108899AABBCCDDEEFF");
+  char urn[kUuidUrn.size() + 1];
+  uuid.ToChars<kUuidUrn>(urn);
+  EXPECT_EQ(std::string(urn), "urn:uuid:fedcba98-7654-3210-8899-aabbccddeeff");
+}
+
 TEST(SimdUuid, ToChars) {
   std::uint8_t data[16] = {0x6B, 0xBB, 0xB4, 0x16, 0xED, 0xC3, 0x40, 0x5F,
                            0xA8, 0x6D, 0x23, 0x1D, 0x58, 0x0,  0x23, 0x5E};
@@ -84,6 +165,45 @@ TEST(SimdUuid, ToChars) {
   EXPECT_EQ(std::string(result), "6BBBB416-EDC3-405F-A86D-231D5800235E");
 }
 
+TEST(SimdUuid, ToCharsBatch) {
+  std::mt19937_64 rng(42);
+  std::vector<SimdUuid> uuids;
+  std::string expected;
+  for (int i = 0; i < 9; ++i) {
+    std::vector<char> buffer(uuids.size() * 37);
+    EXPECT_EQ(SimdUuid::ToCharsBatch(uuids, buffer), buffer.size());
+    EXPECT_EQ(std::string(buffer.begin(), buffer.end()), expected);
+
+    uuids.push_back(SimdUuid(rng(), rng()));
+    expected += std::string(uuids.back()) + "\n";
+  }
+}
+
+TEST(SimdUuid, ToCharsBatchSeparator) {
+  std::vector<SimdUuid> uuids = {
+      SimdUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF),
+      SimdUuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E),
+      SimdUuid(0x0123456789ABCDEF, 0x0123456789ABCDEF)};
+  char buffer[3 * 37];
+  EXPECT_EQ(SimdUuid::ToCharsBatch(uuids, buffer, ','), 3 * 37);
+  EXPECT_EQ(std::string(buffer, 3 * 37),
+            "FEDCBA98-7654-3210-8899-AABBCCDDEEFF,"
+            "6BBBB416-EDC3-405F-A86D-231D5800235E,"
+            "01234567-89AB-CDEF-0123-456789ABCDEF,");
+}
+
+TEST(SimdUuid, ToCharsBatchBufferTooSmall) {
+  std::vector<SimdUuid> uuids = {
+      SimdUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF),
+      SimdUuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E),
+      SimdUuid(0x0123456789ABCDEF, 0x0123456789ABCDEF)};
+  std::string buffer(2 * 37 + 36, '*');
+  EXPECT_EQ(SimdUuid::ToCharsBatch(uuids, buffer), 2 * 37);
+  EXPECT_EQ(buffer, "FEDCBA98-7654-3210-8899-AABBCCDDEEFF\n"
+                    "6BBBB416-EDC3-405F-A86D-231D5800235E\n" +
+                        std::string(36, '*'));
+}
+
 TEST(SimdUuid, FromString) {
   std::string from = "6BBBB416-EDC3-405F-A86D-231D5800235E";
   std::optional<SimdUuid> uuid = SimdUuid::FromString(from);
@@ -112,13 +232,305 @@ TEST(SimdUuid, FromStringInvalidDash) {
   }
 }
 
-TEST(SimdUuid, FromStringInvalidLowerCase) {
-  std::string from = "6BBBB416-EDC3-405F-A86D-231D5800235E";
+TEST(SimdUuid, FromStringLowerCase) {
+  std::optional<SimdUuid> uuid =
+      SimdUuid::FromString("6bbbb416-edc3-405f-a86d-231d5800235e");
+  ASSERT_TRUE(uuid.has_value());
+  EXPECT_EQ(std::string(*uuid), "6BBBB416-EDC3-405F-A86D-231D5800235E");
+}
+
+TEST(SimdUuid, FromStringMixedCase) {
+  std::optional<SimdUuid> uuid =
+      SimdUuid::FromString("FeDcBa98-7654-3210-8899-aAbBcCdDeEfF");
+  ASSERT_TRUE(uuid.has_value());
+  EXPECT_EQ(std::string(*uuid), "FEDCBA98-7654-3210-8899-AABBCCDDEEFF");
+}
+
+TEST(SimdUuid, FromStringInvalidNextToHex) {
+  // Characters right before and after the ranges of hex digits, and the ones
+  // that become digits if bit 5 is set.
+  std::string from = "6bbbb416-EDC3-405F-A86D-231D5800235E";
   for (int i = 0; i < 36; ++i) {
-    std::string from_invalid_dash = from;
-    from_invalid_dash[i] = 'a';
-    EXPECT_FALSE(SimdUuid::FromString(from_invalid_dash).has_value());
+    for (char c : {'/', ':', '@', 'G', '`', 'g', '\x10', '\x19'}) {
+      std::string from_invalid_hex = from;
+      from_invalid_hex[i] = c;
+      EXPECT_FALSE(SimdUuid::FromString(from_invalid_hex).has_value())
+          << from_invalid_hex;
+    }
+  }
+}
+
+TEST(SimdUuid, Parse) {
+  const std::string expected = "6BBBB416-EDC3-405F-A86D-231D5800235E";
+  for (std::string from : {"6BBBB416-EDC3-405F-A86D-231D5800235E",
+                           "6BBBB416EDC3405FA86D231D5800235E",
+                           "{6BBBB416-EDC3-405F-A86D-231D5800235E}",
+                           "urn:uuid:6BBBB416-EDC3-405F-A86D-231D5800235E",
+                           "6bbbb416edc3405fa86d231d5800235e",
+                           "{6bbbb416-EDC3-405f-A86D-231d5800235e}",
+                           "URN:UUID:6bbbb416-edc3-405f-a86d-231d5800235e",
+                           "Urn:Uuid:6BBBB416-EDC3-405F-A86D-231D5800235E"}) {
+    std::optional<SimdUuid> uuid = SimdUuid::Parse(from);
+    ASSERT_TRUE(uuid.has_value()) << from;
+    EXPECT_EQ(std::string(*uuid), expected);
+  }
+}
+
+TEST(SimdUuid, ParseInvalid) {
+  for (std::string from : {"", "6BBBB416-EDC3-405F-A86D-231D5800235",
+                           "6BBBB416-EDC3-405F-A86D-231D5800235E0",
+                           "6BBBB416EDC3405FA86D231D5800235",
+                           "6BBBB416EDC3405FA86D231D5800235R",
+                           "6BBBB416-EDC3405FA86D231D5800235E",
+                           "(6BBBB416-EDC3-405F-A86D-231D5800235E)",
+                           "{6BBBB416-EDC3-405F-A86D-231D5800235E{",
+                           "}6BBBB416-EDC3-405F-A86D-231D5800235E}",
+                           "{6BBBB416EDC3405FA86D231D5800235E}",
+                           "{6BBBB416-EDC3-405F-A86D-231D5800235R}",
+                           "urn:uuid-6BBBB416-EDC3-405F-A86D-231D5800235E",
+                           "urn:uuid\x1A"
+                           "6BBBB416-EDC3-405F-A86D-231D5800235E",
+                           "urn\x1Auuid:6BBBB416-EDC3-405F-A86D-231D5800235E",
+                           "urm:uuid:6BBBB416-EDC3-405F-A86D-231D5800235E",
+                           "urn:uuid:6BBBB416EDC3405FA86D231D5800235E",
+                           "urn:uuid:6BBBB416-EDC3-405F-A86D_231D5800235E"}) {
+    EXPECT_FALSE(SimdUuid::Parse(from).has_value()) << from;
+  }
+}
+
+TEST(SimdUuid, FromStringBatch) {
+  std::string from = "6BBBB416-EDC3-405F-A86D-231D5800235E\n"
+                     "FEDCBA98-7654-3210-8899-AABBCCDDEEFF\n"
+                     "FEDCBA98-7654-3210-8899-AABBCCDDEEFR\n"
+                     "00000000-0000-0000-0000-000000000001\n";
+  std::vector<SimdUuid> result(4);
+  std::vector<std::uint64_t> valid(1);
+  EXPECT_EQ(SimdUuid::FromStringBatch(from, 37, result, valid), 3);
+  EXPECT_EQ(valid[0], 0b1011);
+  EXPECT_EQ(std::string(result[0]), "6BBBB416-EDC3-405F-A86D-231D5800235E");
+  EXPECT_EQ(std::string(result[1]), "FEDCBA98-7654-3210-8899-AABBCCDDEEFF");
+  EXPECT_EQ(result[2], SimdUuid());
+  EXPECT_EQ(std::string(result[3]), "00000000-0000-0000-0000-000000000001");
+}
+
+TEST(SimdUuid, FromStringBatchPacked) {
+  std::string from = "6BBBB416-EDC3-405F-A86D-231D5800235E"
+                     "FEDCBA98-7654-3210-8899-AABBCCDDEEFF";
+  std::vector<SimdUuid> result(2);
+  std::vector<std::uint64_t> valid(1);
+  EXPECT_EQ(SimdUuid::FromStringBatch(from, 36, result, valid), 2);
+  EXPECT_EQ(valid[0], 0b11);
+  EXPECT_EQ(std::string(result[0]), "6BBBB416-EDC3-405F-A86D-231D5800235E");
+  EXPECT_EQ(std::string(result[1]), "FEDCBA98-7654-3210-8899-AABBCCDDEEFF");
+}
+
+TEST(SimdUuid, FromStringBatchOutOfBounds) {
+  std::string from = "6BBBB416-EDC3-405F-A86D-231D5800235E\n"
+                     "FEDCBA98-7654-3210-8899-AABBCCDDEE";
+  std::vector<SimdUuid> result(3, SimdUuid(1, 1));
+  std::vector<std::uint64_t> valid(1);
+  EXPECT_EQ(SimdUuid::FromStringBatch(from, 37, result, valid), 1);
+  EXPECT_EQ(valid[0], 0b1);
+  EXPECT_EQ(result[1], SimdUuid());
+  EXPECT_EQ(result[2], SimdUuid());
+}
+
+TEST(SimdUuid, FromStringBatchStringView) {
+  std::vector<std::string_view> from = {
+      "6BBBB416-EDC3-405F-A86D-231D5800235E",
+      "6BBBB416-EDC3-405F-A86D-231D5800235",
+      "6BBBB416-EDC3-405F-A86D-231D5800235E0",
+      "6BBBB416-EDC3-405F-A86D231D5800235E0",
+      "FEDCBA98-7654-3210-8899-AABBCCDDEEFF",
+  };
+  std::vector<SimdUuid> result(from.size());
+  std::vector<std::uint64_t> valid(1);
+  EXPECT_EQ(SimdUuid::FromStringBatch(from, result, valid), 2);
+  EXPECT_EQ(valid[0], 0b10001);
+  EXPECT_EQ(std::string(result[0]), "6BBBB416-EDC3-405F-A86D-231D5800235E");
+  EXPECT_EQ(std::string(result[4]), "FEDCBA98-7654-3210-8899-AABBCCDDEEFF");
+}
+
+TEST(SimdUuid, FromStringBatchMatchesFromString) {
+  std::mt19937_64 rng(42);
+  std::vector<std::string> strings;
+  for (int i = 0; i < 150; ++i) {
+    std::string from = std::string(SimdUuid(rng(), rng()));
+    if (i % 7 == 0) {
+      from[rng() % 36] = 'G';
+    }
+    strings.push_back(from);
   }
+  std::vector<std::string_view> from(strings.begin(), strings.end());
+  std::vector<SimdUuid> result(from.size());
+  std::vector<std::uint64_t> valid(3);
+  size_t total = SimdUuid::FromStringBatch(from, result, valid);
+
+  size_t expected_total = 0;
+  for (size_t i = 0; i < from.size(); ++i) {
+    std::optional<SimdUuid> expected = SimdUuid::FromString(from[i]);
+    EXPECT_EQ(expected.has_value(), (valid[i / 64] >> (i % 64)) & 1);
+    EXPECT_EQ(expected.value_or(SimdUuid()), result[i]);
+    expected_total += expected.has_value();
+  }
+  EXPECT_EQ(total, expected_total);
+}
+
+TEST(SimdUuid, HighLow) {
+  SimdUuid uuid = SimdUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF);
+  EXPECT_EQ(uuid.high(), 0xFEDCBA9876543210);
+  EXPECT_EQ(uuid.low(), 0x8899AABBCCDDEEFF);
+
+  static_assert(SimdUuid(std::array<std::uint8_t, 16>{0x01, 0x02}).high() ==
+                0x0102000000000000);
+}
+
+TEST(SimdUuid, Version) {
+  EXPECT_EQ(SimdUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF).version(), 3);
+  EXPECT_EQ(SimdUuid(0x018BCFE568007ABC, 0x8DEF0123456789AB).version(), 7);
+  EXPECT_EQ(SimdUuid(0, 0).version(), 0);
+}
+
+TEST(SimdUuid, ToBase64Url) {
+  SimdUuid uuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E);
+  char result[kBase64UrlSize + 1];
+  uuid.ToBase64Url(result);
+  EXPECT_EQ(std::string(result), "a7u0Fu3DQF-obSMdWAAjXg");
+  SimdUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF).ToBase64Url(result);
+  EXPECT_EQ(std::string(result), "_ty6mHZUMhCImaq7zN3u_w");
+}
+
+TEST(SimdUuid, ToBase32) {
+  SimdUuid uuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E);
+  char result[kBase32Size + 1];
+  uuid.ToBase32(result);
+  EXPECT_EQ(std::string(result), "3BQET1DVE381FTGV933NC008TY");
+  SimdUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF).ToBase32(result);
+  EXPECT_EQ(std::string(result), "7YVJX9GXJM6888H6DAQF6DVVQZ");
+}
+
+TEST(SimdUuid, FromBase64Url) {
+  EXPECT_EQ(SimdUuid::FromBase64Url("a7u0Fu3DQF-obSMdWAAjXg"),
+            SimdUuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E));
+  EXPECT_EQ(SimdUuid::FromBase64Url("_ty6mHZUMhCImaq7zN3u_w"),
+            SimdUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF));
+}
+
+TEST(SimdUuid, FromBase64UrlInvalid) {
+  // Standard base64 characters.
+  EXPECT_EQ(SimdUuid::FromBase64Url("a7u0Fu3DQF+obSMdWAAjXg"), std::nullopt);
+  EXPECT_EQ(SimdUuid::FromBase64Url("a7u0Fu3DQF-obSMdWAAj/g"), std::nullopt);
+  // The last 4 bits are not zeros.
+  EXPECT_EQ(SimdUuid::FromBase64Url("a7u0Fu3DQF-obSMdWAAjXh"), std::nullopt);
+  // Padding, and wrong lengths.
+  EXPECT_EQ(SimdUuid::FromBase64Url("a7u0Fu3DQF-obSMdWAAjXg=="), std::nullopt);
+  EXPECT_EQ(SimdUuid::FromBase64Url("a7u0Fu3DQF-obSMdWAAjX"), std::nullopt);
+  EXPECT_EQ(SimdUuid::FromBase64Url(""), std::nullopt);
+}
+
+TEST(SimdUuid, FromBase32) {
+  EXPECT_EQ(SimdUuid::FromBase32("3BQET1DVE381FTGV933NC008TY"),
+            SimdUuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E));
+  EXPECT_EQ(SimdUuid::FromBase32("7YVJX9GXJM6888H6DAQF6DVVQZ"),
+            SimdUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF));
+  // Lowercase, and the aliases of '1' and '0'.
+  EXPECT_EQ(SimdUuid::FromBase32("3bqetidve381ftgv933nc0o8ty"),
+            SimdUuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E));
+  EXPECT_EQ(SimdUuid::FromBase32("3BQETLDVE381FTGV933NCO08TY"),
+            SimdUuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E));
+}
+
+TEST(SimdUuid, FromBase32Invalid) {
+  // 'U' is not part of Crockford's base32.
+  EXPECT_EQ(SimdUuid::FromBase32("3BQET1DVE381FTGV933NC008TU"), std::nullopt);
+  EXPECT_EQ(SimdUuid::FromBase32("3BQET1DVE381FTGV933NC008T-"), std::nullopt);
+  // More than 128 bits.
+  EXPECT_EQ(SimdUuid::FromBase32("8BQET1DVE381FTGV933NC008TY"), std::nullopt);
+  EXPECT_EQ(SimdUuid::FromBase32("ZBQET1DVE381FTGV933NC008TY"), std::nullopt);
+  // Wrong lengths.
+  EXPECT_EQ(SimdUuid::FromBase32("3BQET1DVE381FTGV933NC008T"), std::nullopt);
+  EXPECT_EQ(SimdUuid::FromBase32("3BQET1DVE381FTGV933NC008TY0"), std::nullopt);
+}
+
+TEST(SimdUuid, Base64UrlAndBase32Batch) {
+  std::vector<SimdUuid> uuids = {
+      SimdUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF),
+      SimdUuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E)};
+  std::string base64url(2 * 23, '*');
+  EXPECT_EQ(SimdUuid::ToBase64UrlBatch(uuids, base64url), 2 * 23);
+  EXPECT_EQ(base64url, "_ty6mHZUMhCImaq7zN3u_w\na7u0Fu3DQF-obSMdWAAjXg\n");
+  std::string base32(2 * 27 + 26, '*');
+  EXPECT_EQ(SimdUuid::ToBase32Batch(uuids, base32, ','), 2 * 27);
+  EXPECT_EQ(base32, "7YVJX9GXJM6888H6DAQF6DVVQZ,3BQET1DVE381FTGV933NC008TY," +
+                        std::string(26, '*'));
+
+  // The last string of `base64url` has no separator.
+  base64url.pop_back();
+  std::vector<SimdUuid> result(3);
+  std::vector<uint64_t> valid(1);
+  EXPECT_EQ(SimdUuid::FromBase64UrlBatch(base64url, 23, result, valid), 2);
+  EXPECT_EQ(valid[0], 0b011u);
+  EXPECT_EQ(result[0], uuids[0]);
+  EXPECT_EQ(result[1], uuids[1]);
+  EXPECT_EQ(result[2], SimdUuid());
+
+  EXPECT_EQ(SimdUuid::FromBase32Batch(base32, 27, result, valid), 2);
+  EXPECT_EQ(valid[0], 0b011u);
+  EXPECT_EQ(result[0], uuids[0]);
+  EXPECT_EQ(result[1], uuids[1]);
+  EXPECT_EQ(result[2], SimdUuid());
+}
+
+TEST(SimdUuid, ParseConstant) {
+  constexpr SimdUuid uuid =
+      SimdUuid::ParseConstant("6BBBB416-EDC3-405F-A86D-231D5800235E");
+  static_assert(uuid == SimdUuid(std::array<std::uint8_t, 16>{
+                            0x6B, 0xBB, 0xB4, 0x16, 0xED, 0xC3, 0x40, 0x5F,
+                            0xA8, 0x6D, 0x23, 0x1D, 0x58, 0x00, 0x23, 0x5E}));
+  static_assert(uuid ==
+                SimdUuid::ParseConstant("6bbbb416edc3405fa86d231d5800235e"));
+  static_assert(uuid ==
+                SimdUuid::ParseConstant("{6bbbb416-EDC3-405f-a86d-231d5800235e}"));
+  static_assert(uuid == SimdUuid::ParseConstant(
+                            "URN:uuid:6bbbb416-edc3-405f-a86d-231d5800235e"));
+  EXPECT_EQ(uuid, SimdUuid(0x6BBBB416EDC3405F, 0xA86D231D5800235E));
+}
+
+TEST(SimdUuid, Literal) {
+  using namespace andyccs::literals;
+  constexpr SimdUuid uuid = "fedcba98-7654-3210-8899-aabbccddeeff"_uuid;
+  static_assert(uuid != SimdUuid());
+  EXPECT_EQ(uuid, SimdUuid(0xFEDCBA9876543210, 0x8899AABBCCDDEEFF));
+  EXPECT_EQ(SimdUuid::FromString("FEDCBA98-7654-3210-8899-AABBCCDDEEFF"), uuid);
+}
+
+// Malformed constants do not compile, as ParseUuidConstexpr does not parse
+// them.
+TEST(SimdUuid, ParseConstantMalformed) {
+  using internal::ParseUuidConstexpr;
+  static_assert(!ParseUuidConstexpr(""));
+  static_assert(!ParseUuidConstexpr("6BBBB416-EDC3-405F-A86D-231D5800235"));
+  static_assert(!ParseUuidConstexpr("6BBBB416-EDC3-405F-A86D-231D5800235G"));
+  static_assert(!ParseUuidConstexpr("6BBBB416-EDC3-405F-A86D_231D5800235E"));
+  static_assert(!ParseUuidConstexpr("6BBBB416EDC3-405F-A86D-231D5800235E0"));
+  static_assert(!ParseUuidConstexpr("[6BBBB416-EDC3-405F-A86D-231D5800235E]"));
+  static_assert(
+      !ParseUuidConstexpr("urn:uuid-6BBBB416-EDC3-405F-A86D-231D5800235E"));
+}
+
+TEST(SimdUuid, Order) {
+  // Orders as the strings, so bytes are compared from the first one.
+  const SimdUuid a(0x0000000000000001, 0xFFFFFFFFFFFFFFFF);
+  const SimdUuid b(0x0000000000000100, 0x0000000000000000);
+  const SimdUuid c(0x0000000000000100, 0x0100000000000000);
+  EXPECT_LT(a, b);
+  EXPECT_LT(b, c);
+  EXPECT_GT(c, a);
+  EXPECT_LE(b, b);
+  EXPECT_EQ(b <=> SimdUuid(0x0000000000000100, 0), std::strong_ordering::equal);
+  EXPECT_LT(std::string(a), std::string(b));
+  EXPECT_LT(std::string(b), std::string(c));
+  static_assert(SimdUuid() < SimdUuid(std::array<std::uint8_t, 16>{0x80}));
 }
 
 TEST(SimdUuid, HashNoCollision) {
@@ -145,4 +557,15 @@ TEST(SimdUuidGenerator, GenerateUUIDUsingMt199937_64) {
   EXPECT_NE(uuid, SimdUuid());
 }
 
+TEST(SimdUuidGenerator, GenerateUuids) {
+  SimdUuidGenerator<std::mt19937_64> generator;
+  for (std::size_t count : {0, 1, 63, 64, 1000}) {
+    std::vector<SimdUuid> uuids(count);
+    generator.GenerateUuids(uuids);
+    std::unordered_set<SimdUuid> unique(uuids.begin(), uuids.end());
+    EXPECT_EQ(unique.size(), count);
+    EXPECT_FALSE(unique.contains(SimdUuid()));
+  }
+}
+
 } // namespace andyccs
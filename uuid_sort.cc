@@ -0,0 +1,173 @@
+#include "uuid_sort.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <thread>
+
+namespace andyccs {
+namespace {
+
+// Buckets of at most this many UUIDs are sorted with std::sort.
+constexpr std::size_t kSmallBucket = 64;
+
+// Below this many UUIDs, threads cost more than they save.
+constexpr std::size_t kMinParallelSize = 1 << 16;
+
+using Counts = std::array<std::size_t, 256>;
+
+// Uninitialized room for `size` UUIDs.
+class Scratch {
+public:
+  explicit Scratch(std::size_t size)
+      : data_(std::allocator<SimdUuid>().allocate(size)), size_(size) {}
+  ~Scratch() { std::allocator<SimdUuid>().deallocate(data_, size_); }
+
+  SimdUuid *get() const { return data_; }
+
+private:
+  SimdUuid *data_;
+  std::size_t size_;
+};
+
+// Returns byte `index` of the UUID, as in its string.
+inline unsigned Digit(const SimdUuid &uuid, int index) {
+  return index < 8 ? (uuid.high() >> (56 - 8 * index)) & 0xFF
+                   : (uuid.low() >> (120 - 8 * index)) & 0xFF;
+}
+
+// Counts the UUIDs of [begin, end) by byte `index`.
+Counts CountDigits(const SimdUuid *begin, const SimdUuid *end, int index) {
+  Counts counts = {};
+  for (const SimdUuid *uuid = begin; uuid != end; ++uuid) {
+    ++counts[Digit(*uuid, index)];
+  }
+  return counts;
+}
+
+// Moves the UUIDs of [begin, end) to `out`, where bucket d starts at
+// `offsets[d]`. Advances the offsets past the moved UUIDs.
+void Scatter(const SimdUuid *begin, const SimdUuid *end, int index,
+             Counts &offsets, SimdUuid *out) {
+  for (const SimdUuid *uuid = begin; uuid != end; ++uuid) {
+    out[offsets[Digit(*uuid, index)]++] = *uuid;
+  }
+}
+
+// Sorts the `size` UUIDs at `data` by their bytes from `index` on, given that
+// the previous bytes are equal. `scratch` has room for `size` UUIDs. The result
+// is written to `scratch` if `to_scratch`, or stays in `data` otherwise.
+void MsdSort(SimdUuid *data, SimdUuid *scratch, std::size_t size, int index,
+             bool to_scratch) {
+  if (size <= kSmallBucket || index == 16) {
+    std::sort(data, data + size);
+    if (to_scratch) {
+      std::copy(data, data + size, scratch);
+    }
+    return;
+  }
+
+  const Counts counts = CountDigits(data, data + size, index);
+  // All the UUIDs have the same byte, e.g. the timestamp of UUIDv7: skip it.
+  if (std::ranges::find(counts, size) != counts.end()) {
+    MsdSort(data, scratch, size, index + 1, to_scratch);
+    return;
+  }
+  Counts offsets;
+  std::exclusive_scan(counts.begin(), counts.end(), offsets.begin(),
+                      std::size_t{0});
+  const Counts begins = offsets;
+  Scatter(data, data + size, index, offsets, scratch);
+  // The buckets are now in `scratch`, so `data` is the scratch space of the
+  // next byte.
+  for (std::size_t d = 0; d < 256; ++d) {
+    MsdSort(scratch + begins[d], data + begins[d], counts[d], index + 1,
+            !to_scratch);
+  }
+}
+
+// Runs `task(thread)` on `threads` threads and waits for them.
+template <class Task> void RunThreads(unsigned threads, const Task &task) {
+  std::vector<std::jthread> workers;
+  for (unsigned t = 1; t < threads; ++t) {
+    workers.emplace_back(task, t);
+  }
+  task(0);
+}
+
+void ParallelRadixSort(std::span<SimdUuid> uuids, unsigned threads) {
+  const std::size_t size = uuids.size();
+  Scratch scratch(size);
+
+  // Every thread counts and moves its own part of the UUIDs by the first
+  // byte, after the parts of the previous threads in each bucket.
+  std::vector<Counts> counts(threads);
+  auto part = [&](unsigned t) {
+    return uuids.subspan(size * t / threads,
+                         size * (t + 1) / threads - size * t / threads);
+  };
+  RunThreads(threads, [&](unsigned t) {
+    counts[t] = CountDigits(part(t).data(), part(t).data() + part(t).size(), 0);
+  });
+  std::vector<Counts> offsets(threads);
+  Counts begins;
+  std::size_t offset = 0;
+  for (std::size_t d = 0; d < 256; ++d) {
+    begins[d] = offset;
+    for (unsigned t = 0; t < threads; ++t) {
+      offsets[t][d] = offset;
+      offset += counts[t][d];
+    }
+  }
+  RunThreads(threads, [&](unsigned t) {
+    Scatter(part(t).data(), part(t).data() + part(t).size(), 0, offsets[t],
+            scratch.get());
+  });
+
+  // Then the threads sort one bucket at a time, largest first, back into
+  // `uuids`.
+  std::array<std::size_t, 256> order;
+  std::iota(order.begin(), order.end(), 0);
+  auto bucket_size = [&](std::size_t d) {
+    return (d == 255 ? size : begins[d + 1]) - begins[d];
+  };
+  std::ranges::sort(order, std::greater<>(), bucket_size);
+  std::atomic<std::size_t> next = 0;
+  RunThreads(threads, [&](unsigned) {
+    for (std::size_t i = next++; i < 256; i = next++) {
+      const std::size_t d = order[i];
+      MsdSort(scratch.get() + begins[d], uuids.data() + begins[d],
+              bucket_size(d), 1, true);
+    }
+  });
+}
+
+} // namespace
+
+void RadixSortUuids(std::span<SimdUuid> uuids, unsigned threads) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  if (uuids.size() <= kSmallBucket) {
+    std::sort(uuids.begin(), uuids.end());
+    return;
+  }
+  if (threads == 1 || uuids.size() < kMinParallelSize) {
+    Scratch scratch(uuids.size());
+    MsdSort(uuids.data(), scratch.get(), uuids.size(), 0, false);
+    return;
+  }
+  ParallelRadixSort(uuids, threads);
+}
+
+std::size_t SortUniqueUuids(std::vector<SimdUuid> &uuids, unsigned threads) {
+  RadixSortUuids(uuids, threads);
+  const std::size_t size = uuids.size();
+  uuids.erase(std::unique(uuids.begin(), uuids.end()), uuids.end());
+  return size - uuids.size();
+}
+
+} // namespace andyccs
@@ -0,0 +1,32 @@
+#ifndef ANDYCCS_UUID_SORT_H
+#define ANDYCCS_UUID_SORT_H
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "uuid_simd.h"
+
+namespace andyccs {
+
+// Sorts `uuids` in increasing order, see SimdUuid::operator<=>, with a radix
+// sort on `threads` threads, or on every core if `threads` is 0.
+//
+// The first pass splits the UUIDs by their first byte, every thread counting
+// and then moving its own part of the array. The 256 buckets are then sorted
+// by the threads, largest first, one byte at a time until they are small
+// enough for std::sort. Random UUIDs take 3 passes over the data for a hundred
+// million keys, instead of the log2(n) passes of std::sort.
+//
+// Needs a temporary copy of `uuids`. Faster than std::sort from a few thousand
+// UUIDs on, and falls back to it below.
+void RadixSortUuids(std::span<SimdUuid> uuids, unsigned threads = 0);
+
+// Sorts `uuids` with RadixSortUuids and removes duplicates.
+//
+// Returns the number of duplicates removed.
+std::size_t SortUniqueUuids(std::vector<SimdUuid> &uuids, unsigned threads = 0);
+
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_SORT_H
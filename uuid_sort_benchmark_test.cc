@@ -0,0 +1,85 @@
+#include "uuid_sort.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "uuid_benchmark_utils.h"
+
+namespace andyccs {
+
+// Sizes from 1M to 500M UUIDs, i.e. 16 MB to 8 GB, and thread counts from 1
+// to the number of cores. The largest sizes need 3 times as much memory.
+static void SortArguments(benchmark::internal::Benchmark *benchmark,
+                          bool threads) {
+  const int cores = std::max(1u, std::thread::hardware_concurrency());
+  for (int size : {1'000'000, 10'000'000, 100'000'000, 500'000'000}) {
+    if (!threads) {
+      benchmark->Args({size, 1});
+      continue;
+    }
+    for (int t = 1; t < cores; t *= 2) {
+      benchmark->Args({size, t});
+    }
+    benchmark->Args({size, cores});
+  }
+}
+
+static void BM_StdSortUuids(benchmark::State &state) {
+  const std::vector<SimdUuid> input = RandomUuids(state.range(0));
+  std::vector<SimdUuid> uuids;
+  for (auto _ : state) {
+    state.PauseTiming();
+    uuids = input;
+    state.ResumeTiming();
+    std::sort(uuids.begin(), uuids.end());
+    benchmark::DoNotOptimize(uuids.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_StdSortUuids)
+    ->Apply([](auto *b) { SortArguments(b, false); })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void BM_RadixSortUuids(benchmark::State &state) {
+  const std::vector<SimdUuid> input = RandomUuids(state.range(0));
+  std::vector<SimdUuid> uuids;
+  for (auto _ : state) {
+    state.PauseTiming();
+    uuids = input;
+    state.ResumeTiming();
+    RadixSortUuids(uuids, state.range(1));
+    benchmark::DoNotOptimize(uuids.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_RadixSortUuids)
+    ->Apply([](auto *b) { SortArguments(b, true); })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// With 1 duplicate out of 10 UUIDs.
+static void BM_SortUniqueUuids(benchmark::State &state) {
+  std::vector<SimdUuid> input = RandomUuids(state.range(0));
+  std::copy(input.begin(), input.begin() + input.size() / 10,
+            input.end() - input.size() / 10);
+  std::vector<SimdUuid> uuids;
+  for (auto _ : state) {
+    state.PauseTiming();
+    uuids = input;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(SortUniqueUuids(uuids, state.range(1)));
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_SortUniqueUuids)
+    ->Apply([](auto *b) { SortArguments(b, true); })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace andyccs
+
+BENCHMARK_MAIN();
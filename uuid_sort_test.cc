@@ -0,0 +1,71 @@
+#include "uuid_sort.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "uuid_benchmark_utils.h"
+
+namespace andyccs {
+namespace {
+
+void ExpectSortsLikeStdSort(std::vector<SimdUuid> uuids, unsigned threads) {
+  std::vector<SimdUuid> expected = uuids;
+  std::sort(expected.begin(), expected.end());
+  RadixSortUuids(uuids, threads);
+  EXPECT_TRUE(uuids == expected)
+      << uuids.size() << " UUIDs on " << threads << " threads";
+}
+
+TEST(RadixSortUuids, Random) {
+  for (std::size_t size : {0, 1, 2, 255, 256, 257, 1000, 100000}) {
+    for (unsigned threads : {0, 1, 3, 8}) {
+      ExpectSortsLikeStdSort(RandomUuids(size), threads);
+    }
+  }
+}
+
+// Every byte but one is the same, so every byte position is sorted by its own
+// pass.
+TEST(RadixSortUuids, SharedPrefixes) {
+  std::mt19937_64 rng(42);
+  for (int byte = 0; byte < 16; ++byte) {
+    std::vector<SimdUuid> uuids;
+    for (int i = 0; i < 10000; ++i) {
+      std::array<std::uint8_t, 16> data;
+      data.fill(0x5A);
+      data[byte] = rng();
+      uuids.emplace_back(data);
+    }
+    ExpectSortsLikeStdSort(uuids, 1);
+  }
+}
+
+// UUIDv7: the first 6 bytes are a timestamp shared by many UUIDs.
+TEST(RadixSortUuids, Timestamps) {
+  std::mt19937_64 rng(42);
+  std::vector<SimdUuid> uuids;
+  for (int i = 0; i < 100000; ++i) {
+    uuids.emplace_back(
+        (0x0193F3A2B1C0ULL + i / 1000) << 16 | 0x7000 | rng() % 0x1000, rng());
+  }
+  ExpectSortsLikeStdSort(uuids, 1);
+  ExpectSortsLikeStdSort(uuids, 4);
+}
+
+TEST(SortUniqueUuids, Duplicates) {
+  std::vector<SimdUuid> unique = RandomUuids(100000);
+  std::vector<SimdUuid> uuids = unique;
+  uuids.insert(uuids.end(), unique.begin(), unique.begin() + 5000);
+  uuids.insert(uuids.end(), unique.begin(), unique.begin() + 10);
+  std::shuffle(uuids.begin(), uuids.end(), std::mt19937(42));
+
+  EXPECT_EQ(SortUniqueUuids(uuids, 4), 5010u);
+  std::sort(unique.begin(), unique.end());
+  EXPECT_TRUE(uuids == unique);
+  EXPECT_EQ(SortUniqueUuids(uuids), 0u);
+}
+
+} // namespace
+} // namespace andyccs
@@ -0,0 +1,199 @@
+#ifndef ANDYCCS_UUID_TIME_GENERATOR_H
+#define ANDYCCS_UUID_TIME_GENERATOR_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <span>
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+#include "uuid_generator.h"
+#include "uuid_random.h"
+#include "uuid_simd.h"
+
+namespace andyccs {
+
+// The system clock as last updated by the kernel timer interrupt, which is a
+// few times cheaper to read than std::chrono::system_clock, but only advances
+// every few milliseconds. Same as std::chrono::system_clock outside of Linux.
+struct CoarseSystemClock {
+  using duration = std::chrono::nanoseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<std::chrono::system_clock, duration>;
+  static constexpr bool is_steady = false;
+
+  static time_point now() noexcept {
+#if defined(__linux__) && defined(CLOCK_REALTIME_COARSE)
+    timespec now;
+    clock_gettime(CLOCK_REALTIME_COARSE, &now);
+    return time_point(std::chrono::seconds(now.tv_sec) +
+                      std::chrono::nanoseconds(now.tv_nsec));
+#else
+    return std::chrono::time_point_cast<duration>(
+        std::chrono::system_clock::now());
+#endif
+  }
+};
+
+// 100-nanosecond intervals, the unit of UUIDv1 and UUIDv6 timestamps.
+using GregorianTicks = std::chrono::duration<std::int64_t, std::ratio<1, 10000000>>;
+
+// Generates UUIDv1 or UUIDv6 as specified by RFC 9562: a 60-bit timestamp,
+// counting 100-nanosecond intervals since 15 October 1582, a 14-bit clock
+// sequence and a 48-bit node id. UUIDv6 has the same fields as UUIDv1, but with
+// the timestamp bytes in order, so that UUIDv6 sort by time.
+//
+// GenerateUuid reads Clock for every UUID, and reading the clock costs more
+// than building a UUID, which is why the default clock is CoarseSystemClock.
+// GenerateUuids reads it once for the whole batch. The timestamp only follows
+// the clock when it has moved since the last UUID. Until then, every UUID gets
+// the previous timestamp plus one. With CoarseSystemClock, the clock moves
+// every few milliseconds, and the timestamps in between are handed out in
+// order. When UUIDs are generated faster than one per 100 nanoseconds, the
+// timestamps move ahead of the clock, and wait for it to catch up.
+//
+// When the clock goes backwards, e.g. when it is adjusted, the clock sequence
+// goes up by one, so the UUIDs stay unique.
+//
+// The node id defaults to random bytes with the multicast bit set, as RFC 9562
+// requires for node ids that are not MAC addresses. The clock sequence starts
+// at a random value.
+//
+// Not thread-safe. Generators running at the same time, e.g. one per thread,
+// must have different node ids.
+template <int Version, class UuidT = Uuid, class Clock = CoarseSystemClock>
+class TimeUuidGenerator {
+  static_assert(Version == 1 || Version == 6, "Version must be 1 or 6");
+
+public:
+  using Node = std::array<std::uint8_t, 6>;
+
+  TimeUuidGenerator() : TimeUuidGenerator(RandomNode()) {}
+
+  explicit TimeUuidGenerator(const Node &node)
+      : TimeUuidGenerator(node, RandomClockSequence()) {}
+
+  TimeUuidGenerator(const Node &node, std::uint16_t clock_sequence)
+      : clock_sequence_(clock_sequence & 0x3FFF) {
+    for (std::uint8_t byte : node) {
+      node_ = (node_ << 8) | byte;
+    }
+  }
+
+  UuidT GenerateUuid() {
+    const std::uint64_t now = NowTicks();
+    if (now != last_clock_) [[unlikely]] {
+      Advance(now);
+    }
+    return MakeUuid(next_timestamp_++);
+  }
+
+  // Same as calling GenerateUuid for each of `uuids`, but reads the clock only
+  // once.
+  void GenerateUuids(std::span<UuidT> uuids) {
+    const std::uint64_t now = NowTicks();
+    if (now != last_clock_) {
+      Advance(now);
+    }
+    for (UuidT &uuid : uuids) {
+      uuid = MakeUuid(next_timestamp_++);
+    }
+  }
+
+  Node node() const {
+    Node node;
+    for (int i = 0; i < 6; ++i) {
+      node[i] = node_ >> (8 * (5 - i));
+    }
+    return node;
+  }
+
+  std::uint16_t clock_sequence() const { return clock_sequence_; }
+
+private:
+  // 100-nanosecond intervals between 15 October 1582 and 1 January 1970.
+  static constexpr std::uint64_t kGregorianOffset = 0x01B21DD213814000;
+
+  static std::uint64_t NowTicks() {
+    return std::chrono::duration_cast<GregorianTicks>(
+               Clock::now().time_since_epoch())
+               .count() +
+           kGregorianOffset;
+  }
+
+  static Node RandomNode() {
+    Node node;
+    SecureRandom::Fill(node);
+    node[0] |= 0x01;
+    return node;
+  }
+
+  static std::uint16_t RandomClockSequence() {
+    std::array<std::uint8_t, 2> bytes;
+    SecureRandom::Fill(bytes);
+    return (bytes[0] << 8) | bytes[1];
+  }
+
+  void Advance(std::uint64_t now) {
+    if (now < last_clock_) {
+      clock_sequence_ = (clock_sequence_ + 1) & 0x3FFF;
+      next_timestamp_ = now;
+    } else {
+      next_timestamp_ = std::max(next_timestamp_, now);
+    }
+    last_clock_ = now;
+  }
+
+  UuidT MakeUuid(std::uint64_t timestamp) const {
+    timestamp &= (std::uint64_t{1} << 60) - 1;
+    std::uint64_t high;
+    if constexpr (Version == 1) {
+      // time_low:32 | time_mid:16 | ver:4 | time_high:12
+      high = (timestamp << 32) | ((timestamp >> 16) & 0xFFFF0000) | 0x1000 |
+             (timestamp >> 48);
+    } else {
+      // time_high:32 | time_mid:16 | ver:4 | time_low:12
+      high = ((timestamp >> 12) << 16) | 0x6000 | (timestamp & 0x0FFF);
+    }
+    const std::uint64_t low = (std::uint64_t{0b10} << 62) |
+                              (std::uint64_t{clock_sequence_} << 48) | node_;
+    return UuidT(high, low);
+  }
+
+  std::uint64_t node_ = 0;
+  std::uint16_t clock_sequence_;
+  // The clock reading of the last UUID, and the timestamp of the next UUID.
+  std::uint64_t last_clock_ = 0;
+  std::uint64_t next_timestamp_ = 0;
+};
+
+template <class UuidT = Uuid, class Clock = CoarseSystemClock>
+using UuidV1Generator = TimeUuidGenerator<1, UuidT, Clock>;
+
+template <class UuidT = Uuid, class Clock = CoarseSystemClock>
+using UuidV6Generator = TimeUuidGenerator<6, UuidT, Clock>;
+
+// Returns the timestamp of a UUIDv1 or UUIDv6. The result is meaningless for
+// other versions, see SimdUuid::version.
+inline std::chrono::sys_time<GregorianTicks>
+UuidGregorianTime(const SimdUuid &uuid) {
+  const std::uint64_t high = uuid.high();
+  std::uint64_t timestamp;
+  if (uuid.version() == 6) {
+    timestamp = ((high >> 16) << 12) | (high & 0x0FFF);
+  } else {
+    timestamp = ((high & 0x0FFF) << 48) | ((high & 0xFFFF0000) << 16) |
+                (high >> 32);
+  }
+  return std::chrono::sys_time<GregorianTicks>(
+      GregorianTicks(static_cast<std::int64_t>(timestamp - 0x01B21DD213814000)));
+}
+
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_TIME_GENERATOR_H
@@ -0,0 +1,56 @@
+#include "uuid_time_generator.h"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+namespace andyccs {
+
+// Reads the precise clock for every UUID.
+static void BM_GenerateUuidSystemClock(benchmark::State &state) {
+  UuidV1Generator<Uuid, std::chrono::system_clock> generator;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(generator.GenerateUuid());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GenerateUuidSystemClock)->Range(1 << 8, 1 << 8);
+
+static void BM_GenerateUuidCoarseClock(benchmark::State &state) {
+  UuidV1Generator generator;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(generator.GenerateUuid());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GenerateUuidCoarseClock)->Range(1 << 8, 1 << 8);
+
+static void BM_GenerateUuidV6CoarseClock(benchmark::State &state) {
+  UuidV6Generator generator;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(generator.GenerateUuid());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GenerateUuidV6CoarseClock)->Range(1 << 8, 1 << 8);
+
+static void BM_GenerateUuids(benchmark::State &state) {
+  UuidV1Generator generator;
+  std::vector<Uuid> uuids(state.range(0));
+  for (auto _ : state) {
+    generator.GenerateUuids(uuids);
+    benchmark::DoNotOptimize(uuids.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GenerateUuids)->Range(1 << 8, 1 << 8);
+
+} // namespace andyccs
+
+BENCHMARK_MAIN();
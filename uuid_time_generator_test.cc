@@ -0,0 +1,149 @@
+#include "uuid_time_generator.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <unordered_set>
+#include <vector>
+
+namespace andyccs {
+
+// Clock that only moves when told to. Starts at the time of the examples in
+// RFC 9562, Appendix A.
+struct FakeClock {
+  using duration = GregorianTicks;
+  using time_point = std::chrono::time_point<std::chrono::system_clock, duration>;
+
+  static time_point now() { return time_point(duration(now_ticks)); }
+
+  static constexpr std::int64_t kRfcExample =
+      0x1EC9414C232AB00 - 0x01B21DD213814000;
+  static inline std::int64_t now_ticks = kRfcExample;
+};
+
+constexpr std::array<std::uint8_t, 6> kRfcNode = {0x9F, 0x6B, 0xDE,
+                                                  0xCE, 0xD8, 0x46};
+
+TEST(TimeUuidGenerator, RfcExampleV1) {
+  FakeClock::now_ticks = FakeClock::kRfcExample;
+  UuidV1Generator<SimdUuid, FakeClock> generator(kRfcNode, 0x33C8);
+  EXPECT_EQ(std::string(generator.GenerateUuid()),
+            "C232AB00-9414-11EC-B3C8-9F6BDECED846");
+}
+
+TEST(TimeUuidGenerator, RfcExampleV6) {
+  FakeClock::now_ticks = FakeClock::kRfcExample;
+  UuidV6Generator<SimdUuid, FakeClock> generator(kRfcNode, 0x33C8);
+  EXPECT_EQ(std::string(generator.GenerateUuid()),
+            "1EC9414C-232A-6B00-B3C8-9F6BDECED846");
+}
+
+TEST(TimeUuidGenerator, GregorianTime) {
+  FakeClock::now_ticks = FakeClock::kRfcExample;
+  UuidV1Generator<SimdUuid, FakeClock> v1_generator;
+  UuidV6Generator<SimdUuid, FakeClock> v6_generator;
+  EXPECT_EQ(UuidGregorianTime(v1_generator.GenerateUuid()).time_since_epoch(),
+            GregorianTicks(FakeClock::kRfcExample));
+  EXPECT_EQ(UuidGregorianTime(v6_generator.GenerateUuid()).time_since_epoch(),
+            GregorianTicks(FakeClock::kRfcExample));
+}
+
+TEST(TimeUuidGenerator, Timestamp) {
+  auto before = std::chrono::system_clock::now();
+  UuidV1Generator<SimdUuid, std::chrono::system_clock> generator;
+  SimdUuid uuid = generator.GenerateUuid();
+  auto after = std::chrono::system_clock::now();
+  EXPECT_EQ(uuid.version(), 1);
+  EXPECT_LE(std::chrono::floor<GregorianTicks>(before), UuidGregorianTime(uuid));
+  EXPECT_LE(UuidGregorianTime(uuid), after);
+}
+
+TEST(TimeUuidGenerator, CoarseTimestamp) {
+  UuidV6Generator generator;
+  SimdUuid uuid = generator.GenerateUuid();
+  EXPECT_EQ(uuid.version(), 6);
+  EXPECT_EQ(uuid.low() >> 62, 0b10u);
+  EXPECT_LT(std::chrono::abs(UuidGregorianTime(uuid) -
+                             std::chrono::system_clock::now()),
+            std::chrono::seconds(1));
+}
+
+TEST(TimeUuidGenerator, RandomNode) {
+  UuidV1Generator generator;
+  // Multicast bit.
+  EXPECT_EQ(generator.node()[0] & 0x01, 0x01);
+  EXPECT_EQ(generator.GenerateUuid().low() & 0xFFFFFFFFFFFF,
+            (std::uint64_t{generator.node()[0]} << 40) |
+                (std::uint64_t{generator.node()[1]} << 32) |
+                (std::uint64_t{generator.node()[2]} << 24) |
+                (std::uint64_t{generator.node()[3]} << 16) |
+                (std::uint64_t{generator.node()[4]} << 8) |
+                generator.node()[5]);
+}
+
+TEST(TimeUuidGenerator, SameTick) {
+  // The timestamp moves ahead of a clock that does not move.
+  FakeClock::now_ticks = FakeClock::kRfcExample;
+  UuidV6Generator<SimdUuid, FakeClock> generator(kRfcNode, 0);
+  SimdUuid last = generator.GenerateUuid();
+  for (int i = 1; i < 1000; ++i) {
+    SimdUuid uuid = generator.GenerateUuid();
+    ASSERT_LT(last.high(), uuid.high());
+    last = uuid;
+  }
+  EXPECT_EQ(UuidGregorianTime(last).time_since_epoch(),
+            GregorianTicks(FakeClock::kRfcExample + 999));
+
+  // And waits for the clock to catch up.
+  FakeClock::now_ticks += 500;
+  EXPECT_EQ(UuidGregorianTime(generator.GenerateUuid()).time_since_epoch(),
+            GregorianTicks(FakeClock::kRfcExample + 1000));
+  FakeClock::now_ticks += 1000;
+  EXPECT_EQ(UuidGregorianTime(generator.GenerateUuid()).time_since_epoch(),
+            GregorianTicks(FakeClock::now_ticks));
+  EXPECT_EQ(generator.clock_sequence(), 0);
+}
+
+TEST(TimeUuidGenerator, ClockGoesBackwards) {
+  FakeClock::now_ticks = FakeClock::kRfcExample;
+  UuidV1Generator<SimdUuid, FakeClock> generator(kRfcNode, 0x3FFF);
+  SimdUuid first = generator.GenerateUuid();
+  FakeClock::now_ticks -= 1;
+  SimdUuid second = generator.GenerateUuid();
+  EXPECT_EQ(generator.clock_sequence(), 0);
+  EXPECT_EQ(UuidGregorianTime(second).time_since_epoch(),
+            GregorianTicks(FakeClock::now_ticks));
+  EXPECT_NE(first, second);
+  EXPECT_EQ((second.low() >> 48) & 0x3FFF, 0u);
+}
+
+TEST(TimeUuidGenerator, Unique) {
+  UuidV1Generator generator;
+  std::unordered_set<SimdUuid> uuids;
+  for (int i = 0; i < 100000; ++i) {
+    uuids.insert(generator.GenerateUuid());
+  }
+  EXPECT_EQ(uuids.size(), 100000);
+}
+
+TEST(TimeUuidGenerator, GenerateUuids) {
+  FakeClock::now_ticks = FakeClock::kRfcExample;
+  UuidV6Generator<SimdUuid, FakeClock> generator(kRfcNode, 0x33C8);
+  std::vector<SimdUuid> uuids(100);
+  generator.GenerateUuids(uuids);
+  EXPECT_EQ(std::string(uuids[0]), "1EC9414C-232A-6B00-B3C8-9F6BDECED846");
+  EXPECT_TRUE(std::is_sorted(uuids.begin(), uuids.end(),
+                             [](const SimdUuid &a, const SimdUuid &b) {
+                               return a.high() < b.high();
+                             }));
+  EXPECT_EQ(std::string(generator.GenerateUuid()),
+            "1EC9414C-232A-6B64-B3C8-9F6BDECED846");
+}
+
+TEST(TimeUuidGenerator, BasicUuid) {
+  FakeClock::now_ticks = FakeClock::kRfcExample;
+  UuidV1Generator<BasicUuid, FakeClock> generator(kRfcNode, 0x33C8);
+  EXPECT_EQ(std::string(generator.GenerateUuid()),
+            "C232AB00-9414-11EC-B3C8-9F6BDECED846");
+}
+
+} // namespace andyccs
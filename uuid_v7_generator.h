@@ -0,0 +1,101 @@
+#ifndef ANDYCCS_UUID_V7_GENERATOR_H
+#define ANDYCCS_UUID_V7_GENERATOR_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "uuid_generator.h"
+#include "uuid_random.h"
+#include "uuid_simd.h"
+
+namespace andyccs {
+
+// Generates UUIDv7 as specified by RFC 9562: a 48-bit Unix timestamp in
+// milliseconds, followed by a counter and random bits. UUIDs from the same
+// generator are strictly increasing, even across threads, so inserting them
+// in a B-tree index always appends to its last page.
+//
+// The layout follows the fixed-length counter method of RFC 9562:
+//
+// unix_ts_ms:48 | ver:4 | counter:12 | var:2 | counter:4 | random:58
+//
+// The 16-bit counter starts at a random value below 2^15 every millisecond,
+// and goes up by one for every UUID, which leaves room for at least 32768
+// UUIDs per millisecond. When the counter overflows, the timestamp moves one
+// millisecond ahead of the clock, and catches up when the clock does.
+//
+// The last timestamp and counter are kept in one atomic, advanced with a
+// compare-and-swap, so GenerateUuid is thread-safe and lock-free. Random bits
+// come from a thread-local RNG, as in UuidGenerator.
+template <class RNG = DefaultRNG, class UuidT = Uuid,
+          class Clock = std::chrono::system_clock>
+class UuidV7Generator {
+public:
+  UuidV7Generator() = default;
+
+  // Not copyable or moveable, like the thread-safe UuidGenerator.
+  UuidV7Generator(const UuidV7Generator &other) = delete;
+  UuidV7Generator &operator=(const UuidV7Generator &other) = delete;
+
+  UuidT GenerateUuid() {
+    RandomState &random = ThreadLocalRandom();
+    const std::uint64_t random_bits = random.distribution(random.generator);
+
+    const std::uint64_t now = NowMs() << 16;
+    std::uint64_t last = last_.load(std::memory_order_relaxed);
+    std::uint64_t next;
+    do {
+      // A new millisecond starts from a random counter with its top bit clear.
+      next = now > last
+                 ? now | (random.distribution(random.generator) >> 49)
+                 : last + 1;
+    } while (!last_.compare_exchange_weak(last, next,
+                                          std::memory_order_relaxed));
+
+    // `next` is the timestamp and the 16-bit counter, split around the
+    // version and variant.
+    const std::uint64_t high =
+        (next & ~std::uint64_t{0xFFFF}) | 0x7000 | ((next >> 4) & 0x0FFF);
+    const std::uint64_t low = (std::uint64_t{0b10} << 62) |
+                              ((next & 0xF) << 58) |
+                              (random_bits & ((std::uint64_t{1} << 58) - 1));
+    return UuidT(high, low);
+  }
+
+private:
+  struct RandomState {
+    RandomState() : generator(internal::SeedRandomEngine<RNG>()) {}
+
+    RNG generator;
+    [[no_unique_address]] internal::Uniform64<RNG> distribution;
+  };
+
+  static RandomState &ThreadLocalRandom() {
+    thread_local RandomState state;
+    return state;
+  }
+
+  static std::uint64_t NowMs() {
+    const auto since_epoch = Clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(since_epoch)
+               .count() &
+           ((std::uint64_t{1} << 48) - 1);
+  }
+
+  // Timestamp of the last UUID in the top 48 bits, and its counter in the
+  // lowest 16 bits. On its own cache line, as every thread writes to it.
+  alignas(64) std::atomic<std::uint64_t> last_{0};
+};
+
+// Returns the timestamp of a UUIDv7, i.e. its top 48 bits. The result is
+// meaningless for other versions, see SimdUuid::version.
+inline std::chrono::sys_time<std::chrono::milliseconds>
+UuidV7Time(const SimdUuid &uuid) {
+  return std::chrono::sys_time<std::chrono::milliseconds>(
+      std::chrono::milliseconds(uuid.high() >> 16));
+}
+
+} // namespace andyccs
+
+#endif // ANDYCCS_UUID_V7_GENERATOR_H
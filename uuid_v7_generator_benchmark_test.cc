@@ -0,0 +1,53 @@
+#include "uuid_v7_generator.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <thread>
+
+namespace andyccs {
+
+// Shared by all the benchmark threads.
+template <typename Generator> Generator &SharedGenerator() {
+  static Generator generator;
+  return generator;
+}
+
+template <typename Generator>
+static void BM_GenerateUuid(benchmark::State &state) {
+  Generator &generator = SharedGenerator<Generator>();
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(generator.GenerateUuid());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Random UUIDs, for comparison.
+BENCHMARK(BM_GenerateUuid<UuidGenerator<>>)
+    ->Range(1 << 8, 1 << 8)
+    ->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->UseRealTime();
+BENCHMARK(BM_GenerateUuid<UuidV7Generator<>>)
+    ->Range(1 << 8, 1 << 8)
+    ->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->UseRealTime();
+BENCHMARK(BM_GenerateUuid<UuidV7Generator<WyRand>>)
+    ->Range(1 << 8, 1 << 8)
+    ->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->UseRealTime();
+
+static void BM_UuidV7Time(benchmark::State &state) {
+  UuidV7Generator generator;
+  SimdUuid uuid = generator.GenerateUuid();
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(UuidV7Time(uuid));
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK(BM_UuidV7Time)->Range(1 << 8, 1 << 8);
+
+} // namespace andyccs
+
+BENCHMARK_MAIN();
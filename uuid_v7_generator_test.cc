@@ -0,0 +1,126 @@
+#include "uuid_v7_generator.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace andyccs {
+
+// Clock that only moves when told to.
+struct FakeClock {
+  using duration = std::chrono::milliseconds;
+  using time_point = std::chrono::time_point<FakeClock, duration>;
+
+  static time_point now() { return time_point(duration(now_ms)); }
+
+  static inline std::int64_t now_ms = 1700000000000;
+};
+
+bool Less(const SimdUuid &a, const SimdUuid &b) {
+  return a.high() < b.high() || (a.high() == b.high() && a.low() < b.low());
+}
+
+TEST(UuidV7Generator, VersionAndVariant) {
+  UuidV7Generator generator;
+  SimdUuid uuid = generator.GenerateUuid();
+  EXPECT_EQ(uuid.version(), 7);
+  EXPECT_EQ(uuid.low() >> 62, 0b10u);
+  // e.g. "018BCFE5-6800-7ABC-8DEF-0123456789AB"
+  EXPECT_EQ(std::string(uuid)[14], '7');
+}
+
+TEST(UuidV7Generator, Timestamp) {
+  auto before = std::chrono::time_point_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now());
+  UuidV7Generator generator;
+  SimdUuid uuid = generator.GenerateUuid();
+  auto after = std::chrono::time_point_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now());
+  EXPECT_LE(before, UuidV7Time(uuid));
+  EXPECT_LE(UuidV7Time(uuid), after);
+}
+
+TEST(UuidV7Generator, Monotonic) {
+  UuidV7Generator generator;
+  SimdUuid last = generator.GenerateUuid();
+  for (int i = 0; i < 100000; ++i) {
+    SimdUuid uuid = generator.GenerateUuid();
+    ASSERT_TRUE(Less(last, uuid)) << std::string(last) << " " << std::string(uuid);
+    last = uuid;
+  }
+}
+
+TEST(UuidV7Generator, SameMillisecond) {
+  FakeClock::now_ms = 1700000000000;
+  UuidV7Generator<DefaultRNG, SimdUuid, FakeClock> generator;
+  SimdUuid first = generator.GenerateUuid();
+  SimdUuid second = generator.GenerateUuid();
+  EXPECT_EQ(UuidV7Time(first).time_since_epoch().count(), 1700000000000);
+  EXPECT_EQ(UuidV7Time(second), UuidV7Time(first));
+  EXPECT_TRUE(Less(first, second));
+  // The counter starts below 2^15.
+  EXPECT_LT(first.high() & 0x0FFF, 0x0800u);
+}
+
+TEST(UuidV7Generator, CounterOverflow) {
+  // The timestamp moves ahead of the clock rather than going backwards.
+  FakeClock::now_ms = 1700000000000;
+  UuidV7Generator<DefaultRNG, SimdUuid, FakeClock> generator;
+  SimdUuid last = generator.GenerateUuid();
+  for (int i = 0; i < 100000; ++i) {
+    SimdUuid uuid = generator.GenerateUuid();
+    ASSERT_TRUE(Less(last, uuid));
+    last = uuid;
+  }
+  EXPECT_GT(UuidV7Time(last).time_since_epoch().count(), 1700000000000);
+}
+
+TEST(UuidV7Generator, ClockGoesBackwards) {
+  FakeClock::now_ms = 1700000000000;
+  UuidV7Generator<DefaultRNG, SimdUuid, FakeClock> generator;
+  SimdUuid first = generator.GenerateUuid();
+  FakeClock::now_ms -= 1000;
+  SimdUuid second = generator.GenerateUuid();
+  EXPECT_TRUE(Less(first, second));
+  EXPECT_EQ(UuidV7Time(second), UuidV7Time(first));
+}
+
+TEST(UuidV7Generator, MonotonicUnderContention) {
+  constexpr int kThreads = 8;
+  constexpr int kUuidsPerThread = 20000;
+  UuidV7Generator generator;
+  std::vector<std::vector<SimdUuid>> uuids(kThreads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&generator, &uuids, i] {
+      uuids[i].reserve(kUuidsPerThread);
+      for (int j = 0; j < kUuidsPerThread; ++j) {
+        uuids[i].push_back(generator.GenerateUuid());
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  // Every thread sees strictly increasing UUIDs, and no UUID is handed out
+  // twice.
+  std::unordered_set<SimdUuid> unique;
+  for (const std::vector<SimdUuid> &thread_uuids : uuids) {
+    EXPECT_TRUE(std::is_sorted(thread_uuids.begin(), thread_uuids.end(), Less));
+    EXPECT_EQ(std::adjacent_find(thread_uuids.begin(), thread_uuids.end()),
+              thread_uuids.end());
+    unique.insert(thread_uuids.begin(), thread_uuids.end());
+  }
+  EXPECT_EQ(unique.size(), kThreads * kUuidsPerThread);
+}
+
+TEST(UuidV7Generator, BasicUuid) {
+  UuidV7Generator<WyRand, BasicUuid> generator;
+  BasicUuid uuid = generator.GenerateUuid();
+  EXPECT_EQ(std::string(uuid)[14], '7');
+}
+
+} // namespace andyccs